@@ -0,0 +1,186 @@
+#include "core/CacheAnalitico.h"
+
+#include "utils/Agregacao.h"
+
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+void CacheAnalitico::limpar()
+{
+    m_dias.clear();
+    m_valores.clear();
+    m_tipos.clear();
+    m_categorias.clear();
+    m_ids.clear();
+    m_maiorCategoria = 0;
+    m_carregado      = false;
+    ++m_versao;
+}
+
+void CacheAnalitico::reservar(qsizetype n)
+{
+    m_dias.reserve(n);
+    m_valores.reserve(n);
+    m_tipos.reserve(n);
+    m_categorias.reserve(n);
+    m_ids.reserve(n);
+}
+
+void CacheAnalitico::anexar(TipoLancamento tipo, int id, qint64 valorCentavos,
+                            qint32 dia, int categoriaId)
+{
+    m_dias.append(dia);
+    m_valores.append(valorCentavos);
+    m_tipos.append(quint8(tipo));
+    m_categorias.append(categoriaId);
+    m_ids.append(id);
+    m_maiorCategoria = qMax(m_maiorCategoria, qint32(categoriaId));
+}
+
+void CacheAnalitico::concluirCarga()
+{
+    m_carregado = true;
+    ++m_versao;
+    if (std::is_sorted(m_dias.cbegin(), m_dias.cend())) return;
+
+    // Uma permutação estável por dia, aplicada a cada coluna
+    QList<qsizetype> ordem(m_dias.size());
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::stable_sort(ordem.begin(), ordem.end(),
+                     [this](qsizetype a, qsizetype b) { return m_dias[a] < m_dias[b]; });
+
+    auto permutar = [&ordem](auto &coluna) {
+        std::remove_reference_t<decltype(coluna)> nova;
+        nova.reserve(coluna.size());
+        for (const qsizetype i : std::as_const(ordem)) nova.append(coluna[i]);
+        coluna = std::move(nova);
+    };
+    permutar(m_dias);
+    permutar(m_valores);
+    permutar(m_tipos);
+    permutar(m_categorias);
+    permutar(m_ids);
+}
+
+qsizetype CacheAnalitico::primeiraDoDia(qint32 dia) const
+{
+    return std::lower_bound(m_dias.cbegin(), m_dias.cend(), dia) - m_dias.cbegin();
+}
+
+// ── Manutenção incremental ────────────────────────────────────────────────────
+
+void CacheAnalitico::adicionar(const Lancamento &l)
+{
+    if (!m_carregado) return;
+    const qint32 dia = qint32(l.data.toJulianDay());
+    // Depois das linhas do mesmo dia, como faria a carga estável
+    const qsizetype pos = primeiraDoDia(dia + 1);
+    m_dias.insert(pos, dia);
+    m_valores.insert(pos, l.valorCentavos);
+    m_tipos.insert(pos, quint8(l.tipo));
+    m_categorias.insert(pos, l.categoriaId);
+    m_ids.insert(pos, l.id);
+    m_maiorCategoria = qMax(m_maiorCategoria, qint32(l.categoriaId));
+    ++m_versao;
+}
+
+void CacheAnalitico::retirar(const Lancamento &l)
+{
+    if (!m_carregado) return;
+    const qint32  dia  = qint32(l.data.toJulianDay());
+    const quint8  tipo = quint8(l.tipo);
+    for (qsizetype i = primeiraDoDia(dia); i < m_dias.size() && m_dias[i] == dia; ++i) {
+        if (m_ids[i] != l.id || m_tipos[i] != tipo) continue;
+        m_dias.remove(i);
+        m_valores.remove(i);
+        m_tipos.remove(i);
+        m_categorias.remove(i);
+        m_ids.remove(i);
+        ++m_versao;
+        return;
+    }
+}
+
+// ── Agregações ────────────────────────────────────────────────────────────────
+
+QPair<qsizetype, qsizetype> CacheAnalitico::fatia(const QDate &inicio, const QDate &fim) const
+{
+    const qsizetype primeira = inicio.isValid() ? primeiraDoDia(qint32(inicio.toJulianDay())) : 0;
+    const qsizetype ultima   = fim.isValid() ? primeiraDoDia(qint32(fim.toJulianDay()) + 1)
+                                             : m_dias.size();
+    return {primeira, qMax(primeira, ultima)};
+}
+
+qint64 CacheAnalitico::soma(TipoLancamento tipo, const QDate &inicio, const QDate &fim) const
+{
+    const auto [primeira, ultima] = fatia(inicio, fim);
+    return Agregacao::somaMascarada(m_valores.constData() + primeira,
+                                    m_tipos.constData() + primeira,
+                                    ultima - primeira, quint8(tipo));
+}
+
+QList<qint64> CacheAnalitico::somaPorMes(TipoLancamento tipo, const QDate &primeiroMes,
+                                         int meses) const
+{
+    QList<qint64> totais(qMax(meses, 0), 0);
+    if (!primeiroMes.isValid()) return totais;
+
+    // Dados ordenados por dia: cada mês é uma fatia contígua
+    QDate     mes = QDate(primeiroMes.year(), primeiroMes.month(), 1);
+    qsizetype primeira = primeiraDoDia(qint32(mes.toJulianDay()));
+    for (int m = 0; m < totais.size(); ++m) {
+        mes = mes.addMonths(1);
+        const qsizetype ultima = primeiraDoDia(qint32(mes.toJulianDay()));
+        totais[m] = Agregacao::somaMascarada(m_valores.constData() + primeira,
+                                             m_tipos.constData() + primeira,
+                                             ultima - primeira, quint8(tipo));
+        primeira = ultima;
+    }
+    return totais;
+}
+
+QList<qint64> CacheAnalitico::somaPorDia(TipoLancamento tipo, const QDate &inicio,
+                                         const QDate &fim) const
+{
+    if (!inicio.isValid() || !fim.isValid() || fim < inicio) return {};
+    const qint32 base = qint32(inicio.toJulianDay());
+    QList<qint64> totais(inicio.daysTo(fim) + 1, 0);
+
+    // Os dias já vêm agrupados (ordenados); o índice é só a distância ao início
+    const auto [primeira, ultima] = fatia(inicio, fim);
+    const quint8 t = quint8(tipo);
+    for (qsizetype i = primeira; i < ultima; ++i)
+        totais[m_dias[i] - base] += m_valores[i] & -qint64(m_tipos[i] == t);
+    return totais;
+}
+
+QDate CacheAnalitico::primeiraData() const
+{
+    return m_dias.isEmpty() ? QDate() : QDate::fromJulianDay(m_dias.first());
+}
+
+QDate CacheAnalitico::ultimaData() const
+{
+    return m_dias.isEmpty() ? QDate() : QDate::fromJulianDay(m_dias.last());
+}
+
+QHash<int, qint64> CacheAnalitico::somaPorCategoria(TipoLancamento tipo, const QDate &inicio,
+                                                    const QDate &fim) const
+{
+    const auto [primeira, ultima] = fatia(inicio, fim);
+
+    // Ids de categoria são pequenos e densos: acumulador direto, sem hash no laço
+    QList<qint64> acumulado(m_maiorCategoria + 1, 0);
+    Agregacao::somaPorChave(m_valores.constData() + primeira,
+                            m_tipos.constData() + primeira,
+                            m_categorias.constData() + primeira,
+                            ultima - primeira, quint8(tipo),
+                            acumulado.data(), qint32(acumulado.size()));
+
+    QHash<int, qint64> totais;
+    for (qsizetype c = 0; c < acumulado.size(); ++c)
+        if (acumulado[c] != 0) totais.insert(int(c), acumulado[c]);
+    return totais;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "models/Lancamento.h"
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QtGlobal>
+
+// Cache colunar (struct-of-arrays) de todos os lançamentos para as agregações
+// do Dashboard: uma coluna contígua por campo, ordenada por dia, sem QString
+// nem QDate por linha. Um intervalo de datas vira uma fatia por busca binária;
+// somas e agrupamentos varrem a fatia com os kernels de utils/Agregacao.
+// Carregado uma vez pelo DatabaseManager e mantido em dia pelas mutações.
+class CacheAnalitico
+{
+public:
+    bool      carregado() const { return m_carregado; }
+    qsizetype tamanho() const   { return m_dias.size(); }
+    void      limpar();  // descarta as colunas; carregado() volta a false
+
+    // Muda a cada carga e mutação (nunca volta atrás): quem deriva algo do
+    // cache — as séries do gráfico de tendência — só refaz quando ela muda
+    quint64   versao() const    { return m_versao; }
+
+    // Carga em massa: linhas em qualquer ordem, depois concluirCarga() ordena
+    void reservar(qsizetype n);
+    void anexar(TipoLancamento tipo, int id, qint64 valorCentavos, qint32 dia, int categoriaId);
+    void concluirCarga();
+
+    // Incremental — O(n) no pior caso (deslocamento das colunas), mas um
+    // memmove de inteiros: bem abaixo de um quadro mesmo com 1M de linhas
+    void adicionar(const Lancamento &l);
+    void retirar(const Lancamento &l);
+
+    // Intervalos fechados; data inválida = sem limite daquele lado
+    qint64 soma(TipoLancamento tipo, const QDate &inicio = {}, const QDate &fim = {}) const;
+
+    // Um total por mês, `meses` meses consecutivos a partir do mês de `primeiroMes`
+    QList<qint64> somaPorMes(TipoLancamento tipo, const QDate &primeiroMes, int meses) const;
+
+    // Um total por dia de [inicio, fim] (ambas válidas) — série diária do gráfico de tendência
+    QList<qint64> somaPorDia(TipoLancamento tipo, const QDate &inicio, const QDate &fim) const;
+
+    // Dia do lançamento mais antigo / mais recente; inválidas com o cache vazio
+    QDate primeiraData() const;
+    QDate ultimaData() const;
+
+    // categoriaId → total (entradas: tudo na chave 0); categorias sem lançamento ficam de fora
+    QHash<int, qint64> somaPorCategoria(TipoLancamento tipo,
+                                        const QDate &inicio = {}, const QDate &fim = {}) const;
+
+private:
+    // [primeira, última+1) das linhas com dia em [inicio, fim]
+    QPair<qsizetype, qsizetype> fatia(const QDate &inicio, const QDate &fim) const;
+    qsizetype primeiraDoDia(qint32 dia) const;
+
+    QList<qint32> m_dias;        // QDate::toJulianDay(), crescente
+    QList<qint64> m_valores;     // centavos
+    QList<quint8> m_tipos;       // int(TipoLancamento)
+    QList<qint32> m_categorias;  // 0 para entradas
+    QList<qint32> m_ids;         // só para localizar a linha em retirar()
+    qint32        m_maiorCategoria = 0;
+    quint64       m_versao         = 0;
+    bool          m_carregado      = false;
+};
@@ -0,0 +1,175 @@
+#include "core/ClassificadorBayes.h"
+
+#include "utils/Fingerprint.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr quint32 ASSINATURA = 0x4f4e4231;  // "ONB1"
+
+QStringList ClassificadorBayes::tokens(const QString &descricao)
+{
+    const QString normalizada = normalizarDescricao(descricao);
+
+    QStringList lista;
+    QSet<QString> vistos;
+    QString atual;
+    auto fechar = [&]() {
+        bool temLetra = false;
+        for (const QChar c : std::as_const(atual))
+            if (c.isLetter()) { temLetra = true; break; }
+        if (atual.size() >= 2 && temLetra && !vistos.contains(atual)) {
+            vistos.insert(atual);
+            lista.append(atual);
+        }
+        atual.clear();
+    };
+    for (const QChar c : normalizada) {
+        if (c.isLetterOrNumber()) atual.append(c);
+        else fechar();
+    }
+    fechar();
+    return lista;
+}
+
+void ClassificadorBayes::limpar()
+{
+    m_contagens.clear();
+    m_classes.clear();
+    m_documentos = 0;
+}
+
+void ClassificadorBayes::aprender(const QString &descricao, int categoriaId, int delta)
+{
+    if (categoriaId <= 0 || delta == 0) return;
+    const QStringList lista = tokens(descricao);
+    if (lista.isEmpty()) return;
+
+    Classe &classe = m_classes[categoriaId];
+    classe.documentos += delta;
+    classe.tokens     += delta * lista.size();
+    m_documentos      += delta;
+
+    for (const QString &t : lista) {
+        auto it = m_contagens.find(t);
+        if (it == m_contagens.end()) {
+            if (delta < 0) continue;
+            it = m_contagens.insert(t, {});
+        }
+        qint64 &n = (*it)[categoriaId];
+        n += delta;
+        if (n <= 0) {
+            it->remove(categoriaId);
+            if (it->isEmpty()) m_contagens.erase(it);
+        }
+    }
+    if (classe.documentos <= 0) m_classes.remove(categoriaId);
+}
+
+ClassificadorBayes::Palpite ClassificadorBayes::prever(const QString &descricao) const
+{
+    if (m_documentos <= 0) return {};
+
+    // Só tokens conhecidos contam; sem nenhum, não há evidência para sugerir
+    QList<const QHash<int, qint64> *> conhecidos;
+    for (const QString &t : tokens(descricao)) {
+        const auto it = m_contagens.constFind(t);
+        if (it != m_contagens.cend()) conhecidos.append(&it.value());
+    }
+    if (conhecidos.isEmpty()) return {};
+
+    // log P(c) + Σ log P(t|c), com suavização de Laplace
+    const double vocabulario = double(m_contagens.size());
+    const double logTotal    = std::log(double(m_documentos + m_classes.size()));
+    QList<QPair<int, double>> logs;
+    logs.reserve(m_classes.size());
+    double maximo = -std::numeric_limits<double>::infinity();
+    for (auto c = m_classes.cbegin(); c != m_classes.cend(); ++c) {
+        double l = std::log(double(c->documentos + 1)) - logTotal;
+        const double logDenominador = std::log(double(c->tokens) + vocabulario);
+        for (const QHash<int, qint64> *porCategoria : std::as_const(conhecidos))
+            l += std::log(double(porCategoria->value(c.key(), 0) + 1)) - logDenominador;
+        logs.append({c.key(), l});
+        maximo = std::max(maximo, l);
+    }
+
+    // Posterior normalizada (softmax sobre os logs)
+    Palpite palpite;
+    double soma = 0.0;
+    for (const auto &[categoria, l] : std::as_const(logs)) {
+        soma += std::exp(l - maximo);
+        if (l == maximo) palpite.categoriaId = categoria;
+    }
+    palpite.confianca = 1.0 / soma;
+    return palpite;
+}
+
+// ── Serialização ──────────────────────────────────────────────────────────────
+
+QByteArray ClassificadorBayes::serializar() const
+{
+    QByteArray dados;
+    QDataStream out(&dados, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << ASSINATURA << qint32(VERSAO) << m_documentos << qint32(m_classes.size());
+    for (auto c = m_classes.cbegin(); c != m_classes.cend(); ++c)
+        out << qint32(c.key()) << c->documentos << c->tokens;
+
+    out << qint32(m_contagens.size());
+    for (auto t = m_contagens.cbegin(); t != m_contagens.cend(); ++t) {
+        out << t.key() << qint32(t->size());
+        for (auto n = t->cbegin(); n != t->cend(); ++n)
+            out << qint32(n.key()) << n.value();
+    }
+    return dados;
+}
+
+bool ClassificadorBayes::desserializar(const QByteArray &dados)
+{
+    limpar();
+    QDataStream in(dados);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 assinatura = 0;
+    qint32  versao = 0, classes = 0, vocabulario = 0;
+    in >> assinatura >> versao >> m_documentos >> classes;
+    if (assinatura != ASSINATURA || versao != VERSAO || classes < 0) {
+        limpar();
+        return false;
+    }
+    for (qint32 i = 0; i < classes && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0;
+        Classe c;
+        in >> id >> c.documentos >> c.tokens;
+        m_classes.insert(id, c);
+    }
+
+    in >> vocabulario;
+    m_contagens.reserve(qMax(vocabulario, 0));
+    for (qint32 i = 0; i < vocabulario && in.status() == QDataStream::Ok; ++i) {
+        QString token;
+        qint32 n = 0;
+        in >> token >> n;
+        QHash<int, qint64> &porCategoria = m_contagens[token];
+        for (qint32 k = 0; k < n && in.status() == QDataStream::Ok; ++k) {
+            qint32 categoria = 0;
+            qint64 ocorrencias = 0;
+            in >> categoria >> ocorrencias;
+            porCategoria.insert(categoria, ocorrencias);
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        limpar();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+// Naive Bayes multinomial: tokens do histórico → categoria. Só contadores, então
+// aprender e desaprender um lançamento é O(tokens) — sem retreino. Prever custa
+// O(tokens × categorias), barato o bastante para cada tecla e para importações.
+// Serializável para a tabela `modelos` (e, com ela, para o .enc).
+class ClassificadorBayes
+{
+public:
+    static constexpr int    VERSAO           = 1;    // formato de serializar()
+    static constexpr double CONFIANCA_MINIMA = 0.6;  // abaixo disso, não sugerir
+
+    struct Palpite {
+        int    categoriaId = 0;    // 0 = sem palpite (modelo vazio)
+        double confianca   = 0.0;  // probabilidade a posteriori, 0–1
+    };
+
+    void limpar();
+
+    // delta = +1 ao gravar um lançamento, -1 ao removê-lo (ou antes de editá-lo)
+    void aprender(const QString &descricao, int categoriaId, int delta);
+
+    Palpite prever(const QString &descricao) const;
+
+    qint64 documentos() const { return m_documentos; }
+
+    QByteArray serializar() const;
+    bool       desserializar(const QByteArray &dados);
+
+    // Palavras da descrição normalizada, sem repetição; números e letras
+    // soltas ficam de fora (datas, parcelas e códigos de transação)
+    static QStringList tokens(const QString &descricao);
+
+private:
+    struct Classe {
+        qint64 documentos = 0;
+        qint64 tokens     = 0;
+    };
+
+    QHash<QString, QHash<int, qint64>> m_contagens;  // token → categoria → ocorrências
+    QHash<int, Classe>                 m_classes;
+    qint64                             m_documentos = 0;
+};
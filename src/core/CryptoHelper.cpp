@@ -1,4 +1,5 @@
 #include "core/CryptoHelper.h"
+#include "utils/Tracer.h"
 
 #include <openssl/evp.h>
 #include <openssl/rand.h>
@@ -9,6 +10,7 @@ namespace CryptoHelper {
 bool derivarChaveEIV(const QByteArray &salt, const QString &senha,
                      QByteArray &chave, QByteArray &iv)
 {
+    TRACE_SPAN("CryptoHelper::derivarChaveEIV", "crypto");
     QByteArray derived(DERIVED_LENGTH, 0);
     int res = PKCS5_PBKDF2_HMAC(
         senha.toUtf8().constData(), senha.toUtf8().length(),
@@ -25,6 +27,9 @@ QByteArray encrypt(const QByteArray &plaintext,
                    const QByteArray &key,
                    const QByteArray &iv)
 {
+    Tracer::Span span("CryptoHelper::encrypt", "crypto");
+    span.arg("bytes", plaintext.size());
+
     EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
     if (!ctx) return {};
     QByteArray ciphertext(plaintext.size() + 32, 0);
@@ -46,6 +51,9 @@ QByteArray decrypt(const QByteArray &ciphertext,
                    const QByteArray &key,
                    const QByteArray &iv)
 {
+    Tracer::Span span("CryptoHelper::decrypt", "crypto");
+    span.arg("bytes", ciphertext.size());
+
     EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
     if (!ctx) return {};
     QByteArray plaintext(ciphertext.size() + 32, 0);
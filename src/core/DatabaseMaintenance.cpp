@@ -0,0 +1,89 @@
+#include "core/DatabaseMaintenance.h"
+#include "utils/Tracer.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+
+DatabaseMaintenance::DatabaseMaintenance(const QString &caminhoBanco, Operacao operacao,
+                                         QObject *parent)
+    : QObject(parent)
+    , m_caminhoBanco(caminhoBanco)
+    , m_operacao(operacao)
+{
+}
+
+QString DatabaseMaintenance::descricao(Operacao operacao)
+{
+    switch (operacao) {
+    case Operacao::Analisar:  return "ANALYZE";
+    case Operacao::Compactar: return "VACUUM";
+    default:                  return "Verificação de integridade";
+    }
+}
+
+void DatabaseMaintenance::executar()
+{
+    TRACE_SPAN("DatabaseMaintenance::executar", "db");
+    const QString conexao = QString("manutencao-%1").arg(quintptr(this));
+    QString resultado;
+    bool ok = false;
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", conexao);
+        db.setDatabaseName(m_caminhoBanco);
+        // A conexão principal pode estar lendo; espera o lock em vez de falhar
+        db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=30000");
+
+        QElapsedTimer t;
+        t.start();
+        const qint64 antes = QFileInfo(m_caminhoBanco).size();
+
+        if (!db.open()) {
+            resultado = db.lastError().text();
+        } else {
+            // Mesmos pragmas da conexão principal: journal em memória, nenhum
+            // -journal em disco ao lado do .db decriptado
+            QSqlQuery q(db);
+            q.exec("PRAGMA foreign_keys = ON");
+            q.exec("PRAGMA journal_mode = MEMORY");
+            q.exec("PRAGMA synchronous = NORMAL");
+            switch (m_operacao) {
+            case Operacao::Analisar:
+                ok = q.exec("ANALYZE");
+                if (ok) resultado = QString("Estatísticas atualizadas em %1 ms.").arg(t.elapsed());
+                break;
+            case Operacao::Compactar:
+                ok = q.exec("VACUUM");
+                if (ok)
+                    resultado = QString("Banco compactado em %1 ms: %2 KiB → %3 KiB.")
+                        .arg(t.elapsed()).arg(antes / 1024)
+                        .arg(QFileInfo(m_caminhoBanco).size() / 1024);
+                break;
+            case Operacao::VerificarIntegridade: {
+                ok = q.exec("PRAGMA integrity_check");
+                QStringList problemas;
+                while (ok && q.next()) {
+                    const QString linha = q.value(0).toString();
+                    if (linha != "ok") problemas << linha;
+                }
+                if (ok && !problemas.isEmpty()) {
+                    ok = false;
+                    resultado = "Problemas encontrados:\n" + problemas.join('\n');
+                } else if (ok) {
+                    resultado = QString("Nenhum problema encontrado (%1 ms).").arg(t.elapsed());
+                }
+                break;
+            }
+            }
+            if (!ok && resultado.isEmpty()) resultado = q.lastError().text();
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(conexao);
+
+    emit concluido(ok, resultado);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+// ANALYZE, VACUUM e integrity_check em uma QThread própria, com conexão
+// própria (leitura e escrita) ao .db temporário e os mesmos pragmas da
+// principal. Quem dispara trava as edições até concluido() e então chama
+// DatabaseManager::salvar() para levar o resultado ao .enc.
+class DatabaseMaintenance : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Operacao { Analisar, Compactar, VerificarIntegridade };
+
+    DatabaseMaintenance(const QString &caminhoBanco, Operacao operacao,
+                        QObject *parent = nullptr);
+
+    static QString descricao(Operacao operacao);
+
+public slots:
+    void executar();
+
+signals:
+    // resultado: resumo legível (ex.: saída do integrity_check)
+    void concluido(bool ok, const QString &resultado);
+
+private:
+    QString  m_caminhoBanco;
+    Operacao m_operacao;
+};
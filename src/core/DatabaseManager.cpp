@@ -1,14 +1,27 @@
 #include "core/DatabaseManager.h"
 #include "core/CryptoHelper.h"
+#include "utils/Fingerprint.h"
+#include "utils/Tracer.h"
 
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QRegularExpression>
+#include <QSqlDriver>
 #include <QSqlError>
 #include <QSqlQuery>
 
+#include <algorithm>
+#include <tuple>
+
+#ifdef ORCAMENTO_COM_SQLITE3
+#include <sqlite3.h>
+#endif
+
 static const QStringList CATEGORIAS_PADRAO = {
     "Aluguel/Moradia", "Internet", "Luz/Água/Gás", "Transporte",
     "Alimentação", "Educação", "Saúde", "Streaming/TV/Telefone",
@@ -23,6 +36,57 @@ static QString sanitizarNome(const QString &nome)
     return s.isEmpty() ? "usuario" : s.left(50);
 }
 
+static QString tabelaDe(TipoLancamento tipo)
+{
+    switch (tipo) {
+    case TipoLancamento::Entrada:   return "entradas";
+    case TipoLancamento::GastoFixo: return "gastos_fixos";
+    default:                        return "gastos_variaveis";
+    }
+}
+
+static QString colunaDescricao(TipoLancamento tipo)
+{
+    return tipo == TipoLancamento::Entrada ? "origem" : "historico";
+}
+
+// " WHERE <coluna> >= :ini AND <coluna> <= :fim", só com os limites que o
+// período tem — datas ISO comparam como texto, então vira range scan no
+// índice idx_<tabela>_data. Valores ligados por vincularPeriodo().
+static QString condicaoPeriodo(const Periodo &periodo, const QString &coluna)
+{
+    QStringList condicoes;
+    if (periodo.inicio.isValid()) condicoes << coluna + " >= :ini";
+    if (periodo.fim.isValid())    condicoes << coluna + " <= :fim";
+    return condicoes.isEmpty() ? QString() : " WHERE " + condicoes.join(" AND ");
+}
+
+static void vincularPeriodo(QSqlQuery &q, const Periodo &periodo)
+{
+    if (periodo.inicio.isValid()) q.bindValue(":ini", periodo.inicio.toString("yyyy-MM-dd"));
+    if (periodo.fim.isValid())    q.bindValue(":fim", periodo.fim.toString("yyyy-MM-dd"));
+}
+
+// Planos de parcelamento com alguma parcela no período: terminam depois do
+// início e começam antes do fim. Mesmos parâmetros de vincularPeriodo().
+static QString condicaoVigencia(const Periodo &periodo)
+{
+    QStringList condicoes;
+    if (periodo.inicio.isValid()) condicoes << "p.ultima_data >= :ini";
+    if (periodo.fim.isValid())    condicoes << "p.primeira_data <= :fim";
+    return condicoes.isEmpty() ? QString() : " WHERE " + condicoes.join(" AND ");
+}
+
+// Ocorrências não têm fim natural: sem fim, até o fim do mês corrente
+static Periodo ateMesCorrente(Periodo periodo)
+{
+    if (!periodo.fim.isValid()) {
+        const QDate hoje = QDate::currentDate();
+        periodo.fim = QDate(hoje.year(), hoje.month(), hoje.daysInMonth());
+    }
+    return periodo;
+}
+
 // ── Singleton ─────────────────────────────────────────────────────────────────
 
 DatabaseManager &DatabaseManager::instance()
@@ -31,14 +95,28 @@ DatabaseManager &DatabaseManager::instance()
     return inst;
 }
 
+DatabaseManager::DatabaseManager()
+{
+    bool ok = false;
+    const int ms = qEnvironmentVariableIntValue("ORCAMENTO_QUERY_LENTA_MS", &ok);
+    definirLimiteQueryLentaMs(ok ? ms : 100);
+}
+
 // ── Conexão ───────────────────────────────────────────────────────────────────
 
+void DatabaseManager::definirDiretorioDados(const QString &diretorio)
+{
+    m_diretorioDados = diretorio;
+}
+
 bool DatabaseManager::conectar(const QString &nome, const QString &senha)
 {
+    TRACE_SPAN("DatabaseManager::conectar", "db");
     m_senha = senha;
 
-    const QString appDir  = QCoreApplication::applicationDirPath();
-    const QString dataDir = appDir + "/data";
+    const QString dataDir = m_diretorioDados.isEmpty()
+        ? QCoreApplication::applicationDirPath() + "/data"
+        : m_diretorioDados;
     QDir().mkpath(dataDir);
 
     const QString slug = sanitizarNome(nome);
@@ -61,12 +139,17 @@ bool DatabaseManager::conectar(const QString &nome, const QString &senha)
         return false;
     }
 
-    QSqlQuery q(m_db);
-    q.exec("PRAGMA foreign_keys = ON");
-    q.exec("PRAGMA journal_mode = MEMORY");  // sem arquivos de journal em disco
-    q.exec("PRAGMA synchronous = NORMAL");
+    Consulta q(m_db);
+    executar(q, "conectar", "PRAGMA foreign_keys = ON");
+    executar(q, "conectar", "PRAGMA journal_mode = MEMORY");  // sem arquivos de journal em disco
+    executar(q, "conectar", "PRAGMA synchronous = NORMAL");
 
     if (!criarEsquema()) return false;
+    if (!carregarImpressoes()) return false;
+    compilarRegras();
+    carregarOrcamentos();
+    carregarModelo();
+    notificar({Mutacao::Operacao::Recarga, {}, {}});
 
     // Primeiro acesso: gera o .enc inicial
     if (!QFile::exists(m_arquivoEnc))
@@ -82,10 +165,17 @@ bool DatabaseManager::conectar(const QString &nome, const QString &senha)
 void DatabaseManager::desconectar()
 {
     if (!m_db.isOpen()) return;
+    if (m_modelosAlterados) persistirModelo();
     m_db.close();
+    m_db = QSqlDatabase();  // removeDatabase exige que nenhuma cópia siga viva
     QSqlDatabase::removeDatabase("main");
     salvarEEncriptar();
     QFile::remove(m_arquivoTmp);
+    m_classificador.limpar();
+    m_estatisticasCategoria.limpar();
+    m_anomalias.limpar();
+    m_orcamentos.clear();
+    notificar({Mutacao::Operacao::Recarga, {}, {}});
 }
 
 bool DatabaseManager::isConectado() const
@@ -93,14 +183,66 @@ bool DatabaseManager::isConectado() const
     return m_db.isOpen();
 }
 
+QString DatabaseManager::caminhoBanco() const
+{
+    return m_arquivoTmp;
+}
+
+bool DatabaseManager::possuiLancamentos()
+{
+    Consulta q(m_db);
+    executar(q, "possuiLancamentos",
+             "SELECT EXISTS(SELECT 1 FROM entradas)"
+             "    OR EXISTS(SELECT 1 FROM gastos_fixos)"
+             "    OR EXISTS(SELECT 1 FROM gastos_variaveis)");
+    return q.next() && q.value(0).toBool();
+}
+
+// ── Lote ──────────────────────────────────────────────────────────────────────
+
+void DatabaseManager::iniciarLote()
+{
+    if (m_emLote) return;
+    m_db.transaction();
+    m_emLote = true;
+}
+
+bool DatabaseManager::concluirLote()
+{
+    TRACE_SPAN("DatabaseManager::concluirLote", "db");
+    if (!m_emLote) return true;
+    m_emLote = false;
+    if (!m_db.commit()) {
+        qDebug() << "concluirLote:" << m_db.lastError().text();
+        return false;
+    }
+    return salvarEEncriptar();
+}
+
+void DatabaseManager::cancelarLote()
+{
+    if (!m_emLote) return;
+    m_emLote = false;
+    m_db.rollback();
+    carregarImpressoes();  // o Bloom pode ter recebido hashes desfeitos
+    carregarOrcamentos();  // orçamentos definidos no lote
+    carregarModelo();      // e o classificador, lançamentos desfeitos
+    notificar({Mutacao::Operacao::Recarga, {}, {}});  // idem os observadores
+}
+
 // ── Cripto ────────────────────────────────────────────────────────────────────
 
 bool DatabaseManager::decriptarParaTemp()
 {
-    QFile enc(m_arquivoEnc);
-    if (!enc.open(QIODevice::ReadOnly)) return false;
-    const QByteArray dados = enc.readAll();
-    enc.close();
+    TRACE_SPAN("DatabaseManager::decriptarParaTemp", "db");
+
+    QByteArray dados;
+    {
+        TRACE_SPAN("ler .enc", "io");
+        QFile enc(m_arquivoEnc);
+        if (!enc.open(QIODevice::ReadOnly)) return false;
+        dados = enc.readAll();
+    }
 
     if (dados.size() <= CryptoHelper::SALT_LENGTH) return false;
 
@@ -108,11 +250,15 @@ bool DatabaseManager::decriptarParaTemp()
     const QByteArray ciphertext = dados.mid(CryptoHelper::SALT_LENGTH);
 
     QByteArray chave, iv;
+    QElapsedTimer kdf;
+    kdf.start();
     if (!CryptoHelper::derivarChaveEIV(salt, m_senha, chave, iv)) return false;
+    m_derivacaoMs = kdf.elapsed();
 
     const QByteArray plaintext = CryptoHelper::decrypt(ciphertext, chave, iv);
     if (plaintext.isEmpty()) return false;
 
+    TRACE_SPAN("gravar .db", "io");
     QFile tmp(m_arquivoTmp);
     if (!tmp.open(QIODevice::WriteOnly)) return false;
     tmp.write(plaintext);
@@ -122,20 +268,35 @@ bool DatabaseManager::decriptarParaTemp()
 
 bool DatabaseManager::salvarEEncriptar()
 {
-    QFile tmp(m_arquivoTmp);
-    if (!tmp.open(QIODevice::ReadOnly)) return false;
-    const QByteArray dbData = tmp.readAll();
-    tmp.close();
+    if (m_emLote) return true;  // concluirLote() salva uma única vez
+    if (m_modelosAlterados) persistirModelo();
+
+    Tracer::Span span("DatabaseManager::salvarEEncriptar", "db");
+    QElapsedTimer cronometro;
+    cronometro.start();
+
+    QByteArray dbData;
+    {
+        TRACE_SPAN("ler .db", "io");
+        QFile tmp(m_arquivoTmp);
+        if (!tmp.open(QIODevice::ReadOnly)) return false;
+        dbData = tmp.readAll();
+    }
     if (dbData.isEmpty()) return false;
+    span.arg("bytes", dbData.size());
 
     const QByteArray salt = CryptoHelper::gerarSalt();
     QByteArray chave, iv;
+    QElapsedTimer kdf;
+    kdf.start();
     if (!CryptoHelper::derivarChaveEIV(salt, m_senha, chave, iv)) return false;
+    m_derivacaoMs = kdf.elapsed();
 
     const QByteArray encrypted = CryptoHelper::encrypt(dbData, chave, iv);
     if (encrypted.isEmpty()) return false;
 
     // Escrita atômica: .new → rename
+    TRACE_SPAN("gravar .enc", "io");
     const QString encNew = m_arquivoEnc + ".new";
     QFile enc(encNew);
     if (!enc.open(QIODevice::WriteOnly)) return false;
@@ -144,16 +305,218 @@ bool DatabaseManager::salvarEEncriptar()
     enc.close();
 
     QFile::remove(m_arquivoEnc);
-    return QFile::rename(encNew, m_arquivoEnc);
+    if (!QFile::rename(encNew, m_arquivoEnc)) return false;
+    m_salvamentoMs = cronometro.elapsed();
+    return true;
+}
+
+bool DatabaseManager::salvar()
+{
+    return salvarEEncriptar();
+}
+
+// ── Execução ──────────────────────────────────────────────────────────────────
+
+bool DatabaseManager::Consulta::next()
+{
+    if (QSqlQuery::next()) {
+        ++m_linhas;
+        return true;
+    }
+    encerrar();
+    return false;
+}
+
+void DatabaseManager::Consulta::finish()
+{
+    encerrar();
+    QSqlQuery::finish();
+}
+
+bool DatabaseManager::Consulta::prepare(const QString &sql)
+{
+    encerrar();
+    return QSqlQuery::prepare(sql);
+}
+
+void DatabaseManager::Consulta::encerrar()
+{
+    if (!m_dono) return;
+    DatabaseManager *dono = m_dono;
+    m_dono = nullptr;
+    dono->registrarExecucao(*this, m_rotulo, m_relogio.nsecsElapsed(), m_linhas);
+}
+
+bool DatabaseManager::executar(Consulta &q, const char *rotulo)
+{
+    q.encerrar();
+    TRACE_SPAN(rotulo, "sql");
+    q.m_relogio.start();
+    return medir(q, rotulo, q.exec());
+}
+
+bool DatabaseManager::executar(Consulta &q, const char *rotulo, const QString &sql)
+{
+    q.encerrar();
+    TRACE_SPAN(rotulo, "sql");
+    q.m_relogio.start();
+    return medir(q, rotulo, q.exec(sql));
+}
+
+// Escrita ou falha: contada já; SELECT: a medição segue aberta na leitura
+bool DatabaseManager::medir(Consulta &q, const char *rotulo, bool ok)
+{
+    q.m_rotulo = rotulo;
+    q.m_linhas = 0;
+    if (ok && q.isSelect())
+        q.m_dono = this;
+    else
+        registrarExecucao(q, rotulo, q.m_relogio.nsecsElapsed(), ok ? q.numRowsAffected() : -1);
+    return ok;
+}
+
+void DatabaseManager::registrarExecucao(const QSqlQuery &q, const char *rotulo, qint64 ns,
+                                        qint64 linhas)
+{
+    m_latenciaQueries.registrar(quint64(ns));
+
+    EstatisticaQuery &e = m_estatisticas[q.lastQuery()];
+    if (e.execucoes == 0) {
+        e.rotulo = QString::fromLatin1(rotulo);
+        e.sql    = q.lastQuery();
+    }
+    ++e.execucoes;
+    e.totalNs  += ns;
+    e.maximoNs  = qMax(e.maximoNs, ns);
+    e.latencia.registrar(quint64(ns));
+
+    if (m_limiteLentaNs >= 0 && ns > m_limiteLentaNs) {
+        ++e.lentas;
+        logarQueryLenta(q, rotulo, ns, linhas);
+    }
+}
+
+// Só no caminho lento. As linhas vêm da própria leitura (nada é reexecutado);
+// o plano vem de EXPLAIN QUERY PLAN, que só compila o statement, com os mesmos
+// parâmetros — por nome quando o SQL usa :nome, que pode se repetir
+void DatabaseManager::logarQueryLenta(const QSqlQuery &q, const char *rotulo, qint64 ns,
+                                      qint64 linhas)
+{
+    const QString      sql     = q.lastQuery();
+    const QVariantList valores = q.boundValues();
+    const QString      verbo   = sql.trimmed().section(' ', 0, 0).toUpper();
+    const bool dml = verbo == "SELECT" || verbo == "WITH" || verbo == "INSERT"
+                  || verbo == "UPDATE" || verbo == "DELETE";
+
+    QStringList tipos;
+    for (const QVariant &v : valores)
+        tipos << (v.isNull() ? QString("NULL") : QString::fromLatin1(v.metaType().name()));
+
+    QStringList plano;
+    if (dml) {
+        QSqlQuery aux(m_db);
+        if (aux.prepare("EXPLAIN QUERY PLAN " + sql)) {
+            static const QRegularExpression nomeado(":[A-Za-z_][A-Za-z0-9_]*");
+            QSet<QString> nomes;
+            for (auto it = nomeado.globalMatch(sql); it.hasNext();)
+                nomes.insert(it.next().captured());
+            if (nomes.isEmpty()) {
+                for (int i = 0; i < valores.size(); ++i)
+                    aux.bindValue(i, valores.at(i));
+            } else {
+                for (const QString &nome : std::as_const(nomes))
+                    aux.bindValue(nome, q.boundValue(nome));
+            }
+            if (aux.exec())
+                while (aux.next()) plano << aux.value(3).toString();  // coluna "detail"
+        }
+    }
+
+    qDebug().noquote()
+        << QString("Query lenta: %1 ms em %2 (%3 linha(s))\n"
+                   "  SQL: %4\n"
+                   "  Parâmetros: %5\n"
+                   "  Plano: %6")
+               .arg(ns / 1e6, 0, 'f', 1)
+               .arg(QString::fromLatin1(rotulo))
+               .arg(linhas)
+               .arg(sql.simplified(),
+                    tipos.isEmpty() ? QString("—") : tipos.join(", "),
+                    plano.isEmpty() ? QString("—") : plano.join(" | "));
+}
+
+// ── Estatísticas de queries ───────────────────────────────────────────────────
+
+void DatabaseManager::definirLimiteQueryLentaMs(int ms)
+{
+    m_limiteLentaNs = ms < 0 ? -1 : qint64(ms) * 1000000;
+}
+
+int DatabaseManager::limiteQueryLentaMs() const
+{
+    return m_limiteLentaNs < 0 ? -1 : int(m_limiteLentaNs / 1000000);
+}
+
+QList<EstatisticaQuery> DatabaseManager::estatisticasQueries() const
+{
+    QList<EstatisticaQuery> lista = m_estatisticas.values();
+    std::sort(lista.begin(), lista.end(), [](const EstatisticaQuery &a, const EstatisticaQuery &b) {
+        return a.totalNs > b.totalNs;
+    });
+    return lista;
+}
+
+void DatabaseManager::zerarEstatisticasQueries()
+{
+    m_estatisticas.clear();
+    m_latenciaQueries.limpar();
+}
+
+// ── Diagnóstico ───────────────────────────────────────────────────────────────
+
+DiagnosticoBanco DatabaseManager::diagnostico()
+{
+    DiagnosticoBanco d;
+    d.bytesBanco   = QFileInfo(m_arquivoTmp).size();
+    d.bytesEnc     = QFileInfo(m_arquivoEnc).size();
+    d.derivacaoMs  = m_derivacaoMs;
+    d.salvamentoMs = m_salvamentoMs;
+
+    // exec() direto: as contagens do painel não entram nas estatísticas que ele mostra
+    QSqlQuery q(m_db);
+    for (const char *tabela : {"entradas", "gastos_fixos", "gastos_variaveis",
+                               "categorias", "regras_categoria", "impressoes_digitais",
+                               "agregado_diario", "orcamentos", "recorrencias",
+                               "ocorrencias_recorrencia", "parcelamentos"}) {
+        if (q.exec(QString("SELECT COUNT(*) FROM ") + tabela) && q.next())
+            d.linhasPorTabela.append({QString::fromLatin1(tabela), q.value(0).toLongLong()});
+    }
+
+#ifdef ORCAMENTO_COM_SQLITE3
+    // Handle nativo do QSQLITE; só confiável com o Qt compilado contra a mesma
+    // libsqlite3 (-system-sqlite), por isso a opção é explícita no CMake
+    const QVariant h = m_db.driver()->handle();
+    if (h.isValid() && qstrcmp(h.typeName(), "sqlite3*") == 0) {
+        if (sqlite3 *handle = *static_cast<sqlite3 *const *>(h.constData())) {
+            int acertos = 0, falhas = 0, maximo = 0;
+            sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_HIT,  &acertos, &maximo, 0);
+            sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_MISS, &falhas,  &maximo, 0);
+            if (acertos + falhas > 0)
+                d.taxaAcertoCache = double(acertos) / double(acertos + falhas);
+        }
+    }
+#endif
+    return d;
 }
 
 // ── Esquema ───────────────────────────────────────────────────────────────────
 
 bool DatabaseManager::criarEsquema()
 {
-    QSqlQuery q(m_db);
+    TRACE_SPAN("DatabaseManager::criarEsquema", "db");
+    Consulta q(m_db);
 
-    bool ok = q.exec(
+    bool ok = executar(q, "criarEsquema",
         "CREATE TABLE IF NOT EXISTS categorias ("
         "  id   INTEGER PRIMARY KEY AUTOINCREMENT,"
         "  nome TEXT NOT NULL UNIQUE"
@@ -161,7 +524,7 @@ bool DatabaseManager::criarEsquema()
     );
     if (!ok) { qDebug() << "criarEsquema categorias:" << q.lastError().text(); return false; }
 
-    ok = q.exec(
+    ok = executar(q, "criarEsquema",
         "CREATE TABLE IF NOT EXISTS entradas ("
         "  id             INTEGER PRIMARY KEY AUTOINCREMENT,"
         "  origem         TEXT    NOT NULL DEFAULT '',"
@@ -171,7 +534,7 @@ bool DatabaseManager::criarEsquema()
     );
     if (!ok) { qDebug() << "criarEsquema entradas:" << q.lastError().text(); return false; }
 
-    ok = q.exec(
+    ok = executar(q, "criarEsquema",
         "CREATE TABLE IF NOT EXISTS gastos_fixos ("
         "  id             INTEGER PRIMARY KEY AUTOINCREMENT,"
         "  historico      TEXT    NOT NULL DEFAULT '',"
@@ -183,7 +546,7 @@ bool DatabaseManager::criarEsquema()
     );
     if (!ok) { qDebug() << "criarEsquema gastos_fixos:" << q.lastError().text(); return false; }
 
-    ok = q.exec(
+    ok = executar(q, "criarEsquema",
         "CREATE TABLE IF NOT EXISTS gastos_variaveis ("
         "  id             INTEGER PRIMARY KEY AUTOINCREMENT,"
         "  historico      TEXT    NOT NULL DEFAULT '',"
@@ -195,8 +558,115 @@ bool DatabaseManager::criarEsquema()
     );
     if (!ok) { qDebug() << "criarEsquema gastos_variaveis:" << q.lastError().text(); return false; }
 
+    // Índice de duplicatas: hash → quantos lançamentos o compartilham
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS impressoes_digitais ("
+        "  hash       INTEGER PRIMARY KEY,"
+        "  quantidade INTEGER NOT NULL DEFAULT 1"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema impressoes_digitais:" << q.lastError().text(); return false; }
+
+    // Regras de categorização, avaliadas em ordem de cadastro (id)
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS regras_categoria ("
+        "  id                 INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "  tipo               INTEGER NOT NULL,"            // RegraCategoria::Tipo
+        "  padrao             TEXT    NOT NULL DEFAULT '',"
+        "  valor_min_centavos INTEGER NOT NULL DEFAULT 0,"  // 0 = sem limite
+        "  valor_max_centavos INTEGER NOT NULL DEFAULT 0,"
+        "  categoria_id       INTEGER NOT NULL,"
+        "  FOREIGN KEY (categoria_id) REFERENCES categorias(id) ON DELETE CASCADE"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema regras_categoria:" << q.lastError().text(); return false; }
+
+    // Modelos aprendidos (serializados); `lancamentos` confere a sincronia ao carregar
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS modelos ("
+        "  nome        TEXT    PRIMARY KEY,"
+        "  versao      INTEGER NOT NULL,"
+        "  lancamentos INTEGER NOT NULL,"
+        "  dados       BLOB    NOT NULL"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema modelos:" << q.lastError().text(); return false; }
+
+    // Limite mensal por categoria; some com ela (cascata)
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS orcamentos ("
+        "  categoria_id    INTEGER PRIMARY KEY,"
+        "  limite_centavos INTEGER NOT NULL,"
+        "  FOREIGN KEY (categoria_id) REFERENCES categorias(id) ON DELETE CASCADE"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema orcamentos:" << q.lastError().text(); return false; }
+
+    // Gastos fixos recorrentes: uma linha por regra, não por mês
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS recorrencias ("
+        "  id             INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "  historico      TEXT    NOT NULL DEFAULT '',"
+        "  valor_centavos INTEGER NOT NULL DEFAULT 0,"
+        "  dia            INTEGER NOT NULL,"
+        "  categoria_id   INTEGER NOT NULL,"
+        "  inicio         TEXT    NOT NULL,"
+        "  fim            TEXT,"
+        "  FOREIGN KEY (categoria_id) REFERENCES categorias(id) ON DELETE CASCADE"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema recorrencias:" << q.lastError().text(); return false; }
+
+    // Ocorrências já resolvidas: confirmada (gasto_id) ou dispensada (NULL).
+    // Remover o gasto gerado conta como dispensar — a ocorrência não volta.
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS ocorrencias_recorrencia ("
+        "  recorrencia_id INTEGER NOT NULL,"
+        "  mes            TEXT    NOT NULL,"
+        "  gasto_id       INTEGER,"
+        "  PRIMARY KEY (recorrencia_id, mes),"
+        "  FOREIGN KEY (recorrencia_id) REFERENCES recorrencias(id) ON DELETE CASCADE,"
+        "  FOREIGN KEY (gasto_id) REFERENCES gastos_fixos(id) ON DELETE SET NULL"
+        ") WITHOUT ROWID"
+    );
+    if (!ok) { qDebug() << "criarEsquema ocorrencias_recorrencia:" << q.lastError().text(); return false; }
+
+    // Compras parceladas: um plano por compra, não uma linha por parcela.
+    // ultima_data é derivada, só para o índice de vigência.
+    ok = executar(q, "criarEsquema",
+        "CREATE TABLE IF NOT EXISTS parcelamentos ("
+        "  id             INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "  historico      TEXT    NOT NULL DEFAULT '',"
+        "  total_centavos INTEGER NOT NULL,"
+        "  parcelas       INTEGER NOT NULL CHECK (parcelas >= 1),"
+        "  primeira_data  TEXT    NOT NULL,"
+        "  ultima_data    TEXT    NOT NULL,"
+        "  categoria_id   INTEGER NOT NULL,"
+        "  FOREIGN KEY (categoria_id) REFERENCES categorias(id) ON DELETE CASCADE"
+        ")"
+    );
+    if (!ok) { qDebug() << "criarEsquema parcelamentos:" << q.lastError().text(); return false; }
+
+    ok = executar(q, "criarEsquema",
+        "CREATE INDEX IF NOT EXISTS idx_parcelamentos_vigencia"
+        " ON parcelamentos (ultima_data, primeira_data)");
+    if (!ok) { qDebug() << "criarEsquema idx_parcelamentos_vigencia:" << q.lastError().text(); return false; }
+
+    // Filtro por período: range scan por data; valor_centavos no índice deixa
+    // os totais sem tocar na tabela (índice de cobertura)
+    for (const TipoLancamento tipo : {TipoLancamento::Entrada, TipoLancamento::GastoFixo,
+                                      TipoLancamento::GastoVariavel}) {
+        const QString tabela = tabelaDe(tipo);
+        ok = executar(q, "criarEsquema",
+            "CREATE INDEX IF NOT EXISTS idx_" + tabela + "_data ON " + tabela + " (data, valor_centavos)");
+        if (!ok) { qDebug() << "criarEsquema idx_" + tabela + "_data:" << q.lastError().text(); return false; }
+    }
+
+    if (!criarBusca()) return false;
+    if (!criarAgregadoDiario()) return false;
+
     // Semeia categorias padrão apenas se a tabela estiver vazia
-    q.exec("SELECT COUNT(*) FROM categorias");
+    executar(q, "criarEsquema", "SELECT COUNT(*) FROM categorias");
     if (q.next() && q.value(0).toInt() == 0) {
         for (const QString &nome : CATEGORIAS_PADRAO) {
             Categoria cat;
@@ -208,13 +678,184 @@ bool DatabaseManager::criarEsquema()
     return true;
 }
 
+// Índice FTS5 sem conteúdo próprio (content=''): guarda só os tokens e aponta
+// para o lançamento por rowid = id * 4 + tipo. Triggers mantêm o índice em dia
+// em toda escrita, inclusive nas remoções em cascata de categorias.
+bool DatabaseManager::criarBusca()
+{
+    Consulta q(m_db);
+    executar(q, "criarBusca", "SELECT 1 FROM sqlite_master WHERE name = 'busca'");
+    const bool existia = q.next();
+
+    m_buscaFts = existia || executar(q, "criarBusca",
+        "CREATE VIRTUAL TABLE busca USING fts5("
+        "  texto,"
+        "  content = '',"
+        "  tokenize = 'unicode61 remove_diacritics 2',"
+        "  prefix = '2 3'"
+        ")"
+    );
+    if (!m_buscaFts) {
+        qDebug() << "criarBusca: FTS5 indisponível, busca via LIKE:" << q.lastError().text();
+        return true;
+    }
+
+    for (const TipoLancamento tipo : {TipoLancamento::Entrada, TipoLancamento::GastoFixo,
+                                      TipoLancamento::GastoVariavel}) {
+        const QString tabela = tabelaDe(tipo);
+        const QString coluna = colunaDescricao(tipo);
+        const QString codigo = QString::number(int(tipo));
+        const QString novo   = QString("INSERT INTO busca(rowid, texto) VALUES (new.id * 4 + %1, new.%2);")
+                                   .arg(codigo, coluna);
+        const QString velho  = QString("INSERT INTO busca(busca, rowid, texto)"
+                                       " VALUES ('delete', old.id * 4 + %1, old.%2);").arg(codigo, coluna);
+
+        const bool ok =
+            executar(q, "criarBusca", QString("CREATE TRIGGER IF NOT EXISTS busca_%1_ai"
+                                              " AFTER INSERT ON %1 BEGIN %2 END").arg(tabela, novo))
+         && executar(q, "criarBusca", QString("CREATE TRIGGER IF NOT EXISTS busca_%1_ad"
+                                              " AFTER DELETE ON %1 BEGIN %2 END").arg(tabela, velho))
+         && executar(q, "criarBusca", QString("CREATE TRIGGER IF NOT EXISTS busca_%1_au"
+                                              " AFTER UPDATE OF %2 ON %1 BEGIN %3 %4 END")
+                                              .arg(tabela, coluna, velho, novo));
+        if (!ok) { qDebug() << "criarBusca triggers:" << q.lastError().text(); return false; }
+
+        // Bancos anteriores à busca: indexa o que já existe
+        if (!existia) {
+            executar(q, "criarBusca", QString("INSERT INTO busca(rowid, texto)"
+                                              " SELECT id * 4 + %1, %2 FROM %3")
+                                              .arg(codigo, coluna, tabela));
+        }
+    }
+    return true;
+}
+
+// Total e quantidade de gastos por dia, mantidos por triggers em gastos_fixos
+// e gastos_variaveis (inclusive nas remoções em cascata de categorias) e, para
+// as parcelas, por agregarParcelasNoDia(); um dia cujo último gasto sai some
+// da tabela. WITHOUT ROWID: a chave já é o dia.
+bool DatabaseManager::criarAgregadoDiario()
+{
+    Consulta q(m_db);
+    executar(q, "criarAgregadoDiario", "SELECT 1 FROM sqlite_master WHERE name = 'agregado_diario'");
+    const bool existia = q.next();
+
+    bool ok = existia || executar(q, "criarAgregadoDiario",
+        "CREATE TABLE agregado_diario ("
+        "  dia            TEXT    PRIMARY KEY,"
+        "  total_centavos INTEGER NOT NULL DEFAULT 0,"
+        "  quantidade     INTEGER NOT NULL DEFAULT 0"
+        ") WITHOUT ROWID"
+    );
+    if (!ok) { qDebug() << "criarAgregadoDiario:" << q.lastError().text(); return false; }
+
+    const QString somar =
+        "INSERT INTO agregado_diario (dia, total_centavos, quantidade)"
+        " VALUES (new.data, new.valor_centavos, 1)"
+        " ON CONFLICT (dia) DO UPDATE SET"
+        "  total_centavos = total_centavos + excluded.total_centavos,"
+        "  quantidade     = quantidade + 1;";
+    const QString subtrair =
+        "UPDATE agregado_diario SET"
+        "  total_centavos = total_centavos - old.valor_centavos,"
+        "  quantidade     = quantidade - 1"
+        " WHERE dia = old.data;"
+        " DELETE FROM agregado_diario WHERE dia = old.data AND quantidade <= 0;";
+
+    for (const TipoLancamento tipo : {TipoLancamento::GastoFixo, TipoLancamento::GastoVariavel}) {
+        const QString tabela = tabelaDe(tipo);
+        ok = executar(q, "criarAgregadoDiario", QString("CREATE TRIGGER IF NOT EXISTS agregado_%1_ai"
+                                                        " AFTER INSERT ON %1 BEGIN %2 END").arg(tabela, somar))
+          && executar(q, "criarAgregadoDiario", QString("CREATE TRIGGER IF NOT EXISTS agregado_%1_ad"
+                                                        " AFTER DELETE ON %1 BEGIN %2 END").arg(tabela, subtrair))
+          && executar(q, "criarAgregadoDiario", QString("CREATE TRIGGER IF NOT EXISTS agregado_%1_au"
+                                                        " AFTER UPDATE OF data, valor_centavos ON %1"
+                                                        " BEGIN %2 %3 END").arg(tabela, subtrair, somar));
+        if (!ok) { qDebug() << "criarAgregadoDiario triggers:" << q.lastError().text(); return false; }
+    }
+
+    // Bancos anteriores ao calendário: agrega o que já existe
+    if (!existia) {
+        executar(q, "criarAgregadoDiario",
+            "INSERT INTO agregado_diario (dia, total_centavos, quantidade)"
+            " SELECT data, SUM(valor_centavos), COUNT(*) FROM ("
+            "   SELECT data, valor_centavos FROM gastos_fixos"
+            "   UNION ALL"
+            "   SELECT data, valor_centavos FROM gastos_variaveis"
+            " ) GROUP BY data");
+        for (const Parcelamento &p : listarParcelamentos())
+            if (!agregarParcelasNoDia(p, +1)) return false;
+    }
+    return true;
+}
+
+QList<GastoDiario> DatabaseManager::gastosPorDia(const Periodo &periodo)
+{
+    QList<GastoDiario> dias;
+    Consulta q(m_db);
+    q.setForwardOnly(true);
+    q.prepare("SELECT dia, total_centavos, quantidade FROM agregado_diario"
+              + condicaoPeriodo(periodo, "dia") + " ORDER BY dia");
+    vincularPeriodo(q, periodo);
+    if (!executar(q, "gastosPorDia")) {
+        qDebug() << "gastosPorDia:" << q.lastError().text();
+        return dias;
+    }
+    while (q.next()) {
+        GastoDiario g;
+        g.dia           = QDate::fromString(q.value(0).toString(), "yyyy-MM-dd");
+        g.totalCentavos = q.value(1).toLongLong();
+        g.quantidade    = q.value(2).toInt();
+        dias.append(g);
+    }
+    return dias;
+}
+
+QSet<int> DatabaseManager::buscarIds(TipoLancamento tipo, const QString &texto)
+{
+    QSet<int> ids;
+    const QStringList termos = texto.split(' ', Qt::SkipEmptyParts);
+    if (termos.isEmpty()) return ids;
+
+    Consulta q(m_db);
+    q.setForwardOnly(true);
+    if (m_buscaFts) {
+        // Cada termo vira uma frase entre aspas com prefixo: "termo"*
+        QStringList expressao;
+        for (QString termo : termos)
+            expressao << '"' + termo.replace('"', "\"\"") + "\"*";
+        q.prepare("SELECT rowid / 4 FROM busca WHERE busca MATCH :m AND rowid % 4 = :t");
+        q.bindValue(":m", expressao.join(' '));
+        q.bindValue(":t", int(tipo));
+    } else {
+        // Sem FTS5: LIKE por termo (sem ignorar acentos)
+        QStringList condicoes;
+        for (int i = 0; i < termos.size(); ++i)
+            condicoes << QString("%1 LIKE :t%2 ESCAPE '\\'").arg(colunaDescricao(tipo)).arg(i);
+        q.prepare("SELECT id FROM " + tabelaDe(tipo) + " WHERE " + condicoes.join(" AND "));
+        for (int i = 0; i < termos.size(); ++i) {
+            QString termo = termos.at(i);
+            termo.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+            q.bindValue(QString(":t%1").arg(i), '%' + termo + '%');
+        }
+    }
+
+    if (!executar(q, "buscarIds")) {
+        qDebug() << "buscarIds:" << q.lastError().text();
+        return ids;
+    }
+    while (q.next())
+        ids.insert(q.value(0).toInt());
+    return ids;
+}
+
 // ── Categorias ────────────────────────────────────────────────────────────────
 
 QList<Categoria> DatabaseManager::listarCategorias()
 {
     QList<Categoria> lista;
-    QSqlQuery q(m_db);
-    q.exec("SELECT id, nome FROM categorias ORDER BY nome");
+    Consulta q(m_db);
+    executar(q, "listarCategorias", "SELECT id, nome FROM categorias ORDER BY nome");
     while (q.next())
         lista.append({q.value(0).toInt(), q.value(1).toString()});
     return lista;
@@ -222,10 +863,10 @@ QList<Categoria> DatabaseManager::listarCategorias()
 
 bool DatabaseManager::inserirCategoria(Categoria &cat)
 {
-    QSqlQuery q(m_db);
+    Consulta q(m_db);
     q.prepare("INSERT INTO categorias (nome) VALUES (:nome)");
     q.bindValue(":nome", cat.nome);
-    if (!q.exec()) { qDebug() << "inserirCategoria:" << q.lastError().text(); return false; }
+    if (!executar(q, "inserirCategoria")) { qDebug() << "inserirCategoria:" << q.lastError().text(); return false; }
     cat.id = q.lastInsertId().toInt();
     salvarEEncriptar();
     return true;
@@ -233,21 +874,334 @@ bool DatabaseManager::inserirCategoria(Categoria &cat)
 
 bool DatabaseManager::removerCategoria(int id)
 {
-    QSqlQuery q(m_db);
+    // ON DELETE CASCADE remove os gastos — retira antes suas impressões. Tudo
+    // numa transação: se o DELETE falhar, o índice de duplicatas volta junto
+    // e continua batendo com as linhas gravadas.
+    const bool loteProprio = !m_emLote;
+    iniciarLote();
+    auto falhar = [&]() {
+        if (loteProprio) cancelarLote();
+        return false;
+    };
+
+    QList<Lancamento> removidos;
+    for (const TipoLancamento tipo : {TipoLancamento::GastoFixo, TipoLancamento::GastoVariavel}) {
+        Consulta sel(m_db);
+        sel.prepare("SELECT historico, valor_centavos, data, id FROM " + tabelaDe(tipo)
+                    + " WHERE categoria_id = :id");
+        sel.bindValue(":id", id);
+        if (!executar(sel, "removerCategoria")) { qDebug() << "removerCategoria:" << sel.lastError().text(); return falhar(); }
+        while (sel.next()) {
+            Lancamento l;
+            l.id            = sel.value(3).toInt();
+            l.tipo          = tipo;
+            l.descricao     = sel.value(0).toString();
+            l.valorCentavos = sel.value(1).toLongLong();
+            l.data          = QDate::fromString(sel.value(2).toString(), "yyyy-MM-dd");
+            l.categoriaId   = id;
+            if (!registrarImpressao(l, -1)) return falhar();
+            removidos.append(l);
+        }
+    }
+
+    // A cascata leva também os parcelamentos; os triggers não os veem
+    bool comParcelas = false;
+    for (const Parcelamento &p : listarParcelamentos()) {
+        if (p.categoriaId != id) continue;
+        if (!agregarParcelas(p, -1)) return falhar();
+        comParcelas = true;
+    }
+
+    Consulta q(m_db);
     q.prepare("DELETE FROM categorias WHERE id = :id");
     q.bindValue(":id", id);
-    if (!q.exec()) { qDebug() << "removerCategoria:" << q.lastError().text(); return false; }
+    if (!executar(q, "removerCategoria")) { qDebug() << "removerCategoria:" << q.lastError().text(); return falhar(); }
+    for (const Lancamento &l : std::as_const(removidos))
+        notificar({Mutacao::Operacao::Remocao, l, {}});
+    if (comParcelas) notificar({Mutacao::Operacao::Recarga, {}, {}});
+    compilarRegras();  // a cascata também leva as regras da categoria
+    m_orcamentos.remove(id);  // e o orçamento
+    return loteProprio ? concluirLote() : true;
+}
+
+// ── Regras de categorização ───────────────────────────────────────────────────
+
+QList<RegraCategoria> DatabaseManager::listarRegras()
+{
+    QList<RegraCategoria> lista;
+    Consulta q(m_db);
+    executar(q, "listarRegras",
+             "SELECT r.id, r.tipo, r.padrao, r.valor_min_centavos, r.valor_max_centavos,"
+             "       r.categoria_id, c.nome"
+             "  FROM regras_categoria r JOIN categorias c ON c.id = r.categoria_id"
+             " ORDER BY r.id");
+    while (q.next()) {
+        RegraCategoria r;
+        r.id               = q.value(0).toInt();
+        r.tipo             = RegraCategoria::Tipo(q.value(1).toInt());
+        r.padrao           = q.value(2).toString();
+        r.valorMinCentavos = q.value(3).toLongLong();
+        r.valorMaxCentavos = q.value(4).toLongLong();
+        r.categoriaId      = q.value(5).toInt();
+        r.categoriaNome    = q.value(6).toString();
+        lista.append(r);
+    }
+    return lista;
+}
+
+bool DatabaseManager::inserirRegra(RegraCategoria &regra)
+{
+    Consulta q(m_db);
+    q.prepare("INSERT INTO regras_categoria"
+              " (tipo, padrao, valor_min_centavos, valor_max_centavos, categoria_id)"
+              " VALUES (:t, :p, :min, :max, :c)");
+    q.bindValue(":t",   int(regra.tipo));
+    q.bindValue(":p",   regra.padrao);
+    q.bindValue(":min", regra.valorMinCentavos);
+    q.bindValue(":max", regra.valorMaxCentavos);
+    q.bindValue(":c",   regra.categoriaId);
+    if (!executar(q, "inserirRegra")) { qDebug() << "inserirRegra:" << q.lastError().text(); return false; }
+    regra.id = q.lastInsertId().toInt();
+    compilarRegras();
+    salvarEEncriptar();
+    return true;
+}
+
+bool DatabaseManager::removerRegra(int id)
+{
+    Consulta q(m_db);
+    q.prepare("DELETE FROM regras_categoria WHERE id = :id");
+    q.bindValue(":id", id);
+    if (!executar(q, "removerRegra")) { qDebug() << "removerRegra:" << q.lastError().text(); return false; }
+    compilarRegras();
     salvarEEncriptar();
     return true;
 }
 
+int DatabaseManager::categorizar(const QString &descricao, qint64 valorCentavos) const
+{
+    return m_regras.categorizar(descricao, valorCentavos);
+}
+
+void DatabaseManager::compilarRegras()
+{
+    m_regras.compilar(listarRegras());
+}
+
+// ── Orçamentos ────────────────────────────────────────────────────────────────
+
+void DatabaseManager::carregarOrcamentos()
+{
+    m_orcamentos.clear();
+    Consulta q(m_db);
+    executar(q, "carregarOrcamentos", "SELECT categoria_id, limite_centavos FROM orcamentos");
+    while (q.next())
+        m_orcamentos.insert(q.value(0).toInt(), q.value(1).toLongLong());
+}
+
+bool DatabaseManager::definirOrcamento(int categoriaId, qint64 limiteCentavos)
+{
+    Consulta q(m_db);
+    if (limiteCentavos > 0) {
+        q.prepare("INSERT INTO orcamentos (categoria_id, limite_centavos) VALUES (:c, :l)"
+                  " ON CONFLICT(categoria_id) DO UPDATE SET limite_centavos = excluded.limite_centavos");
+        q.bindValue(":l", limiteCentavos);
+    } else {
+        q.prepare("DELETE FROM orcamentos WHERE categoria_id = :c");
+    }
+    q.bindValue(":c", categoriaId);
+    if (!executar(q, "definirOrcamento")) { qDebug() << "definirOrcamento:" << q.lastError().text(); return false; }
+
+    if (limiteCentavos > 0) m_orcamentos.insert(categoriaId, limiteCentavos);
+    else                    m_orcamentos.remove(categoriaId);
+    salvarEEncriptar();
+    return true;
+}
+
+ConsumoOrcamento DatabaseManager::consumoOrcamento(int categoriaId, const QDate &mes) const
+{
+    return {m_orcamentos.value(categoriaId),
+            m_estatisticasCategoria.totalMes(categoriaId, mes)};
+}
+
+// ── Classificador ─────────────────────────────────────────────────────────────
+
+ClassificadorBayes::Palpite DatabaseManager::preverCategoria(const QString &descricao) const
+{
+    return m_classificador.prever(descricao);
+}
+
+int DatabaseManager::sugerirCategoria(const QString &descricao, qint64 valorCentavos) const
+{
+    if (const int porRegra = categorizar(descricao, valorCentavos); porRegra > 0)
+        return porRegra;
+    const ClassificadorBayes::Palpite palpite = m_classificador.prever(descricao);
+    return palpite.confianca >= ClassificadorBayes::CONFIANCA_MINIMA ? palpite.categoriaId : 0;
+}
+
+DetectorAnomalias::Avaliacao DatabaseManager::avaliarGasto(int categoriaId, const QString &descricao,
+                                                           qint64 valorCentavos, bool registrado) const
+{
+    return m_anomalias.avaliar(categoriaId, descricao, valorCentavos, registrado);
+}
+
+qint64 DatabaseManager::contarGastos()
+{
+    Consulta q(m_db);
+    executar(q, "contarGastos",
+             "SELECT (SELECT COUNT(*) FROM gastos_fixos) + (SELECT COUNT(*) FROM gastos_variaveis)"
+             "     + (SELECT COUNT(*) FROM parcelamentos)");
+    return q.next() ? q.value(0).toLongLong() : -1;
+}
+
+// Modelos gravados junto com os lançamentos no mesmo .enc (classificador,
+// estatísticas por categoria e detector de anomalias); só retreina se faltar um, mudar de formato ou
+// não bater com a contagem de gastos (ex.: banco anterior ao modelo)
+void DatabaseManager::carregarModelo()
+{
+    TRACE_SPAN("DatabaseManager::carregarModelo", "db");
+    const qint64 gastos = contarGastos();
+    Consulta q(m_db);
+    q.prepare("SELECT nome, versao, lancamentos, dados FROM modelos");
+    executar(q, "carregarModelo");
+
+    bool bayes = false, estatisticas = false, anomalias = false;
+    while (q.next()) {
+        if (q.value(2).toLongLong() != gastos) continue;
+        const QString nome = q.value(0).toString();
+        if (nome == "bayes_categorias")
+            bayes = q.value(1).toInt() == ClassificadorBayes::VERSAO
+                 && m_classificador.desserializar(q.value(3).toByteArray());
+        else if (nome == "estatisticas_categorias")
+            estatisticas = q.value(1).toInt() == EstatisticasCategoria::VERSAO
+                        && m_estatisticasCategoria.desserializar(q.value(3).toByteArray());
+        else if (nome == "anomalias")
+            anomalias = q.value(1).toInt() == DetectorAnomalias::VERSAO
+                     && m_anomalias.desserializar(q.value(3).toByteArray());
+    }
+    if (bayes && estatisticas && anomalias) {
+        m_modelosAlterados = 0;
+        return;
+    }
+    treinarModelo();
+}
+
+// Uma passada pelos gastos alimenta os três modelos; as parcelas, só as
+// estatísticas (ver agregarParcelas())
+void DatabaseManager::treinarModelo()
+{
+    TRACE_SPAN("DatabaseManager::treinarModelo", "db");
+    m_classificador.limpar();
+    m_estatisticasCategoria.limpar();
+    m_anomalias.limpar();
+
+    Consulta q(m_db);
+    q.setForwardOnly(true);
+    executar(q, "treinarModelo",
+             "SELECT historico, categoria_id, valor_centavos, data FROM gastos_fixos"
+             " UNION ALL SELECT historico, categoria_id, valor_centavos, data FROM gastos_variaveis");
+    while (q.next()) {
+        const QString historico   = q.value(0).toString();
+        const int     categoriaId = q.value(1).toInt();
+        const qint64  valor       = q.value(2).toLongLong();
+        m_classificador.aprender(historico, categoriaId, +1);
+        m_estatisticasCategoria.registrar(categoriaId,
+                                          QDate::fromString(q.value(3).toString(), "yyyy-MM-dd"),
+                                          valor, +1);
+        m_anomalias.registrar(categoriaId, historico, valor, +1);
+    }
+    for (const Parcelamento &p : listarParcelamentos())
+        for (int k = 0; k < p.quantidadeVigente(); ++k)
+            m_estatisticasCategoria.registrar(p.categoriaId, p.dataParcela(k), p.valorParcela(k), +1);
+    m_modelosAlterados = ModelosTodos;
+}
+
+// Só os modelos marcados são serializados e regravados; os demais recebem
+// apenas a contagem de gastos nova, para continuarem válidos em carregarModelo()
+bool DatabaseManager::persistirModelo()
+{
+    TRACE_SPAN("DatabaseManager::persistirModelo", "db");
+    const qint64 gastos = contarGastos();
+
+    Consulta q(m_db);
+    q.prepare("INSERT INTO modelos (nome, versao, lancamentos, dados)"
+              " VALUES (:n, :v, :l, :d)"
+              " ON CONFLICT(nome) DO UPDATE SET versao = excluded.versao,"
+              " lancamentos = excluded.lancamentos, dados = excluded.dados");
+    const auto gravar = [&](quint8 modelo, const char *nome, int versao, auto serializar) {
+        if (!(m_modelosAlterados & modelo)) return true;
+        q.bindValue(":n", QString::fromLatin1(nome));
+        q.bindValue(":v", versao);
+        q.bindValue(":l", gastos);
+        q.bindValue(":d", serializar());
+        if (!executar(q, "persistirModelo")) { qDebug() << "persistirModelo:" << q.lastError().text(); return false; }
+        return true;
+    };
+    if (!gravar(ModeloBayes, "bayes_categorias", ClassificadorBayes::VERSAO,
+                [this] { return m_classificador.serializar(); })
+        || !gravar(ModeloEstatisticas, "estatisticas_categorias", EstatisticasCategoria::VERSAO,
+                   [this] { return m_estatisticasCategoria.serializar(); })
+        || !gravar(ModeloAnomalias, "anomalias", DetectorAnomalias::VERSAO,
+                   [this] { return m_anomalias.serializar(); }))
+        return false;
+
+    Consulta contagem(m_db);
+    contagem.prepare("UPDATE modelos SET lancamentos = :l");
+    contagem.bindValue(":l", gastos);
+    if (!executar(contagem, "persistirModelo")) { qDebug() << "persistirModelo:" << contagem.lastError().text(); return false; }
+    m_modelosAlterados = 0;
+    return true;
+}
+
+// Incremental: cada mutação soma ou subtrai os tokens do lançamento e o seu
+// valor no sketch da categoria e do mês e nas médias do detector de anomalias
+void DatabaseManager::aprender(const Mutacao &m)
+{
+    const auto treinavel = [](const Lancamento &l) { return l.tipo != TipoLancamento::Entrada; };
+    const auto registrar = [this](const Lancamento &l, int delta) {
+        m_estatisticasCategoria.registrar(l.categoriaId, l.data, l.valorCentavos, delta);
+        m_anomalias.registrar(l.categoriaId, l.descricao, l.valorCentavos, delta);
+    };
+
+    switch (m.operacao) {
+    case Mutacao::Operacao::Insercao:
+        if (!treinavel(m.depois)) return;
+        m_classificador.aprender(m.depois.descricao, m.depois.categoriaId, +1);
+        registrar(m.depois, +1);
+        m_modelosAlterados |= ModelosTodos;
+        break;
+    case Mutacao::Operacao::Atualizacao:
+        if (!treinavel(m.depois)) return;
+        registrar(m.antes,  -1);
+        registrar(m.depois, +1);
+        m_modelosAlterados |= ModeloEstatisticas | ModeloAnomalias;
+        if (m.antes.descricao == m.depois.descricao && m.antes.categoriaId == m.depois.categoriaId)
+            break;  // só valor ou data: o classificador não muda
+        m_classificador.aprender(m.antes.descricao,  m.antes.categoriaId,  -1);
+        m_classificador.aprender(m.depois.descricao, m.depois.categoriaId, +1);
+        m_modelosAlterados |= ModeloBayes;
+        break;
+    case Mutacao::Operacao::Remocao:
+        if (!treinavel(m.antes)) return;
+        m_classificador.aprender(m.antes.descricao, m.antes.categoriaId, -1);
+        registrar(m.antes, -1);
+        m_modelosAlterados |= ModelosTodos;
+        break;
+    case Mutacao::Operacao::Recarga:
+        return;  // quem emite já recarregou ou treinou o modelo
+    }
+}
+
 // ── Entradas ──────────────────────────────────────────────────────────────────
 
-QList<Entrada> DatabaseManager::listarEntradas()
+QList<Entrada> DatabaseManager::listarEntradas(const Periodo &periodo)
 {
     QList<Entrada> lista;
-    QSqlQuery q(m_db);
-    q.exec("SELECT id, origem, valor_centavos, data FROM entradas ORDER BY data DESC");
+    Consulta q(m_db);
+    q.prepare("SELECT id, origem, valor_centavos, data FROM entradas"
+              + condicaoPeriodo(periodo, "data") + " ORDER BY data DESC");
+    vincularPeriodo(q, periodo);
+    executar(q, "listarEntradas");
     while (q.next()) {
         Entrada e;
         e.id            = q.value(0).toInt();
@@ -261,60 +1215,83 @@ QList<Entrada> DatabaseManager::listarEntradas()
 
 bool DatabaseManager::inserirEntrada(Entrada &entrada)
 {
-    QSqlQuery q(m_db);
+    Consulta q(m_db);
     q.prepare("INSERT INTO entradas (origem, valor_centavos, data) VALUES (:o, :v, :d)");
     q.bindValue(":o", entrada.origem);
     q.bindValue(":v", entrada.valorCentavos);
     q.bindValue(":d", entrada.data.toString("yyyy-MM-dd"));
-    if (!q.exec()) { qDebug() << "inserirEntrada:" << q.lastError().text(); return false; }
+    if (!executar(q, "inserirEntrada")) { qDebug() << "inserirEntrada:" << q.lastError().text(); return false; }
     entrada.id = q.lastInsertId().toInt();
+    const Lancamento depois{entrada.id, TipoLancamento::Entrada, entrada.origem,
+                            entrada.valorCentavos, entrada.data, 0};
+    registrarImpressao(depois, +1);
+    notificar({Mutacao::Operacao::Insercao, {}, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::atualizarEntrada(const Entrada &entrada)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::Entrada, entrada.id, antes);
+
+    Consulta q(m_db);
     q.prepare("UPDATE entradas SET origem=:o, valor_centavos=:v, data=:d WHERE id=:id");
     q.bindValue(":o",  entrada.origem);
     q.bindValue(":v",  entrada.valorCentavos);
     q.bindValue(":d",  entrada.data.toString("yyyy-MM-dd"));
     q.bindValue(":id", entrada.id);
-    if (!q.exec()) { qDebug() << "atualizarEntrada:" << q.lastError().text(); return false; }
+    if (!executar(q, "atualizarEntrada")) { qDebug() << "atualizarEntrada:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    const Lancamento depois{entrada.id, TipoLancamento::Entrada, entrada.origem,
+                            entrada.valorCentavos, entrada.data, 0};
+    registrarImpressao(depois, +1);
+    notificar({existia ? Mutacao::Operacao::Atualizacao : Mutacao::Operacao::Insercao,
+               antes, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::removerEntrada(int id)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::Entrada, id, antes);
+
+    Consulta q(m_db);
     q.prepare("DELETE FROM entradas WHERE id=:id");
     q.bindValue(":id", id);
-    if (!q.exec()) { qDebug() << "removerEntrada:" << q.lastError().text(); return false; }
+    if (!executar(q, "removerEntrada")) { qDebug() << "removerEntrada:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    if (existia) notificar({Mutacao::Operacao::Remocao, antes, {}});
     salvarEEncriptar();
     return true;
 }
 
-qint64 DatabaseManager::totalEntradas()
+qint64 DatabaseManager::totalEntradas(const Periodo &periodo)
 {
-    QSqlQuery q(m_db);
-    q.exec("SELECT COALESCE(SUM(valor_centavos),0) FROM entradas");
+    Consulta q(m_db);
+    q.prepare("SELECT COALESCE(SUM(valor_centavos),0) FROM entradas" + condicaoPeriodo(periodo, "data"));
+    vincularPeriodo(q, periodo);
+    executar(q, "totalEntradas");
     return q.next() ? q.value(0).toLongLong() : 0;
 }
 
 // ── Gastos Fixos ──────────────────────────────────────────────────────────────
 
-QList<GastoFixo> DatabaseManager::listarGastosFixos()
+QList<GastoFixo> DatabaseManager::listarGastosFixos(const Periodo &periodo)
 {
     QList<GastoFixo> lista;
-    QSqlQuery q(m_db);
-    q.exec(
+    Consulta q(m_db);
+    q.prepare(
         "SELECT gf.id, gf.historico, gf.valor_centavos, gf.data,"
         "       gf.categoria_id, c.nome"
         " FROM gastos_fixos gf"
         " JOIN categorias c ON gf.categoria_id = c.id"
-        " ORDER BY gf.data DESC"
+        + condicaoPeriodo(periodo, "gf.data")
+        + " ORDER BY gf.data DESC"
     );
+    vincularPeriodo(q, periodo);
+    executar(q, "listarGastosFixos");
     while (q.next()) {
         GastoFixo g;
         g.id            = q.value(0).toInt();
@@ -330,22 +1307,29 @@ QList<GastoFixo> DatabaseManager::listarGastosFixos()
 
 bool DatabaseManager::inserirGastoFixo(GastoFixo &gasto)
 {
-    QSqlQuery q(m_db);
+    Consulta q(m_db);
     q.prepare("INSERT INTO gastos_fixos (historico,valor_centavos,data,categoria_id)"
               " VALUES (:h,:v,:d,:c)");
     q.bindValue(":h", gasto.historico);
     q.bindValue(":v", gasto.valorCentavos);
     q.bindValue(":d", gasto.data.toString("yyyy-MM-dd"));
     q.bindValue(":c", gasto.categoriaId);
-    if (!q.exec()) { qDebug() << "inserirGastoFixo:" << q.lastError().text(); return false; }
+    if (!executar(q, "inserirGastoFixo")) { qDebug() << "inserirGastoFixo:" << q.lastError().text(); return false; }
     gasto.id = q.lastInsertId().toInt();
+    const Lancamento depois{gasto.id, TipoLancamento::GastoFixo, gasto.historico,
+                            gasto.valorCentavos, gasto.data, gasto.categoriaId};
+    registrarImpressao(depois, +1);
+    notificar({Mutacao::Operacao::Insercao, {}, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::atualizarGastoFixo(const GastoFixo &gasto)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::GastoFixo, gasto.id, antes);
+
+    Consulta q(m_db);
     q.prepare("UPDATE gastos_fixos SET historico=:h,valor_centavos=:v,data=:d,categoria_id=:c"
               " WHERE id=:id");
     q.bindValue(":h",  gasto.historico);
@@ -353,41 +1337,203 @@ bool DatabaseManager::atualizarGastoFixo(const GastoFixo &gasto)
     q.bindValue(":d",  gasto.data.toString("yyyy-MM-dd"));
     q.bindValue(":c",  gasto.categoriaId);
     q.bindValue(":id", gasto.id);
-    if (!q.exec()) { qDebug() << "atualizarGastoFixo:" << q.lastError().text(); return false; }
+    if (!executar(q, "atualizarGastoFixo")) { qDebug() << "atualizarGastoFixo:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    const Lancamento depois{gasto.id, TipoLancamento::GastoFixo, gasto.historico,
+                            gasto.valorCentavos, gasto.data, gasto.categoriaId};
+    registrarImpressao(depois, +1);
+    notificar({existia ? Mutacao::Operacao::Atualizacao : Mutacao::Operacao::Insercao,
+               antes, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::removerGastoFixo(int id)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::GastoFixo, id, antes);
+
+    Consulta q(m_db);
     q.prepare("DELETE FROM gastos_fixos WHERE id=:id");
     q.bindValue(":id", id);
-    if (!q.exec()) { qDebug() << "removerGastoFixo:" << q.lastError().text(); return false; }
+    if (!executar(q, "removerGastoFixo")) { qDebug() << "removerGastoFixo:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    if (existia) notificar({Mutacao::Operacao::Remocao, antes, {}});
     salvarEEncriptar();
     return true;
 }
 
-qint64 DatabaseManager::totalGastosFixos()
+qint64 DatabaseManager::totalGastosFixos(const Periodo &periodo)
 {
-    QSqlQuery q(m_db);
-    q.exec("SELECT COALESCE(SUM(valor_centavos),0) FROM gastos_fixos");
+    Consulta q(m_db);
+    q.prepare("SELECT COALESCE(SUM(valor_centavos),0) FROM gastos_fixos" + condicaoPeriodo(periodo, "data"));
+    vincularPeriodo(q, periodo);
+    executar(q, "totalGastosFixos");
     return q.next() ? q.value(0).toLongLong() : 0;
 }
 
+// ── Recorrências ──────────────────────────────────────────────────────────────
+
+QList<Recorrencia> DatabaseManager::listarRecorrencias()
+{
+    QList<Recorrencia> lista;
+    Consulta q(m_db);
+    executar(q, "listarRecorrencias",
+        "SELECT r.id, r.historico, r.valor_centavos, r.dia, r.categoria_id, c.nome,"
+        "       r.inicio, r.fim"
+        " FROM recorrencias r"
+        " JOIN categorias c ON r.categoria_id = c.id"
+        " ORDER BY r.dia, r.historico");
+    while (q.next()) {
+        Recorrencia r;
+        r.id            = q.value(0).toInt();
+        r.historico     = q.value(1).toString();
+        r.valorCentavos = q.value(2).toLongLong();
+        r.dia           = q.value(3).toInt();
+        r.categoriaId   = q.value(4).toInt();
+        r.categoriaNome = q.value(5).toString();
+        r.inicio        = QDate::fromString(q.value(6).toString(), "yyyy-MM-dd");
+        r.fim           = QDate::fromString(q.value(7).toString(), "yyyy-MM-dd");  // NULL → inválida
+        lista.append(r);
+    }
+    return lista;
+}
+
+bool DatabaseManager::inserirRecorrencia(Recorrencia &recorrencia)
+{
+    Consulta q(m_db);
+    q.prepare("INSERT INTO recorrencias (historico,valor_centavos,dia,categoria_id,inicio,fim)"
+              " VALUES (:h,:v,:dia,:c,:ini,:fim)");
+    q.bindValue(":h",   recorrencia.historico);
+    q.bindValue(":v",   recorrencia.valorCentavos);
+    q.bindValue(":dia", recorrencia.dia);
+    q.bindValue(":c",   recorrencia.categoriaId);
+    q.bindValue(":ini", recorrencia.inicio.toString("yyyy-MM-dd"));
+    q.bindValue(":fim", recorrencia.fim.isValid() ? QVariant(recorrencia.fim.toString("yyyy-MM-dd"))
+                                                  : QVariant());
+    if (!executar(q, "inserirRecorrencia")) { qDebug() << "inserirRecorrencia:" << q.lastError().text(); return false; }
+    recorrencia.id = q.lastInsertId().toInt();
+    salvarEEncriptar();
+    return true;
+}
+
+bool DatabaseManager::atualizarRecorrencia(const Recorrencia &recorrencia)
+{
+    Consulta q(m_db);
+    q.prepare("UPDATE recorrencias SET historico=:h,valor_centavos=:v,dia=:dia,categoria_id=:c,"
+              "inicio=:ini,fim=:fim WHERE id=:id");
+    q.bindValue(":h",   recorrencia.historico);
+    q.bindValue(":v",   recorrencia.valorCentavos);
+    q.bindValue(":dia", recorrencia.dia);
+    q.bindValue(":c",   recorrencia.categoriaId);
+    q.bindValue(":ini", recorrencia.inicio.toString("yyyy-MM-dd"));
+    q.bindValue(":fim", recorrencia.fim.isValid() ? QVariant(recorrencia.fim.toString("yyyy-MM-dd"))
+                                                  : QVariant());
+    q.bindValue(":id",  recorrencia.id);
+    if (!executar(q, "atualizarRecorrencia")) { qDebug() << "atualizarRecorrencia:" << q.lastError().text(); return false; }
+    salvarEEncriptar();
+    return true;
+}
+
+// Os gastos já confirmados ficam; só as marcações somem (cascata)
+bool DatabaseManager::removerRecorrencia(int id)
+{
+    Consulta q(m_db);
+    q.prepare("DELETE FROM recorrencias WHERE id = :id");
+    q.bindValue(":id", id);
+    if (!executar(q, "removerRecorrencia")) { qDebug() << "removerRecorrencia:" << q.lastError().text(); return false; }
+    salvarEEncriptar();
+    return true;
+}
+
+// Expansão preguiçosa: as regras (dezenas) × meses do período, menos as
+// ocorrências já resolvidas nesses meses — nada é gravado
+QList<Ocorrencia> DatabaseManager::listarOcorrenciasPendentes(const Periodo &periodo)
+{
+    TRACE_SPAN("DatabaseManager::listarOcorrenciasPendentes", "db");
+    const QList<Recorrencia> recorrencias = listarRecorrencias();
+    if (recorrencias.isEmpty()) return {};
+
+    // Sem início ("Tudo"), só o mês do fim: expandir desde a regra mais antiga
+    // custaria um mês por regra para cada mês de histórico. Pendências
+    // anteriores aparecem ao selecionar o mês delas.
+    const QDate ate = ateMesCorrente(periodo).fim;
+    const QDate de  = periodo.inicio.isValid() ? periodo.inicio : QDate(ate.year(), ate.month(), 1);
+    if (de > ate) return {};
+
+    QSet<QPair<int, QString>> resolvidas;
+    Consulta q(m_db);
+    q.prepare("SELECT recorrencia_id, mes FROM ocorrencias_recorrencia"
+              " WHERE mes >= :ini AND mes <= :fim");
+    q.bindValue(":ini", de.toString("yyyy-MM"));
+    q.bindValue(":fim", ate.toString("yyyy-MM"));
+    executar(q, "listarOcorrenciasPendentes");
+    while (q.next())
+        resolvidas.insert({q.value(0).toInt(), q.value(1).toString()});
+
+    QList<Ocorrencia> lista;
+    for (const Recorrencia &r : recorrencias) {
+        for (const QDate &data : r.datasEntre(de, ate)) {
+            if (resolvidas.contains({r.id, data.toString("yyyy-MM")})) continue;
+            lista.append({r.id, data, r.historico, r.valorCentavos, r.categoriaId, r.categoriaNome});
+        }
+    }
+    std::sort(lista.begin(), lista.end(), [](const Ocorrencia &a, const Ocorrencia &b) {
+        return a.data > b.data;  // como listarGastosFixos
+    });
+    return lista;
+}
+
+bool DatabaseManager::marcarOcorrencia(const Ocorrencia &ocorrencia, int gastoId)
+{
+    Consulta q(m_db);
+    q.prepare("INSERT OR REPLACE INTO ocorrencias_recorrencia (recorrencia_id, mes, gasto_id)"
+              " VALUES (:r, :m, :g)");
+    q.bindValue(":r", ocorrencia.recorrenciaId);
+    q.bindValue(":m", ocorrencia.data.toString("yyyy-MM"));
+    q.bindValue(":g", gastoId > 0 ? QVariant(gastoId) : QVariant());
+    if (!executar(q, "marcarOcorrencia")) { qDebug() << "marcarOcorrencia:" << q.lastError().text(); return false; }
+    return true;
+}
+
+// Gasto fixo e marcação na mesma transação: ou os dois, ou nenhum
+bool DatabaseManager::confirmarOcorrencia(const Ocorrencia &ocorrencia, GastoFixo &gerado)
+{
+    gerado = {0, ocorrencia.historico, ocorrencia.valorCentavos, ocorrencia.data,
+              ocorrencia.categoriaId, ocorrencia.categoriaNome};
+
+    const bool loteProprio = !m_emLote;
+    iniciarLote();
+    if (!inserirGastoFixo(gerado) || !marcarOcorrencia(ocorrencia, gerado.id)) {
+        if (loteProprio) cancelarLote();
+        return false;
+    }
+    return loteProprio ? concluirLote() : true;
+}
+
+bool DatabaseManager::dispensarOcorrencia(const Ocorrencia &ocorrencia)
+{
+    if (!marcarOcorrencia(ocorrencia, 0)) return false;
+    salvarEEncriptar();
+    return true;
+}
+
 // ── Gastos Variáveis ──────────────────────────────────────────────────────────
 
-QList<GastoVariavel> DatabaseManager::listarGastosVariaveis()
+QList<GastoVariavel> DatabaseManager::listarGastosVariaveis(const Periodo &periodo)
 {
     QList<GastoVariavel> lista;
-    QSqlQuery q(m_db);
-    q.exec(
+    Consulta q(m_db);
+    q.prepare(
         "SELECT gv.id, gv.historico, gv.valor_centavos, gv.data,"
         "       gv.categoria_id, c.nome"
         " FROM gastos_variaveis gv"
         " JOIN categorias c ON gv.categoria_id = c.id"
-        " ORDER BY gv.data DESC"
+        + condicaoPeriodo(periodo, "gv.data")
+        + " ORDER BY gv.data DESC"
     );
+    vincularPeriodo(q, periodo);
+    executar(q, "listarGastosVariaveis");
     while (q.next()) {
         GastoVariavel g;
         g.id            = q.value(0).toInt();
@@ -403,22 +1549,29 @@ QList<GastoVariavel> DatabaseManager::listarGastosVariaveis()
 
 bool DatabaseManager::inserirGastoVariavel(GastoVariavel &gasto)
 {
-    QSqlQuery q(m_db);
+    Consulta q(m_db);
     q.prepare("INSERT INTO gastos_variaveis (historico,valor_centavos,data,categoria_id)"
               " VALUES (:h,:v,:d,:c)");
     q.bindValue(":h", gasto.historico);
     q.bindValue(":v", gasto.valorCentavos);
     q.bindValue(":d", gasto.data.toString("yyyy-MM-dd"));
     q.bindValue(":c", gasto.categoriaId);
-    if (!q.exec()) { qDebug() << "inserirGastoVariavel:" << q.lastError().text(); return false; }
+    if (!executar(q, "inserirGastoVariavel")) { qDebug() << "inserirGastoVariavel:" << q.lastError().text(); return false; }
     gasto.id = q.lastInsertId().toInt();
+    const Lancamento depois{gasto.id, TipoLancamento::GastoVariavel, gasto.historico,
+                            gasto.valorCentavos, gasto.data, gasto.categoriaId};
+    registrarImpressao(depois, +1);
+    notificar({Mutacao::Operacao::Insercao, {}, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::atualizarGastoVariavel(const GastoVariavel &gasto)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::GastoVariavel, gasto.id, antes);
+
+    Consulta q(m_db);
     q.prepare("UPDATE gastos_variaveis SET historico=:h,valor_centavos=:v,data=:d,categoria_id=:c"
               " WHERE id=:id");
     q.bindValue(":h",  gasto.historico);
@@ -426,24 +1579,537 @@ bool DatabaseManager::atualizarGastoVariavel(const GastoVariavel &gasto)
     q.bindValue(":d",  gasto.data.toString("yyyy-MM-dd"));
     q.bindValue(":c",  gasto.categoriaId);
     q.bindValue(":id", gasto.id);
-    if (!q.exec()) { qDebug() << "atualizarGastoVariavel:" << q.lastError().text(); return false; }
+    if (!executar(q, "atualizarGastoVariavel")) { qDebug() << "atualizarGastoVariavel:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    const Lancamento depois{gasto.id, TipoLancamento::GastoVariavel, gasto.historico,
+                            gasto.valorCentavos, gasto.data, gasto.categoriaId};
+    registrarImpressao(depois, +1);
+    notificar({existia ? Mutacao::Operacao::Atualizacao : Mutacao::Operacao::Insercao,
+               antes, depois});
     salvarEEncriptar();
     return true;
 }
 
 bool DatabaseManager::removerGastoVariavel(int id)
 {
-    QSqlQuery q(m_db);
+    Lancamento antes;
+    const bool existia = lerLancamento(TipoLancamento::GastoVariavel, id, antes);
+
+    Consulta q(m_db);
     q.prepare("DELETE FROM gastos_variaveis WHERE id=:id");
     q.bindValue(":id", id);
-    if (!q.exec()) { qDebug() << "removerGastoVariavel:" << q.lastError().text(); return false; }
+    if (!executar(q, "removerGastoVariavel")) { qDebug() << "removerGastoVariavel:" << q.lastError().text(); return false; }
+    if (existia) registrarImpressao(antes, -1);
+    if (existia) notificar({Mutacao::Operacao::Remocao, antes, {}});
     salvarEEncriptar();
     return true;
 }
 
-qint64 DatabaseManager::totalGastosVariaveis()
+qint64 DatabaseManager::totalGastosVariaveis(const Periodo &periodo)
 {
-    QSqlQuery q(m_db);
-    q.exec("SELECT COALESCE(SUM(valor_centavos),0) FROM gastos_variaveis");
+    Consulta q(m_db);
+    q.prepare("SELECT COALESCE(SUM(valor_centavos),0) FROM gastos_variaveis"
+              + condicaoPeriodo(periodo, "data"));
+    vincularPeriodo(q, periodo);
+    executar(q, "totalGastosVariaveis");
     return q.next() ? q.value(0).toLongLong() : 0;
 }
+
+// ── Parcelamentos ─────────────────────────────────────────────────────────────
+
+static const char *const SELECAO_PARCELAMENTO =
+    "SELECT p.id, p.historico, p.total_centavos, p.parcelas, p.primeira_data,"
+    "       p.ultima_data, p.categoria_id, c.nome"
+    " FROM parcelamentos p"
+    " JOIN categorias c ON p.categoria_id = c.id";
+
+// ultima_data guarda o fim efetivo: a última parcela, ou a anterior ao
+// encerramento — daí as vigentes
+static Parcelamento lerParcelamentoDe(const QSqlQuery &q)
+{
+    Parcelamento p;
+    p.id            = q.value(0).toInt();
+    p.historico     = q.value(1).toString();
+    p.totalCentavos = q.value(2).toLongLong();
+    p.parcelas      = q.value(3).toInt();
+    p.primeiraData  = QDate::fromString(q.value(4).toString(), "yyyy-MM-dd");
+    p.vigentes      = Parcelamento::mesesEntre(p.primeiraData,
+                          QDate::fromString(q.value(5).toString(), "yyyy-MM-dd")) + 1;
+    p.categoriaId   = q.value(6).toInt();
+    p.categoriaNome = q.value(7).toString();
+    return p;
+}
+
+QList<Parcelamento> DatabaseManager::listarParcelamentos(const Periodo &periodo)
+{
+    QList<Parcelamento> lista;
+    Consulta q(m_db);
+    q.prepare(SELECAO_PARCELAMENTO + condicaoVigencia(periodo) + " ORDER BY p.primeira_data DESC");
+    vincularPeriodo(q, periodo);
+    executar(q, "listarParcelamentos");
+    while (q.next())
+        lista.append(lerParcelamentoDe(q));
+    return lista;
+}
+
+bool DatabaseManager::lerParcelamento(int id, Parcelamento &parcelamento)
+{
+    Consulta q(m_db);
+    q.prepare(SELECAO_PARCELAMENTO + QString(" WHERE p.id = :id"));
+    q.bindValue(":id", id);
+    if (!executar(q, "lerParcelamento") || !q.next()) return false;
+    parcelamento = lerParcelamentoDe(q);
+    return true;
+}
+
+bool DatabaseManager::inserirParcelamento(Parcelamento &parcelamento)
+{
+    const bool loteProprio = !m_emLote;
+    iniciarLote();
+
+    Consulta q(m_db);
+    q.prepare("INSERT INTO parcelamentos"
+              " (historico,total_centavos,parcelas,primeira_data,ultima_data,categoria_id)"
+              " VALUES (:h,:t,:n,:pri,:ult,:c)");
+    q.bindValue(":h",   parcelamento.historico);
+    q.bindValue(":t",   parcelamento.totalCentavos);
+    q.bindValue(":n",   parcelamento.parcelas);
+    q.bindValue(":pri", parcelamento.primeiraData.toString("yyyy-MM-dd"));
+    q.bindValue(":ult", parcelamento.ultimaData().toString("yyyy-MM-dd"));
+    q.bindValue(":c",   parcelamento.categoriaId);
+    if (!executar(q, "inserirParcelamento")) {
+        qDebug() << "inserirParcelamento:" << q.lastError().text();
+        if (loteProprio) cancelarLote();
+        return false;
+    }
+    parcelamento.id = q.lastInsertId().toInt();
+    if (!agregarParcelas(parcelamento, +1)) {
+        if (loteProprio) cancelarLote();
+        return false;
+    }
+    notificar({Mutacao::Operacao::Recarga, {}, {}});  // cache analítico relê as parcelas
+    return loteProprio ? concluirLote() : true;
+}
+
+// Edição e encerramento: sai o plano antigo das agregações, entra o novo
+bool DatabaseManager::atualizarParcelamento(const Parcelamento &parcelamento)
+{
+    Parcelamento antigo;
+    if (!lerParcelamento(parcelamento.id, antigo)) return false;
+
+    const bool loteProprio = !m_emLote;
+    iniciarLote();
+    auto falhar = [&]() {
+        if (loteProprio) cancelarLote();
+        return false;
+    };
+
+    Consulta q(m_db);
+    q.prepare("UPDATE parcelamentos SET historico=:h, total_centavos=:t, parcelas=:n,"
+              " primeira_data=:pri, ultima_data=:ult, categoria_id=:c WHERE id=:id");
+    q.bindValue(":h",   parcelamento.historico);
+    q.bindValue(":t",   parcelamento.totalCentavos);
+    q.bindValue(":n",   parcelamento.parcelas);
+    q.bindValue(":pri", parcelamento.primeiraData.toString("yyyy-MM-dd"));
+    q.bindValue(":ult", parcelamento.ultimaData().toString("yyyy-MM-dd"));
+    q.bindValue(":c",   parcelamento.categoriaId);
+    q.bindValue(":id",  parcelamento.id);
+    if (!executar(q, "atualizarParcelamento")) { qDebug() << "atualizarParcelamento:" << q.lastError().text(); return falhar(); }
+    if (!agregarParcelas(antigo, -1) || !agregarParcelas(parcelamento, +1)) return falhar();
+    notificar({Mutacao::Operacao::Recarga, {}, {}});
+    return loteProprio ? concluirLote() : true;
+}
+
+bool DatabaseManager::removerParcelamento(int id)
+{
+    Parcelamento antigo;
+    if (!lerParcelamento(id, antigo)) return false;
+
+    const bool loteProprio = !m_emLote;
+    iniciarLote();
+    auto falhar = [&]() {
+        if (loteProprio) cancelarLote();
+        return false;
+    };
+
+    Consulta q(m_db);
+    q.prepare("DELETE FROM parcelamentos WHERE id = :id");
+    q.bindValue(":id", id);
+    if (!executar(q, "removerParcelamento")) { qDebug() << "removerParcelamento:" << q.lastError().text(); return falhar(); }
+    if (!agregarParcelas(antigo, -1)) return falhar();
+    notificar({Mutacao::Operacao::Recarga, {}, {}});
+    return loteProprio ? concluirLote() : true;
+}
+
+// Parcelas entram nas mesmas agregações dos gastos: agregado_diario
+// (calendário) e estatísticas por categoria (quantis e orçamentos); o cache
+// analítico as lê em carregarAnalitico(). Classificador e detector de
+// anomalias ficam de fora — o histórico de uma parcela não foi digitado.
+bool DatabaseManager::agregarParcelas(const Parcelamento &p, int delta)
+{
+    if (!agregarParcelasNoDia(p, delta)) return false;
+    for (int k = 0; k < p.quantidadeVigente(); ++k)
+        m_estatisticasCategoria.registrar(p.categoriaId, p.dataParcela(k), p.valorParcela(k), delta);
+    m_modelosAlterados |= ModeloEstatisticas;  // classificador e detector não as veem
+    return true;
+}
+
+// Como os triggers de gastos_fixos/gastos_variaveis: uma linha por parcela
+bool DatabaseManager::agregarParcelasNoDia(const Parcelamento &p, int delta)
+{
+    Consulta q(m_db);
+    q.prepare("INSERT INTO agregado_diario (dia, total_centavos, quantidade)"
+              " VALUES (:d, :v, :n)"
+              " ON CONFLICT (dia) DO UPDATE SET"
+              "  total_centavos = total_centavos + excluded.total_centavos,"
+              "  quantidade     = quantidade + excluded.quantidade");
+    for (int k = 0; k < p.quantidadeVigente(); ++k) {
+        q.bindValue(":d", p.dataParcela(k).toString("yyyy-MM-dd"));
+        q.bindValue(":v", delta * p.valorParcela(k));
+        q.bindValue(":n", delta);
+        if (!executar(q, "agregarParcelas")) { qDebug() << "agregarParcelas:" << q.lastError().text(); return false; }
+    }
+    if (delta > 0) return true;
+
+    q.prepare("DELETE FROM agregado_diario WHERE dia BETWEEN :pri AND :ult AND quantidade <= 0");
+    q.bindValue(":pri", p.primeiraData.toString("yyyy-MM-dd"));
+    q.bindValue(":ult", p.ultimaData().toString("yyyy-MM-dd"));
+    if (!executar(q, "agregarParcelas")) { qDebug() << "agregarParcelas:" << q.lastError().text(); return false; }
+    return true;
+}
+
+// Sem corte no mês corrente: o período inteiro, como as agregações
+QList<Parcela> DatabaseManager::listarParcelas(const Periodo &periodo)
+{
+    TRACE_SPAN("DatabaseManager::listarParcelas", "db");
+    QList<Parcela> lista;
+    for (const Parcelamento &p : listarParcelamentos(periodo)) {
+        int de = 0, ate = -1;
+        p.parcelasEntre(periodo.inicio, periodo.fim, de, ate);
+        for (int k = de; k <= ate; ++k)
+            lista.append({p.id, k + 1, p.parcelas, p.dataParcela(k), p.historico,
+                          p.valorParcela(k), p.categoriaId, p.categoriaNome});
+    }
+    std::sort(lista.begin(), lista.end(), [](const Parcela &a, const Parcela &b) {
+        return a.data > b.data;  // como listarGastosVariaveis
+    });
+    return lista;
+}
+
+// Uma soma em forma fechada por plano vigente — sem gerar as parcelas
+qint64 DatabaseManager::totalParcelas(const Periodo &periodo)
+{
+    qint64 total = 0;
+    for (const Parcelamento &p : listarParcelamentos(periodo)) {
+        int de = 0, ate = -1;
+        p.parcelasEntre(periodo.inicio, periodo.fim, de, ate);
+        total += p.somaParcelas(de, ate);
+    }
+    return total;
+}
+
+qint64 DatabaseManager::parcelasAVencer(const QDate &depoisDe)
+{
+    Periodo futuro;
+    futuro.inicio = depoisDe.addDays(1);
+    qint64 total = 0;
+    for (const Parcelamento &p : listarParcelamentos(futuro)) {
+        int de = 0, ate = -1;
+        p.parcelasEntre(futuro.inicio, {}, de, ate);
+        total += p.somaParcelas(de, ate);
+    }
+    return total;
+}
+
+// ── Carga em massa ────────────────────────────────────────────────────────────
+
+bool DatabaseManager::inserirLancamentos(const QList<Lancamento> &lancamentos)
+{
+    if (lancamentos.isEmpty()) return true;
+
+    Tracer::Span span("DatabaseManager::inserirLancamentos", "db");
+    span.arg("linhas", lancamentos.size());
+
+    const bool transacaoPropria = !m_emLote;
+    if (transacaoPropria) m_db.transaction();
+
+    auto falhar = [&](const QSqlQuery &q) {
+        qDebug() << "inserirLancamentos:" << q.lastError().text();
+        if (transacaoPropria) m_db.rollback();  // em lote, quem chamou decide cancelar
+        return false;
+    };
+
+    QSqlQuery insEntrada(m_db), insFixo(m_db), insVariavel(m_db);
+    insEntrada.prepare("INSERT INTO entradas (origem,valor_centavos,data) VALUES (?,?,?)");
+    insFixo.prepare("INSERT INTO gastos_fixos (historico,valor_centavos,data,categoria_id)"
+                    " VALUES (?,?,?,?)");
+    insVariavel.prepare("INSERT INTO gastos_variaveis (historico,valor_centavos,data,categoria_id)"
+                        " VALUES (?,?,?,?)");
+
+    // hash → ocorrências no bloco; o índice recebe um UPSERT por hash distinto
+    QHash<quint64, int> impressoes;
+    impressoes.reserve(lancamentos.size());
+
+    for (const Lancamento &l : lancamentos) {
+        QSqlQuery &q = l.tipo == TipoLancamento::Entrada   ? insEntrada
+                     : l.tipo == TipoLancamento::GastoFixo ? insFixo
+                                                           : insVariavel;
+        q.bindValue(0, l.descricao);
+        q.bindValue(1, l.valorCentavos);
+        q.bindValue(2, l.data.toString("yyyy-MM-dd"));
+        if (l.tipo != TipoLancamento::Entrada)
+            q.bindValue(3, l.categoriaId);
+        if (!q.exec()) return falhar(q);
+
+        ++impressoes[impressaoDigital(int(l.tipo), l.data, l.valorCentavos, l.descricao)];
+    }
+
+    QSqlQuery ins(m_db);
+    ins.prepare("INSERT INTO impressoes_digitais (hash, quantidade) VALUES (?, ?)"
+                " ON CONFLICT(hash) DO UPDATE SET quantidade = quantidade + excluded.quantidade");
+    for (auto it = impressoes.cbegin(); it != impressoes.cend(); ++it) {
+        ins.bindValue(0, qint64(it.key()));
+        ins.bindValue(1, it.value());
+        if (!ins.exec()) return falhar(ins);
+        m_bloom.adicionar(it.key());
+    }
+    if (m_bloom.saturado()) carregarImpressoes();  // redimensiona o filtro
+
+    if (transacaoPropria && !m_db.commit()) {
+        qDebug() << "inserirLancamentos:" << m_db.lastError().text();
+        return false;
+    }
+    for (const Lancamento &l : lancamentos) {
+        if (l.tipo == TipoLancamento::Entrada) continue;
+        m_classificador.aprender(l.descricao, l.categoriaId, +1);
+        m_estatisticasCategoria.registrar(l.categoriaId, l.data, l.valorCentavos, +1);
+        m_anomalias.registrar(l.categoriaId, l.descricao, l.valorCentavos, +1);
+        m_modelosAlterados |= ModelosTodos;
+    }
+    notificar({Mutacao::Operacao::Recarga, {}, {}});  // uma notificação por bloco
+    salvarEEncriptar();
+    return true;
+}
+
+// ── Histórico ─────────────────────────────────────────────────────────────────
+
+QList<ResumoHistorico> DatabaseManager::resumirHistoricos(TipoLancamento tipo)
+{
+    TRACE_SPAN("DatabaseManager::resumirHistoricos", "db");
+    const QString coluna = colunaDescricao(tipo);
+
+    // Coluna solta com MAX(): o SQLite devolve valor_centavos da linha que
+    // deu o máximo — o valor do lançamento mais recente de cada grupo
+    Consulta q(m_db);
+    q.setForwardOnly(true);
+    executar(q, "resumirHistoricos",
+             "SELECT " + coluna + ", "
+             + (tipo == TipoLancamento::Entrada ? QString("0") : QString("categoria_id"))
+             + ", COUNT(*), MAX(data), valor_centavos FROM " + tabelaDe(tipo)
+             + " WHERE " + coluna + " <> '' GROUP BY 1, 2");
+
+    QList<ResumoHistorico> resumos;
+    while (q.next()) {
+        ResumoHistorico r;
+        r.descricao           = q.value(0).toString();
+        r.categoriaId         = q.value(1).toInt();
+        r.quantidade          = q.value(2).toInt();
+        r.ultimaData          = QDate::fromString(q.value(3).toString(), "yyyy-MM-dd");
+        r.ultimoValorCentavos = q.value(4).toLongLong();
+        resumos.append(r);
+    }
+    return resumos;
+}
+
+// ── Cache analítico ───────────────────────────────────────────────────────────
+
+const CacheAnalitico &DatabaseManager::analitico()
+{
+    if (!m_analitico.carregado() && m_db.isOpen()) carregarAnalitico();
+    return m_analitico;
+}
+
+void DatabaseManager::carregarAnalitico()
+{
+    TRACE_SPAN("DatabaseManager::carregarAnalitico", "db");
+    m_analitico.limpar();
+
+    // julianday() conta a partir do meio-dia; +0.5 e truncado = QDate::toJulianDay()
+    const auto selecao = [](TipoLancamento tipo) {
+        return QString("SELECT %1, id, valor_centavos, CAST(julianday(data) + 0.5 AS INTEGER), %2 FROM %3")
+            .arg(int(tipo))
+            .arg(tipo == TipoLancamento::Entrada ? QString("0") : QString("categoria_id"),
+                 tabelaDe(tipo));
+    };
+    Consulta q(m_db);
+    q.setForwardOnly(true);
+    if (!executar(q, "carregarAnalitico",
+                  selecao(TipoLancamento::Entrada)
+                  + " UNION ALL " + selecao(TipoLancamento::GastoFixo)
+                  + " UNION ALL " + selecao(TipoLancamento::GastoVariavel)))
+        return;
+
+    while (q.next())
+        m_analitico.anexar(TipoLancamento(q.value(0).toInt()), q.value(1).toInt(),
+                           q.value(2).toLongLong(), q.value(3).toInt(), q.value(4).toInt());
+    // Parcelas como gastos variáveis, com id negativo (Parcelamento::idParcela)
+    for (const Parcelamento &p : listarParcelamentos())
+        for (int k = 0; k < p.quantidadeVigente(); ++k)
+            m_analitico.anexar(TipoLancamento::GastoVariavel, p.idParcela(k), p.valorParcela(k),
+                               int(p.dataParcela(k).toJulianDay()), p.categoriaId);
+    m_analitico.concluirCarga();  // ordena por dia em memória, sem ORDER BY no SQLite
+}
+
+void DatabaseManager::atualizarAnalitico(const Mutacao &m)
+{
+    if (m.operacao == Mutacao::Operacao::Recarga) {
+        m_analitico.limpar();  // relido na próxima consulta
+        return;
+    }
+    if (m.antes.id  != 0) m_analitico.retirar(m.antes);
+    if (m.depois.id != 0) m_analitico.adicionar(m.depois);
+}
+
+// ── Observadores ──────────────────────────────────────────────────────────────
+
+int DatabaseManager::adicionarObservador(std::function<void(const Mutacao &)> observador)
+{
+    const int id = m_proximoObservador++;
+    m_observadores.insert(id, std::move(observador));
+    return id;
+}
+
+void DatabaseManager::removerObservador(int id)
+{
+    m_observadores.remove(id);
+}
+
+void DatabaseManager::notificar(const Mutacao &m)
+{
+    // Índices internos (classificador, cache analítico) antes dos observadores externos
+    aprender(m);
+    atualizarAnalitico(m);
+
+    // Cópia: um observador pode se remover durante a notificação
+    const auto observadores = m_observadores;
+    for (const auto &observador : observadores)
+        observador(m);
+}
+
+// ── Duplicatas ────────────────────────────────────────────────────────────────
+
+bool DatabaseManager::lerLancamento(TipoLancamento tipo, int id, Lancamento &l)
+{
+    Consulta q(m_db);
+    q.prepare("SELECT " + colunaDescricao(tipo) + ", valor_centavos, data"
+              + (tipo == TipoLancamento::Entrada ? QString(", 0") : QString(", categoria_id"))
+              + " FROM " + tabelaDe(tipo) + " WHERE id = :id");
+    q.bindValue(":id", id);
+    if (!executar(q, "lerLancamento") || !q.next()) return false;
+
+    l.id            = id;
+    l.tipo          = tipo;
+    l.descricao     = q.value(0).toString();
+    l.valorCentavos = q.value(1).toLongLong();
+    l.data          = QDate::fromString(q.value(2).toString(), "yyyy-MM-dd");
+    l.categoriaId   = q.value(3).toInt();
+    return true;
+}
+
+bool DatabaseManager::registrarImpressao(const Lancamento &l, int delta)
+{
+    const qint64 hash = qint64(impressaoDigital(int(l.tipo), l.data,
+                                                l.valorCentavos, l.descricao));
+    Consulta q(m_db);
+    if (delta > 0) {
+        q.prepare("INSERT INTO impressoes_digitais (hash, quantidade) VALUES (:h, :d)"
+                  " ON CONFLICT(hash) DO UPDATE SET quantidade = quantidade + excluded.quantidade");
+        q.bindValue(":h", hash);
+        q.bindValue(":d", delta);
+        if (!executar(q, "registrarImpressao")) { qDebug() << "registrarImpressao:" << q.lastError().text(); return false; }
+
+        m_bloom.adicionar(quint64(hash));
+        if (m_bloom.saturado()) carregarImpressoes();  // redimensiona o filtro
+        return true;
+    }
+
+    // Remoção: o filtro de Bloom não esquece — só o índice persistido diminui
+    q.prepare("UPDATE impressoes_digitais SET quantidade = quantidade + :d WHERE hash = :h");
+    q.bindValue(":h", hash);
+    q.bindValue(":d", delta);
+    if (!executar(q, "registrarImpressao")) { qDebug() << "registrarImpressao:" << q.lastError().text(); return false; }
+    q.prepare("DELETE FROM impressoes_digitais WHERE hash = :h AND quantidade <= 0");
+    q.bindValue(":h", hash);
+    return executar(q, "registrarImpressao");
+}
+
+bool DatabaseManager::reconstruirImpressoes()
+{
+    TRACE_SPAN("DatabaseManager::reconstruirImpressoes", "db");
+    Consulta q(m_db);
+    executar(q, "reconstruirImpressoes", "DELETE FROM impressoes_digitais");
+
+    m_db.transaction();
+    QSqlQuery ins(m_db);
+    ins.prepare("INSERT INTO impressoes_digitais (hash, quantidade) VALUES (:h, 1)"
+                " ON CONFLICT(hash) DO UPDATE SET quantidade = quantidade + 1");
+
+    for (const TipoLancamento tipo : {TipoLancamento::Entrada, TipoLancamento::GastoFixo,
+                                      TipoLancamento::GastoVariavel}) {
+        q.setForwardOnly(true);
+        executar(q, "reconstruirImpressoes",
+                 "SELECT " + colunaDescricao(tipo) + ", valor_centavos, data FROM " + tabelaDe(tipo));
+        while (q.next()) {
+            const quint64 hash = impressaoDigital(
+                int(tipo), QDate::fromString(q.value(2).toString(), "yyyy-MM-dd"),
+                q.value(1).toLongLong(), q.value(0).toString());
+            ins.bindValue(":h", qint64(hash));
+            if (!ins.exec()) {
+                qDebug() << "reconstruirImpressoes:" << ins.lastError().text();
+                m_db.rollback();
+                return false;
+            }
+        }
+    }
+    return m_db.commit();
+}
+
+bool DatabaseManager::carregarImpressoes()
+{
+    TRACE_SPAN("DatabaseManager::carregarImpressoes", "db");
+    Consulta q(m_db);
+
+    // Bancos anteriores ao índice: gera as impressões uma única vez
+    executar(q, "carregarImpressoes",
+             "SELECT (SELECT COUNT(*) FROM impressoes_digitais),"
+             "       (SELECT COUNT(*) FROM entradas)"
+             "     + (SELECT COUNT(*) FROM gastos_fixos)"
+             "     + (SELECT COUNT(*) FROM gastos_variaveis)");
+    if (!q.next()) return false;
+    if (q.value(0).toLongLong() == 0 && q.value(1).toLongLong() > 0 && !m_emLote) {
+        if (!reconstruirImpressoes()) return false;
+    }
+
+    executar(q, "carregarImpressoes", "SELECT COUNT(*) FROM impressoes_digitais");
+    const qsizetype total = q.next() ? q.value(0).toLongLong() : 0;
+
+    // Folga de 2× para absorver inserções da sessão sem redimensionar
+    m_bloom.reservar(total * 2);
+    q.setForwardOnly(true);
+    executar(q, "carregarImpressoes", "SELECT hash FROM impressoes_digitais");
+    while (q.next())
+        m_bloom.adicionar(quint64(q.value(0).toLongLong()));
+    return true;
+}
+
+int DatabaseManager::contarDuplicatas(TipoLancamento tipo, const QDate &data,
+                                      qint64 valorCentavos, const QString &descricao)
+{
+    const quint64 hash = impressaoDigital(int(tipo), data, valorCentavos, descricao);
+    if (!m_bloom.talvezContenha(hash)) return 0;  // caminho comum: sem consulta
+
+    Consulta q(m_db);
+    q.prepare("SELECT quantidade FROM impressoes_digitais WHERE hash = :h");
+    q.bindValue(":h", qint64(hash));
+    return executar(q, "contarDuplicatas") && q.next() ? q.value(0).toInt() : 0;
+}
@@ -1,60 +1,354 @@
 #pragma once
 
+#include "core/CacheAnalitico.h"
+#include "core/ClassificadorBayes.h"
+#include "core/DetectorAnomalias.h"
+#include "core/EstatisticasCategoria.h"
+#include "core/MotorRegras.h"
 #include "models/Categoria.h"
 #include "models/Entrada.h"
 #include "models/GastoFixo.h"
 #include "models/GastoVariavel.h"
+#include "models/Lancamento.h"
+#include "models/Parcelamento.h"
+#include "models/Periodo.h"
+#include "models/Recorrencia.h"
+#include "models/RegraCategoria.h"
+#include "utils/BloomFilter.h"
+#include "utils/HistogramaLatencia.h"
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QList>
+#include <QPair>
+#include <QSet>
 #include <QSqlDatabase>
+#include <QSqlQuery>
 #include <QString>
 #include <QtGlobal>
 
+#include <functional>
+
+// Um par (descrição, categoria) distinto com o seu uso — base do índice de
+// autocompletar
+struct ResumoHistorico {
+    QString descricao;
+    int     categoriaId   = 0;
+    int     quantidade    = 0;
+    QDate   ultimaData;
+    qint64  ultimoValorCentavos = 0;  // do lançamento mais recente
+};
+
+// Alteração de um lançamento, entregue aos observadores após o statement.
+// Recarga: o conteúdo mudou em bloco (conexão, carga em massa, lote
+// cancelado) — quem mantém estado derivado deve relê-lo do banco.
+struct Mutacao {
+    enum class Operacao { Insercao, Atualizacao, Remocao, Recarga };
+
+    Operacao   operacao = Operacao::Recarga;
+    Lancamento antes;   // Atualizacao, Remocao
+    Lancamento depois;  // Insercao, Atualizacao
+};
+
+// Gastos (fixos + variáveis) de um dia, da tabela agregado_diario
+struct GastoDiario {
+    QDate  dia;
+    qint64 totalCentavos = 0;
+    int    quantidade    = 0;
+};
+
+// Orçamento mensal de uma categoria e quanto já foi gasto nela no mês
+struct ConsumoOrcamento {
+    qint64 limiteCentavos = 0;  // 0 = categoria sem orçamento
+    qint64 gastoCentavos  = 0;
+
+    bool   definido() const   { return limiteCentavos > 0; }
+    bool   estourado() const  { return definido() && gastoCentavos > limiteCentavos; }
+    double fracao() const     { return definido() ? double(gastoCentavos) / double(limiteCentavos) : 0.0; }
+};
+
+// Contadores agregados de um statement (chave: SQL), acumulados desde a
+// conexão ou o último zerarEstatisticasQueries()
+struct EstatisticaQuery {
+    QString            rotulo;   // método que a emitiu
+    QString            sql;
+    qint64             execucoes = 0;
+    qint64             lentas    = 0;  // acima do limite de query lenta
+    qint64             totalNs   = 0;
+    qint64             maximoNs  = 0;
+    HistogramaLatencia latencia;
+};
+
+// Retrato do banco para o painel de diagnóstico
+struct DiagnosticoBanco {
+    qint64 bytesBanco = 0;         // .db temporário (SQLite em claro)
+    qint64 bytesEnc   = 0;         // .enc
+    QList<QPair<QString, qint64>> linhasPorTabela;
+    double taxaAcertoCache = -1;   // page cache, 0–1; -1 se indisponível
+    qint64 derivacaoMs     = -1;   // último PBKDF2 (login ou salvamento)
+    qint64 salvamentoMs    = -1;   // último salvarEEncriptar() completo
+};
+
 class DatabaseManager
 {
 public:
     static DatabaseManager &instance();
 
+    // Diretório dos .enc — padrão: <diretório do executável>/data.
+    // Benchmarks e ferramentas apontam para um diretório temporário.
+    void definirDiretorioDados(const QString &diretorio);
+
     // nome → determina o arquivo data/<nome>.enc
     bool conectar(const QString &nome, const QString &senha);
     void desconectar();
     bool isConectado() const;
 
+    // .db temporário em uso — para conexões auxiliares (somente leitura) em
+    // outras threads, como a exportação
+    QString caminhoBanco() const;
+
+    // Há ao menos um lançamento em entradas, gastos_fixos ou gastos_variaveis?
+    bool possuiLancamentos();
+
+    // Lote: várias escritas em uma transação e um único salvamento criptografado
+    void iniciarLote();
+    bool concluirLote();
+    void cancelarLote();
+
     // Categorias
     QList<Categoria> listarCategorias();
     bool inserirCategoria(Categoria &cat);
     bool removerCategoria(int id);
 
+    // Regras de categorização — compiladas em um MotorRegras a cada alteração
+    QList<RegraCategoria> listarRegras();
+    bool inserirRegra(RegraCategoria &regra);
+    bool removerRegra(int id);
+
+    // Categoria sugerida pelas regras (a primeira cadastrada que casa); 0 = nenhuma
+    int categorizar(const QString &descricao, qint64 valorCentavos) const;
+
+    // Classificador Naive Bayes treinado nos históricos dos gastos, atualizado a
+    // cada inserção/edição/remoção e persistido na tabela `modelos`
+    ClassificadorBayes::Palpite preverCategoria(const QString &descricao) const;
+
+    // Regras primeiro; sem regra, o classificador, se acima de CONFIANCA_MINIMA
+    int sugerirCategoria(const QString &descricao, qint64 valorCentavos) const;
+
+    // Mediana/p90/p99 do valor dos gastos e do total mensal por categoria, de
+    // sketches mantidos a cada inserção/edição/remoção e persistidos em `modelos`
+    const EstatisticasCategoria &estatisticasCategoria() const { return m_estatisticasCategoria; }
+
+    // Orçamentos mensais por categoria (tabela `orcamentos`, espelhada em
+    // memória); limite 0 remove. O consumo vem da soma mensal mantida pelas
+    // mutações em EstatisticasCategoria: consultar é O(1), sem SUM no banco.
+    QHash<int, qint64> orcamentos() const { return m_orcamentos; }
+    bool               definirOrcamento(int categoriaId, qint64 limiteCentavos);
+    ConsumoOrcamento   consumoOrcamento(int categoriaId, const QDate &mes) const;
+
+    // Gasto muito acima da média do mesmo histórico (ou da categoria), por
+    // média/variância correntes — O(1), sem reler lançamentos
+    DetectorAnomalias::Avaliacao avaliarGasto(int categoriaId, const QString &descricao,
+                                              qint64 valorCentavos, bool registrado) const;
+
+    // Listas e totais recebem o período selecionado (padrão: tudo) — filtro
+    // no SQL, por range scan no índice de data de cada tabela
+
     // Entradas
-    QList<Entrada> listarEntradas();
+    QList<Entrada> listarEntradas(const Periodo &periodo = {});
     bool inserirEntrada(Entrada &entrada);
     bool atualizarEntrada(const Entrada &entrada);
     bool removerEntrada(int id);
-    qint64 totalEntradas();
+    qint64 totalEntradas(const Periodo &periodo = {});
 
     // Gastos Fixos
-    QList<GastoFixo> listarGastosFixos();
+    QList<GastoFixo> listarGastosFixos(const Periodo &periodo = {});
     bool inserirGastoFixo(GastoFixo &gasto);
     bool atualizarGastoFixo(const GastoFixo &gasto);
     bool removerGastoFixo(int id);
-    qint64 totalGastosFixos();
+    qint64 totalGastosFixos(const Periodo &periodo = {});
+
+    // Recorrências: só a regra fica gravada. As ocorrências de um período são
+    // expandidas na consulta (sem fim no período: até o fim do mês corrente;
+    // sem início: só o mês do fim), menos as já confirmadas ou dispensadas;
+    // confirmar grava um gasto fixo.
+    QList<Recorrencia> listarRecorrencias();
+    bool inserirRecorrencia(Recorrencia &recorrencia);
+    bool atualizarRecorrencia(const Recorrencia &recorrencia);
+    bool removerRecorrencia(int id);
+    QList<Ocorrencia> listarOcorrenciasPendentes(const Periodo &periodo = {});
+    bool confirmarOcorrencia(const Ocorrencia &ocorrencia, GastoFixo &gerado);
+    bool dispensarOcorrencia(const Ocorrencia &ocorrencia);
 
     // Gastos Variáveis
-    QList<GastoVariavel> listarGastosVariaveis();
+    QList<GastoVariavel> listarGastosVariaveis(const Periodo &periodo = {});
     bool inserirGastoVariavel(GastoVariavel &gasto);
     bool atualizarGastoVariavel(const GastoVariavel &gasto);
     bool removerGastoVariavel(int id);
-    qint64 totalGastosVariaveis();
+    qint64 totalGastosVariaveis(const Periodo &periodo = {});
+
+    // Compras parceladas: só o plano é gravado. Parcelas de um período são
+    // calculadas em forma fechada; os planos vêm por range scan em
+    // idx_parcelamentos_vigencia. As parcelas somam nas mesmas agregações dos
+    // gastos variáveis (calendário, cache analítico, estatísticas, orçamentos).
+    // Encerrar um plano = atualizá-lo com menos `vigentes`: as parcelas
+    // anteriores ficam no histórico.
+    QList<Parcelamento> listarParcelamentos(const Periodo &periodo = {});
+    bool lerParcelamento(int id, Parcelamento &parcelamento);
+    bool inserirParcelamento(Parcelamento &parcelamento);
+    bool atualizarParcelamento(const Parcelamento &parcelamento);
+    bool removerParcelamento(int id);
+    QList<Parcela> listarParcelas(const Periodo &periodo = {});
+    qint64 totalParcelas(const Periodo &periodo = {});
+    qint64 parcelasAVencer(const QDate &depoisDe);  // passivo: parcelas após a data
+
+    // Carga em massa (importadores, gerador de fixtures): um statement preparado
+    // por tabela e uma atualização por hash distinto no índice de duplicatas.
+    // Não preenche os ids; dentro de um lote, o salvamento fica para concluirLote().
+    bool inserirLancamentos(const QList<Lancamento> &lancamentos);
+
+    // Uma linha por dia com gasto no período, da tabela agregado_diario
+    // (mantida por triggers) — o ano inteiro do calendário em uma query de
+    // até 366 linhas, sem varrer os lançamentos
+    QList<GastoDiario> gastosPorDia(const Periodo &periodo);
+
+    // Busca textual em origem/historico: termos separados por espaço, todos
+    // obrigatórios, cada um como prefixo, sem diferenciar acentos ou caixa
+    // ("alimenta merc" acha "Alimentação — Mercado"). Devolve os ids do tipo
+    // pedido; texto vazio → conjunto vazio (quem chama trata como sem filtro).
+    QSet<int> buscarIds(TipoLancamento tipo, const QString &texto);
+
+    // Descrições distintas do tipo, agrupadas por categoria (entradas: 0)
+    QList<ResumoHistorico> resumirHistoricos(TipoLancamento tipo);
+
+    // Colunas de todos os lançamentos para agregações em memória (Dashboard);
+    // lidas na primeira chamada e mantidas pelas mutações, relidas após Recarga
+    const CacheAnalitico &analitico();
+
+    // Duplicatas — quantos lançamentos já existem com a mesma impressão digital
+    // (data, valor, descrição normalizada). Filtro de Bloom na frente do índice.
+    int contarDuplicatas(TipoLancamento tipo, const QDate &data,
+                         qint64 valorCentavos, const QString &descricao);
+
+    // Query lenta: acima do limite, o statement é logado com SQL, tipos dos
+    // parâmetros, linhas e EXPLAIN QUERY PLAN. Padrão: ORCAMENTO_QUERY_LENTA_MS
+    // ou 100 ms; negativo desliga o log (os contadores continuam).
+    void definirLimiteQueryLentaMs(int ms);
+    int  limiteQueryLentaMs() const;
+
+    // Um item por statement distinto, do maior tempo total para o menor
+    QList<EstatisticaQuery> estatisticasQueries() const;
+    HistogramaLatencia      latenciaQueries() const { return m_latenciaQueries; }
+    void                    zerarEstatisticasQueries();
+
+    DiagnosticoBanco diagnostico();
+
+    // Observadores de mutação — índices em memória (autocompletar, modelos)
+    // se mantêm em dia sem reler as tabelas. Chamados na thread do banco;
+    // o id devolvido serve para removerObservador().
+    int  adicionarObservador(std::function<void(const Mutacao &)> observador);
+    void removerObservador(int id);
+
+    // Grava o .enc agora — após alterações feitas por outra conexão ao .db
+    // (ex.: VACUUM em DatabaseMaintenance)
+    bool salvar();
 
 private:
-    DatabaseManager() = default;
+    DatabaseManager();
+
+    // QSqlQuery medida do exec() até o fim da leitura: o QSQLITE para no
+    // primeiro passo do statement e busca as linhas em next(), então um SELECT
+    // só é contado quando next() chega ao fim, em finish(), num novo prepare()
+    // ou executar() ou ao sair de escopo — com as linhas que passaram por next()
+    class Consulta : public QSqlQuery
+    {
+    public:
+        explicit Consulta(const QSqlDatabase &db) : QSqlQuery(db) {}
+        ~Consulta() { encerrar(); }
+        Consulta(const Consulta &) = delete;
+        Consulta &operator=(const Consulta &) = delete;
+
+        bool next();
+        void finish();
+        bool prepare(const QString &sql);
+
+    private:
+        friend class DatabaseManager;
+        void encerrar();
+
+        DatabaseManager *m_dono   = nullptr;  // não nulo enquanto mede
+        const char      *m_rotulo = nullptr;
+        QElapsedTimer    m_relogio;
+        qint64           m_linhas = 0;
+    };
+
+    // Todo statement passa por aqui: span de trace, contadores por SQL e log de
+    // query lenta, rotulados com o método que o emitiu. Laços de carga em massa
+    // e as contagens de diagnostico() chamam exec() direto.
+    bool executar(Consulta &q, const char *rotulo);
+    bool executar(Consulta &q, const char *rotulo, const QString &sql);
+    bool medir(Consulta &q, const char *rotulo, bool ok);
+
+    void registrarExecucao(const QSqlQuery &q, const char *rotulo, qint64 ns, qint64 linhas);
+    void logarQueryLenta(const QSqlQuery &q, const char *rotulo, qint64 ns, qint64 linhas);
 
     bool criarEsquema();
+    bool criarBusca();
+    bool criarAgregadoDiario();
+    void compilarRegras();
+    void carregarOrcamentos();
+
+    // Cada modelo em `modelos` é regravado só se mudou desde o último salvamento
+    enum ModeloAlterado : quint8 {
+        ModeloBayes        = 1,
+        ModeloEstatisticas = 2,
+        ModeloAnomalias    = 4,
+        ModelosTodos       = ModeloBayes | ModeloEstatisticas | ModeloAnomalias,
+    };
+
+    void carregarModelo();
+    void treinarModelo();
+    bool persistirModelo();
+    bool marcarOcorrencia(const Ocorrencia &ocorrencia, int gastoId);
+    bool agregarParcelas(const Parcelamento &p, int delta);
+    bool agregarParcelasNoDia(const Parcelamento &p, int delta);
+    qint64 contarGastos();
+    void aprender(const Mutacao &m);
+    void carregarAnalitico();
+    void atualizarAnalitico(const Mutacao &m);
     bool decriptarParaTemp();
     bool salvarEEncriptar();
 
+    bool lerLancamento(TipoLancamento tipo, int id, Lancamento &l);
+    bool carregarImpressoes();
+    bool reconstruirImpressoes();
+    bool registrarImpressao(const Lancamento &l, int delta);
+    void notificar(const Mutacao &m);
+
     QSqlDatabase m_db;
+    QString      m_diretorioDados;
     QString      m_senha;
     QString      m_arquivoEnc;  // data/<nome>.enc
     QString      m_arquivoTmp;  // data/.<nome>.db  (temp, deletado ao sair)
+    bool         m_emLote = false;
+    bool         m_buscaFts = false;  // FTS5 disponível; senão, LIKE
+    BloomFilter  m_bloom;       // espelho em memória de impressoes_digitais
+    MotorRegras  m_regras;      // regras_categoria compiladas
+
+    ClassificadorBayes    m_classificador;
+    EstatisticasCategoria m_estatisticasCategoria;
+    DetectorAnomalias     m_anomalias;
+    QHash<int, qint64>    m_orcamentos;  // categoria → limite mensal (centavos)
+    quint8                m_modelosAlterados = 0;  // ModeloAlterado: regravar no próximo salvamento
+
+    CacheAnalitico     m_analitico;
+
+    qint64                          m_derivacaoMs  = -1;
+    qint64                          m_salvamentoMs = -1;
+    qint64                          m_limiteLentaNs;
+    QHash<QString, EstatisticaQuery> m_estatisticas;     // SQL → contadores
+    HistogramaLatencia              m_latenciaQueries;  // todas as queries
+
+    QHash<int, std::function<void(const Mutacao &)>> m_observadores;
+    int                                             m_proximoObservador = 1;
 };
@@ -0,0 +1,182 @@
+#include "core/DetectorAnomalias.h"
+
+#include "utils/Fingerprint.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr quint32 ASSINATURA = 0x4f444131;  // "ODA1"
+
+// ── Welford ───────────────────────────────────────────────────────────────────
+
+void DetectorAnomalias::Momentos::adicionar(double x)
+{
+    ++n;
+    const double d = x - media;
+    media += d / double(n);
+    m2    += d * (x - media);
+}
+
+// Inverso de adicionar() a menos do arredondamento: m2 é limitado a 0, e a
+// média e m2 podem diferir nos últimos bits dos de quem nunca viu o valor. O
+// último valor retirado zera os momentos
+void DetectorAnomalias::Momentos::retirar(double x)
+{
+    if (n <= 1) {
+        *this = {};
+        return;
+    }
+    const double anterior = (double(n) * media - x) / double(n - 1);
+    m2    = std::max(0.0, m2 - (x - anterior) * (x - media));
+    media = anterior;
+    --n;
+}
+
+// Palavras do histórico normalizado sem dígitos; pontuação separa palavras
+// ("pag*padaria 0412" → "pag padaria")
+QString DetectorAnomalias::chaveHistorico(const QString &descricao)
+{
+    const QString normalizada = normalizarDescricao(descricao);
+    QString chave;
+    chave.reserve(normalizada.size());
+    qsizetype inicioPalavra = 0;
+    bool      comDigito     = false;
+    for (qsizetype i = 0; i <= normalizada.size(); ++i) {
+        const QChar c = i < normalizada.size() ? normalizada.at(i) : QChar(' ');
+        if (c.isLetterOrNumber()) {
+            if (c.isDigit()) comDigito = true;
+            continue;
+        }
+        if (i > inicioPalavra && !comDigito) {
+            if (!chave.isEmpty()) chave.append(' ');
+            chave.append(QStringView(normalizada).sliced(inicioPalavra, i - inicioPalavra));
+        }
+        inicioPalavra = i + 1;
+        comDigito     = false;
+    }
+    return chave;
+}
+
+void DetectorAnomalias::registrar(Momentos &m, double x, int delta)
+{
+    for (; delta > 0; --delta) m.adicionar(x);
+    for (; delta < 0; ++delta) m.retirar(x);
+}
+
+void DetectorAnomalias::limpar()
+{
+    m_categorias.clear();
+    m_historicos.clear();
+}
+
+void DetectorAnomalias::registrar(int categoriaId, const QString &descricao,
+                                  qint64 valorCentavos, int delta)
+{
+    const double x = double(valorCentavos);
+    Momentos &categoria = m_categorias[categoriaId];
+    registrar(categoria, x, delta);
+    if (categoria.n == 0) m_categorias.remove(categoriaId);
+
+    const QString chave = chaveHistorico(descricao);
+    if (chave.isEmpty()) return;
+    const QPair<int, QString> k(categoriaId, chave);
+    Momentos &historico = m_historicos[k];
+    registrar(historico, x, delta);
+    if (historico.n == 0) m_historicos.remove(k);
+}
+
+// ── Avaliação ─────────────────────────────────────────────────────────────────
+
+DetectorAnomalias::Avaliacao DetectorAnomalias::comparar(Momentos m, double x, bool registrado,
+                                                         int amostraMinima)
+{
+    if (registrado) m.retirar(x);
+    if (m.n < amostraMinima) return {};
+
+    // Desvio amostral, com piso: um histórico de valores idênticos (assinatura,
+    // aluguel) tem desvio 0 e marcaria qualquer reajuste
+    const double desvio = std::max(std::sqrt(m.m2 / double(m.n - 1)),
+                                   std::max(DESVIO_MINIMO * m.media, 1.0));
+    Avaliacao a;
+    a.escore  = (x - m.media) / desvio;
+    a.media   = m.media;
+    a.amostra = m.n;
+    a.anomalo = a.escore >= LIMIAR_ESCORE;
+    return a;
+}
+
+// Histórico primeiro (o mercado do mês não é comparado ao do aluguel); sem
+// lançamentos suficientes dele, a categoria inteira
+DetectorAnomalias::Avaliacao DetectorAnomalias::avaliar(int categoriaId, const QString &descricao,
+                                                        qint64 valorCentavos, bool registrado) const
+{
+    const double x = double(valorCentavos);
+
+    const auto h = m_historicos.constFind({categoriaId, chaveHistorico(descricao)});
+    if (h != m_historicos.cend()) {
+        Avaliacao a = comparar(*h, x, registrado, AMOSTRA_HISTORICO);
+        if (a.amostra > 0) {
+            a.porHistorico = true;
+            return a;
+        }
+    }
+
+    const auto c = m_categorias.constFind(categoriaId);
+    if (c == m_categorias.cend()) return {};
+    return comparar(*c, x, registrado, AMOSTRA_CATEGORIA);
+}
+
+// ── Serialização ──────────────────────────────────────────────────────────────
+
+QByteArray DetectorAnomalias::serializar() const
+{
+    QByteArray dados;
+    QDataStream out(&dados, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << ASSINATURA << qint32(VERSAO);
+    out << qint32(m_categorias.size());
+    for (auto it = m_categorias.cbegin(); it != m_categorias.cend(); ++it)
+        out << qint32(it.key()) << it->n << it->media << it->m2;
+    out << qint32(m_historicos.size());
+    for (auto it = m_historicos.cbegin(); it != m_historicos.cend(); ++it)
+        out << qint32(it.key().first) << it.key().second << it->n << it->media << it->m2;
+    return dados;
+}
+
+bool DetectorAnomalias::desserializar(const QByteArray &dados)
+{
+    limpar();
+    QDataStream in(dados);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 assinatura = 0;
+    qint32  versao = 0, quantidade = 0;
+    in >> assinatura >> versao;
+    if (assinatura != ASSINATURA || versao != VERSAO) return false;
+
+    in >> quantidade;
+    for (qint32 i = 0; i < quantidade && in.status() == QDataStream::Ok; ++i) {
+        qint32   id = 0;
+        Momentos m;
+        in >> id >> m.n >> m.media >> m.m2;
+        m_categorias.insert(id, m);
+    }
+    in >> quantidade;
+    for (qint32 i = 0; i < quantidade && in.status() == QDataStream::Ok; ++i) {
+        qint32   id = 0;
+        QString  chave;
+        Momentos m;
+        in >> id >> chave >> m.n >> m.media >> m.m2;
+        m_historicos.insert({id, chave}, m);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        limpar();
+        return false;
+    }
+    return true;
+}
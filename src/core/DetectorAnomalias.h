@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QtGlobal>
+
+// Média e variância correntes (Welford) do valor dos gastos por categoria e
+// por (categoria, histórico normalizado). Cada mutação soma ou retira um valor
+// em O(1) — a fórmula de Welford se inverte, a menos do arredondamento, o que
+// uma média móvel exponencial não permite —, então avaliar um gasto nunca relê
+// o histórico. Mantido pelo DatabaseManager e gravado na tabela `modelos`.
+//
+// O histórico entra na chave sem as palavras com dígitos (código de loja,
+// terminal, data, "3/10"): "PADARIA 0412 15/03" e "Padaria 0977" somam juntos e
+// o mapa cresce com os estabelecimentos, não com as compras.
+class DetectorAnomalias
+{
+public:
+    static constexpr int    VERSAO            = 2;     // formato de serializar()
+    static constexpr double LIMIAR_ESCORE     = 3.0;   // desvios-padrão acima da média
+    static constexpr int    AMOSTRA_HISTORICO = 5;     // mínimo para comparar pelo histórico
+    static constexpr int    AMOSTRA_CATEGORIA = 30;    // ... ou, sem ele, pela categoria
+    static constexpr double DESVIO_MINIMO     = 0.05;  // fração da média (valores sempre iguais)
+
+    struct Avaliacao {
+        bool   anomalo      = false;
+        bool   porHistorico = false;  // comparado ao mesmo histórico (senão, à categoria)
+        double escore       = 0.0;    // (valor − média) / desvio
+        double media        = 0.0;    // centavos
+        qint64 amostra      = 0;      // lançamentos na base de comparação
+    };
+
+    void limpar();
+
+    // delta = +1 ao gravar um gasto, -1 ao removê-lo (ou antes de editá-lo)
+    void registrar(int categoriaId, const QString &descricao, qint64 valorCentavos, int delta);
+
+    // `registrado`: o gasto já está nas estatísticas (linha gravada) e é
+    // descontado delas, para não puxar a média na própria direção. Falso para
+    // um gasto ainda por gravar (importação).
+    Avaliacao avaliar(int categoriaId, const QString &descricao, qint64 valorCentavos,
+                      bool registrado) const;
+
+    QByteArray serializar() const;
+    bool       desserializar(const QByteArray &dados);
+
+private:
+    struct Momentos {
+        qint64 n     = 0;
+        double media = 0.0;
+        double m2    = 0.0;  // soma dos quadrados dos desvios
+
+        void adicionar(double x);
+        void retirar(double x);
+    };
+
+    static QString chaveHistorico(const QString &descricao);
+    static void    registrar(Momentos &m, double x, int delta);
+    static Avaliacao comparar(Momentos m, double x, bool registrado, int amostraMinima);
+
+    QHash<int, Momentos>                 m_categorias;
+    QHash<QPair<int, QString>, Momentos> m_historicos;  // (categoria, chaveHistorico())
+};
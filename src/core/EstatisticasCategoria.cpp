@@ -0,0 +1,144 @@
+#include "core/EstatisticasCategoria.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr quint32 ASSINATURA = 0x4f455331;  // "OES1"
+
+void EstatisticasCategoria::limpar()
+{
+    m_categorias.clear();
+}
+
+void EstatisticasCategoria::registrar(int categoriaId, const QDate &data,
+                                      qint64 valorCentavos, int delta)
+{
+    if (!data.isValid()) return;
+    PorCategoria &c = m_categorias[categoriaId];
+    const qint32  k = chaveMes(data);
+
+    c.total.adicionar(valorCentavos, delta);
+    DDSketch &mes = c.meses[k];
+    mes.adicionar(valorCentavos, delta);
+    c.somaMes[k] += valorCentavos * delta;
+
+    // Mês ou categoria sem lançamentos: some, como se nunca tivesse existido
+    if (mes.vazio()) {
+        c.meses.remove(k);
+        c.somaMes.remove(k);
+    }
+    if (c.total.vazio()) m_categorias.remove(categoriaId);
+}
+
+EstatisticasCategoria::Resumo EstatisticasCategoria::resumo(int categoriaId, const QDate &inicio,
+                                                            const QDate &fim) const
+{
+    const auto it = m_categorias.constFind(categoriaId);
+    if (it == m_categorias.cend()) return {};
+
+    // Sem limites: o sketch da categoria inteira, sem mesclar
+    DDSketch mesclado;
+    const DDSketch *sketch = &it->total;
+    if (inicio.isValid() || fim.isValid()) {
+        auto mes = inicio.isValid() ? it->meses.lowerBound(chaveMes(inicio)) : it->meses.cbegin();
+        const auto ultimo = fim.isValid() ? it->meses.upperBound(chaveMes(fim)) : it->meses.cend();
+        for (; mes != ultimo; ++mes) mesclado.mesclar(mes.value());
+        sketch = &mesclado;
+    }
+    return {sketch->contagem(), sketch->quantil(0.5), sketch->quantil(0.9), sketch->quantil(0.99)};
+}
+
+EstatisticasCategoria::Resumo EstatisticasCategoria::resumoMensal(int categoriaId, const QDate &inicio,
+                                                                  const QDate &fim) const
+{
+    const auto it = m_categorias.constFind(categoriaId);
+    if (it == m_categorias.cend()) return {};
+
+    QList<qint64> totais;
+    auto mes = inicio.isValid() ? it->somaMes.lowerBound(chaveMes(inicio)) : it->somaMes.cbegin();
+    const auto ultimo = fim.isValid() ? it->somaMes.upperBound(chaveMes(fim)) : it->somaMes.cend();
+    for (; mes != ultimo; ++mes) totais.append(mes.value());
+    if (totais.isEmpty()) return {};
+
+    // Poucas dezenas de meses: seleção parcial, mesmo posto que DDSketch::quantil
+    const auto quantil = [&totais](double q) {
+        const auto n = totais.begin() + qsizetype(std::floor(q * double(totais.size() - 1)));
+        std::nth_element(totais.begin(), n, totais.end());
+        return *n;
+    };
+    const qint64 mediana = quantil(0.5);
+    const qint64 p90     = quantil(0.9);
+    const qint64 p99     = quantil(0.99);
+    return {qint64(totais.size()), mediana, p90, p99};
+}
+
+qint64 EstatisticasCategoria::limiteAtipico(int categoriaId) const
+{
+    const auto it = m_categorias.constFind(categoriaId);
+    if (it == m_categorias.cend() || it->total.contagem() < AMOSTRA_MINIMA) return 0;
+    return it->total.quantil(0.99);
+}
+
+qint64 EstatisticasCategoria::totalMes(int categoriaId, const QDate &data) const
+{
+    const auto it = m_categorias.constFind(categoriaId);
+    return it == m_categorias.cend() || !data.isValid() ? 0 : it->somaMes.value(chaveMes(data));
+}
+
+// ── Serialização ──────────────────────────────────────────────────────────────
+
+QByteArray EstatisticasCategoria::serializar() const
+{
+    QByteArray dados;
+    QDataStream out(&dados, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    // Categorias em ordem de id: mesmo conteúdo, mesmos bytes (o QHash não garante ordem)
+    QList<int> ids = m_categorias.keys();
+    std::sort(ids.begin(), ids.end());
+
+    out << ASSINATURA << qint32(VERSAO) << qint32(ids.size());
+    for (const int id : std::as_const(ids)) {
+        const PorCategoria &c = *m_categorias.constFind(id);
+        out << qint32(id) << c.total << qint32(c.meses.size());
+        for (auto m = c.meses.cbegin(); m != c.meses.cend(); ++m)
+            out << m.key() << m.value() << c.somaMes.value(m.key());
+    }
+    return dados;
+}
+
+bool EstatisticasCategoria::desserializar(const QByteArray &dados)
+{
+    limpar();
+    QDataStream in(dados);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 assinatura = 0;
+    qint32  versao = 0, categorias = 0;
+    in >> assinatura >> versao >> categorias;
+    if (assinatura != ASSINATURA || versao != VERSAO || categorias < 0) return false;
+
+    for (qint32 i = 0; i < categorias && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0, meses = 0;
+        PorCategoria c;
+        in >> id >> c.total >> meses;
+        for (qint32 k = 0; k < meses && in.status() == QDataStream::Ok; ++k) {
+            qint32   chave = 0;
+            DDSketch sketch;
+            qint64   soma = 0;
+            in >> chave >> sketch >> soma;
+            c.meses.insert(chave, sketch);
+            c.somaMes.insert(chave, soma);
+        }
+        m_categorias.insert(id, c);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        limpar();
+        return false;
+    }
+    return true;
+}
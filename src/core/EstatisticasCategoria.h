@@ -0,0 +1,66 @@
+#pragma once
+
+#include "utils/DDSketch.h"
+
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QtGlobal>
+
+// Distribuição dos gastos por categoria: um DDSketch do valor dos lançamentos
+// por (categoria, mês), mais um da categoria inteira e a soma de cada mês.
+// Mantido a cada inserção/edição/remoção pelo DatabaseManager — registrar é
+// O(log baldes), sem reler nem ordenar lançamentos —, e gravado na tabela
+// `modelos` (e, com ela, no .enc). Um período é a mescla dos meses dele.
+class EstatisticasCategoria
+{
+public:
+    static constexpr int VERSAO         = 1;   // formato de serializar()
+    static constexpr int AMOSTRA_MINIMA = 30;  // abaixo disso, nada é atípico
+
+    struct Resumo {
+        qint64 quantidade = 0;  // lançamentos (ou meses, no resumo mensal)
+        qint64 mediana    = 0;  // centavos, erro relativo ≤ DDSketch::ALFA
+        qint64 p90        = 0;
+        qint64 p99        = 0;
+    };
+
+    void limpar();
+
+    // delta = +1 ao gravar um gasto, -1 ao removê-lo (ou antes de editá-lo)
+    void registrar(int categoriaId, const QDate &data, qint64 valorCentavos, int delta);
+
+    // Valor dos lançamentos da categoria no intervalo (mês a mês; datas
+    // inválidas = sem limite)
+    Resumo resumo(int categoriaId, const QDate &inicio = {}, const QDate &fim = {}) const;
+
+    // Distribuição do total gasto por mês na categoria, entre os meses do
+    // intervalo com algum gasto — no máximo um valor por mês, não por lançamento
+    Resumo resumoMensal(int categoriaId, const QDate &inicio = {}, const QDate &fim = {}) const;
+
+    // p99 do valor na categoria inteira; 0 se houver menos de AMOSTRA_MINIMA
+    // lançamentos. Um gasto acima dele é destacado nas tabelas.
+    qint64 limiteAtipico(int categoriaId) const;
+
+    // Total gasto na categoria no mês de `data` — a soma já mantida por
+    // registrar(), sem percorrer lançamentos
+    qint64 totalMes(int categoriaId, const QDate &data) const;
+
+    QList<int> categorias() const { return m_categorias.keys(); }
+
+    QByteArray serializar() const;
+    bool       desserializar(const QByteArray &dados);
+
+private:
+    struct PorCategoria {
+        DDSketch               total;
+        QMap<qint32, DDSketch> meses;     // ano * 12 + mês − 1 → valores
+        QMap<qint32, qint64>   somaMes;   // idem → centavos
+    };
+
+    static qint32 chaveMes(const QDate &data) { return data.year() * 12 + data.month() - 1; }
+
+    QHash<int, PorCategoria> m_categorias;
+};
@@ -0,0 +1,192 @@
+#include "core/IndiceAutocomplete.h"
+
+#include "core/DatabaseManager.h"
+#include "utils/Fingerprint.h"
+
+#include <QPair>
+
+#include <algorithm>
+#include <cmath>
+
+IndiceAutocomplete::IndiceAutocomplete(TipoLancamento tipo)
+    : m_tipo(tipo)
+{
+    m_observador = DatabaseManager::instance().adicionarObservador(
+        [this](const Mutacao &m) { aplicar(m); });
+}
+
+IndiceAutocomplete::~IndiceAutocomplete()
+{
+    DatabaseManager::instance().removerObservador(m_observador);
+}
+
+// ── Consulta ──────────────────────────────────────────────────────────────────
+
+QList<SugestaoHistorico> IndiceAutocomplete::sugerir(const QString &prefixo, int limite)
+{
+    const QString chave = normalizarDescricao(prefixo);
+    if (chave.isEmpty() || limite <= 0) return {};
+
+    if (!m_carregado) {
+        if (!DatabaseManager::instance().isConectado()) return {};
+        carregar();
+    }
+
+    // Intervalo do prefixo no vetor ordenado, pontuado por frequência e recência
+    const QDate hoje = QDate::currentDate();
+    QList<QPair<double, qsizetype>> candidatos;
+    for (qsizetype i = posicao(chave); i < m_itens.size() && m_itens[i].chave.startsWith(chave); ++i) {
+        const Item &item = m_itens[i];
+        const qint64 idade = std::max<qint64>(0, item.ultimaData.daysTo(hoje));
+        candidatos.append({item.frequencia * std::exp2(-double(idade) / MEIA_VIDA_DIAS), i});
+    }
+
+    const qsizetype n = std::min<qsizetype>(limite, candidatos.size());
+    std::partial_sort(candidatos.begin(), candidatos.begin() + n, candidatos.end(),
+                      [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    QList<SugestaoHistorico> sugestoes;
+    sugestoes.reserve(n);
+    for (qsizetype k = 0; k < n; ++k) {
+        const Item &item = m_itens[candidatos[k].second];
+
+        // Categoria mais usada; empate → a de menor id, para a sugestão ser estável
+        int categoria = 0, usos = 0;
+        for (auto it = item.categorias.cbegin(); it != item.categorias.cend(); ++it) {
+            if (it.value() > usos || (it.value() == usos && it.key() < categoria)) {
+                categoria = it.key();
+                usos      = it.value();
+            }
+        }
+
+        sugestoes.append({item.historico, categoria, item.ultimoValor,
+                          item.frequencia, item.ultimaData});
+    }
+    return sugestoes;
+}
+
+qsizetype IndiceAutocomplete::posicao(const QString &chave) const
+{
+    const auto it = std::lower_bound(m_itens.cbegin(), m_itens.cend(), chave,
+                                     [](const Item &item, const QString &c) { return item.chave < c; });
+    return it - m_itens.cbegin();
+}
+
+// ── Carga ─────────────────────────────────────────────────────────────────────
+
+void IndiceAutocomplete::carregar()
+{
+    // Grafias diferentes ("Padaria", "PADARIA ") caem na mesma chave
+    QHash<QString, Item> porChave;
+    for (const ResumoHistorico &r : DatabaseManager::instance().resumirHistoricos(m_tipo)) {
+        const QString chave = normalizarDescricao(r.descricao);
+        if (chave.isEmpty()) continue;
+
+        Item &item = porChave[chave];
+        item.chave       = chave;
+        item.frequencia += r.quantidade;
+        item.categorias[r.categoriaId] += r.quantidade;
+        if (!item.ultimaData.isValid() || r.ultimaData > item.ultimaData) {
+            item.historico   = r.descricao;
+            item.ultimaData  = r.ultimaData;
+            item.ultimoValor = r.ultimoValorCentavos;
+        }
+    }
+
+    m_itens.clear();
+    m_itens.reserve(porChave.size());
+    for (auto it = porChave.begin(); it != porChave.end(); ++it)
+        m_itens.append(std::move(it.value()));
+    std::sort(m_itens.begin(), m_itens.end(),
+              [](const Item &a, const Item &b) { return a.chave < b.chave; });
+    m_carregado = true;
+}
+
+// ── Atualização incremental ───────────────────────────────────────────────────
+
+void IndiceAutocomplete::aplicar(const Mutacao &m)
+{
+    if (!m_carregado) return;  // a próxima consulta lê o banco de qualquer forma
+
+    switch (m.operacao) {
+    case Mutacao::Operacao::Recarga:
+        m_carregado = false;
+        m_itens.clear();
+        return;
+    case Mutacao::Operacao::Insercao:
+        if (m.depois.tipo == m_tipo) adicionar(m.depois);
+        return;
+    case Mutacao::Operacao::Remocao:
+        if (m.antes.tipo == m_tipo) retirar(m.antes);
+        return;
+    case Mutacao::Operacao::Atualizacao:
+        break;
+    }
+
+    if (m.depois.tipo != m_tipo) return;
+    const QString chave = normalizarDescricao(m.antes.descricao);
+    const qsizetype pos = posicao(chave);
+    if (chave.isEmpty() || chave != normalizarDescricao(m.depois.descricao)
+        || pos >= m_itens.size() || m_itens[pos].chave != chave) {
+        retirar(m.antes);
+        adicionar(m.depois);
+        return;
+    }
+
+    // Mesma descrição (edição de valor, data ou categoria): ajuste no lugar,
+    // sem a invalidação que retirar() faria ao mexer no lançamento mais recente
+    Item &item = m_itens[pos];
+    if (--item.categorias[m.antes.categoriaId] <= 0)
+        item.categorias.remove(m.antes.categoriaId);
+    ++item.categorias[m.depois.categoriaId];
+
+    if (m.depois.data >= item.ultimaData) {
+        item.historico   = m.depois.descricao;
+        item.ultimaData  = m.depois.data;
+        item.ultimoValor = m.depois.valorCentavos;
+    } else if (m.antes.data >= item.ultimaData) {
+        m_carregado = false;  // o mais recente recuou — só o banco sabe qual é o novo
+    }
+}
+
+void IndiceAutocomplete::adicionar(const Lancamento &l)
+{
+    const QString chave = normalizarDescricao(l.descricao);
+    if (chave.isEmpty()) return;
+
+    qsizetype pos = posicao(chave);
+    if (pos >= m_itens.size() || m_itens[pos].chave != chave) {
+        Item novo;
+        novo.chave = chave;
+        m_itens.insert(pos, std::move(novo));
+    }
+
+    Item &item = m_itens[pos];
+    ++item.frequencia;
+    ++item.categorias[l.categoriaId];
+    if (!item.ultimaData.isValid() || l.data >= item.ultimaData) {
+        item.historico   = l.descricao;
+        item.ultimaData  = l.data;
+        item.ultimoValor = l.valorCentavos;
+    }
+}
+
+void IndiceAutocomplete::retirar(const Lancamento &l)
+{
+    const QString chave = normalizarDescricao(l.descricao);
+    if (chave.isEmpty()) return;
+
+    const qsizetype pos = posicao(chave);
+    if (pos >= m_itens.size() || m_itens[pos].chave != chave) return;
+
+    Item &item = m_itens[pos];
+    if (--item.frequencia <= 0) {
+        m_itens.removeAt(pos);
+        return;
+    }
+    if (--item.categorias[l.categoriaId] <= 0)
+        item.categorias.remove(l.categoriaId);
+
+    // Saiu o lançamento mais recente: data e valor sugeridos ficam desconhecidos
+    if (l.data >= item.ultimaData) m_carregado = false;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "models/Lancamento.h"
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+struct Mutacao;
+
+// Uma sugestão do autocompletar de histórico
+struct SugestaoHistorico {
+    QString historico;          // grafia do lançamento mais recente
+    int     categoriaId   = 0;  // categoria mais usada com esse histórico
+    qint64  valorCentavos = 0;  // valor do lançamento mais recente
+    int     frequencia    = 0;
+    QDate   ultimaData;
+};
+
+// Índice de prefixos das descrições já usadas em um tipo de lançamento, para
+// sugerir o histórico durante a digitação. Vetor ordenado pela descrição
+// normalizada: um prefixo é o intervalo [lower_bound, upper_bound), achado em
+// O(log n) sem tocar o banco. Carregado na primeira consulta e mantido em dia
+// pelas mutações do DatabaseManager; Recarga apenas o invalida.
+class IndiceAutocomplete
+{
+public:
+    static constexpr int    LIMITE_PADRAO  = 8;
+    static constexpr double MEIA_VIDA_DIAS = 90.0;  // decaimento da recência
+
+    explicit IndiceAutocomplete(TipoLancamento tipo);
+    ~IndiceAutocomplete();
+
+    IndiceAutocomplete(const IndiceAutocomplete &) = delete;
+    IndiceAutocomplete &operator=(const IndiceAutocomplete &) = delete;
+
+    // Descrições que começam com `prefixo` (sem acentos nem caixa), da maior
+    // pontuação frequência × 2^(−idade/meia-vida) para a menor
+    QList<SugestaoHistorico> sugerir(const QString &prefixo, int limite = LIMITE_PADRAO);
+
+private:
+    struct Item {
+        QString        chave;       // normalizarDescricao(historico)
+        QString        historico;
+        int            frequencia  = 0;
+        QDate          ultimaData;
+        qint64         ultimoValor = 0;
+        QHash<int, int> categorias;  // categoria → ocorrências
+    };
+
+    void carregar();
+    void aplicar(const Mutacao &m);
+    void adicionar(const Lancamento &l);
+    void retirar(const Lancamento &l);
+    qsizetype posicao(const QString &chave) const;  // lower_bound
+
+    TipoLancamento m_tipo;
+    int            m_observador = 0;
+    bool           m_carregado  = false;
+    QList<Item>    m_itens;  // ordenado por chave
+};
@@ -0,0 +1,353 @@
+#include "core/LedgerExporter.h"
+#include "utils/Tracer.h"
+
+#include <QDate>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QtEndian>
+
+#include <memory>
+
+namespace {
+
+constexpr int PROGRESSO_A_CADA = 4096;
+
+struct Linha {
+    QByteArray tipo;
+    qint64     id            = 0;
+    QString    data;             // yyyy-MM-dd, como no banco
+    QString    descricao;
+    qint64     valorCentavos = 0;
+    int        categoriaId   = 0;
+    QString    categoria;
+};
+
+// ── Escritores ────────────────────────────────────────────────────────────────
+
+class Escritor
+{
+public:
+    explicit Escritor(QFile &arquivo) : m_arquivo(arquivo) {}
+    virtual ~Escritor() = default;
+
+    virtual bool iniciar() { return true; }
+    virtual bool escrever(const Linha &l) = 0;
+    virtual bool finalizar() { return true; }
+
+protected:
+    bool gravar(const QByteArray &bytes)
+    {
+        return m_arquivo.write(bytes) == bytes.size();
+    }
+
+    QFile &m_arquivo;
+};
+
+class EscritorCsv : public Escritor
+{
+public:
+    using Escritor::Escritor;
+
+    bool iniciar() override
+    {
+        return gravar("tipo,id,data,descricao,valor_centavos,categoria_id,categoria\n");
+    }
+
+    bool escrever(const Linha &l) override
+    {
+        m_buf.clear();
+        m_buf += l.tipo;
+        m_buf += ',';
+        m_buf += QByteArray::number(l.id);
+        m_buf += ',';
+        m_buf += l.data.toLatin1();
+        m_buf += ',';
+        campo(l.descricao);
+        m_buf += ',';
+        m_buf += QByteArray::number(l.valorCentavos);
+        m_buf += ',';
+        m_buf += QByteArray::number(l.categoriaId);
+        m_buf += ',';
+        campo(l.categoria);
+        m_buf += '\n';
+        return gravar(m_buf);
+    }
+
+private:
+    // RFC 4180: aspas só quando necessário, aspas internas duplicadas
+    void campo(const QString &texto)
+    {
+        const QByteArray utf8 = texto.toUtf8();
+        const bool aspas = utf8.contains(',') || utf8.contains('"')
+                        || utf8.contains('\n') || utf8.contains('\r');
+        if (!aspas) { m_buf += utf8; return; }
+        m_buf += '"';
+        for (const char c : utf8) {
+            if (c == '"') m_buf += '"';
+            m_buf += c;
+        }
+        m_buf += '"';
+    }
+
+    QByteArray m_buf;  // reaproveitado entre linhas
+};
+
+class EscritorJsonLines : public Escritor
+{
+public:
+    using Escritor::Escritor;
+
+    bool escrever(const Linha &l) override
+    {
+        m_buf.clear();
+        m_buf += "{\"tipo\":\"";
+        m_buf += l.tipo;
+        m_buf += "\",\"id\":";
+        m_buf += QByteArray::number(l.id);
+        m_buf += ",\"data\":\"";
+        m_buf += l.data.toLatin1();
+        m_buf += "\",\"descricao\":";
+        texto(l.descricao);
+        m_buf += ",\"valor_centavos\":";
+        m_buf += QByteArray::number(l.valorCentavos);
+        m_buf += ",\"categoria_id\":";
+        m_buf += QByteArray::number(l.categoriaId);
+        m_buf += ",\"categoria\":";
+        texto(l.categoria);
+        m_buf += "}\n";
+        return gravar(m_buf);
+    }
+
+private:
+    void texto(const QString &s)
+    {
+        m_buf += '"';
+        for (const char c : s.toUtf8()) {
+            switch (c) {
+            case '"':  m_buf += "\\\""; break;
+            case '\\': m_buf += "\\\\"; break;
+            case '\n': m_buf += "\\n";  break;
+            case '\r': m_buf += "\\r";  break;
+            case '\t': m_buf += "\\t";  break;
+            default:
+                if (uchar(c) < 0x20) {
+                    m_buf += "\\u00";
+                    m_buf += QByteArray::number(uchar(c), 16).rightJustified(2, '0');
+                } else {
+                    m_buf += c;
+                }
+            }
+        }
+        m_buf += '"';
+    }
+
+    QByteArray m_buf;
+};
+
+class EscritorColunar : public Escritor
+{
+public:
+    using Escritor::Escritor;
+
+    bool iniciar() override
+    {
+        QByteArray cab("ORCC");
+        anexar<quint16>(cab, 1);   // versão
+        anexar<quint16>(cab, 7);   // colunas
+        for (auto *col : {&m_descOffsets, &m_catOffsets})
+            col->reserve((LedgerExporter::LINHAS_POR_GRUPO + 1) * 4);
+        return gravar(cab);
+    }
+
+    bool escrever(const Linha &l) override
+    {
+        if (m_linhas == 0) {
+            anexar<quint32>(m_descOffsets, 0);
+            anexar<quint32>(m_catOffsets, 0);
+        }
+
+        const quint8 tipo = l.tipo == "entrada" ? 0 : l.tipo == "gasto_fixo" ? 1 : 2;
+        m_tipos.append(char(tipo));
+        anexar<qint64>(m_ids, l.id);
+        anexar<qint32>(m_datas, qint32(QDate::fromString(l.data, "yyyy-MM-dd").toJulianDay()
+                                       - EPOCA_JULIANA));
+        anexar<qint64>(m_valores, l.valorCentavos);
+        anexar<qint32>(m_categoriaIds, l.categoriaId);
+
+        m_descBytes += l.descricao.toUtf8();
+        anexar<quint32>(m_descOffsets, quint32(m_descBytes.size()));
+        m_catBytes += l.categoria.toUtf8();
+        anexar<quint32>(m_catOffsets, quint32(m_catBytes.size()));
+
+        return ++m_linhas < LedgerExporter::LINHAS_POR_GRUPO || descarregar();
+    }
+
+    bool finalizar() override
+    {
+        if (m_linhas > 0 && !descarregar()) return false;
+        QByteArray fim;
+        anexar<quint32>(fim, 0);
+        return gravar(fim);
+    }
+
+private:
+    static constexpr qint64 EPOCA_JULIANA = 2440588;  // 1970-01-01
+
+    template <typename T>
+    static void anexar(QByteArray &buf, T valor)
+    {
+        char bytes[sizeof(T)];
+        qToLittleEndian<T>(valor, bytes);
+        buf.append(bytes, sizeof(T));
+    }
+
+    bool coluna(const QByteArray &dados)
+    {
+        QByteArray tam;
+        anexar<quint32>(tam, quint32(dados.size()));
+        return gravar(tam) && gravar(dados);
+    }
+
+    bool coluna(const QByteArray &offsets, const QByteArray &bytes)
+    {
+        QByteArray tam;
+        anexar<quint32>(tam, quint32(offsets.size() + bytes.size()));
+        return gravar(tam) && gravar(offsets) && gravar(bytes);
+    }
+
+    // Grava o grupo e zera os buffers sem liberar a capacidade
+    bool descarregar()
+    {
+        QByteArray cab;
+        anexar<quint32>(cab, quint32(m_linhas));
+        const bool ok = gravar(cab)
+            && coluna(m_tipos) && coluna(m_ids) && coluna(m_datas)
+            && coluna(m_descOffsets, m_descBytes) && coluna(m_valores)
+            && coluna(m_categoriaIds) && coluna(m_catOffsets, m_catBytes);
+
+        for (auto *col : {&m_tipos, &m_ids, &m_datas, &m_descOffsets, &m_descBytes,
+                          &m_valores, &m_categoriaIds, &m_catOffsets, &m_catBytes})
+            col->resize(0);
+        m_linhas = 0;
+        return ok;
+    }
+
+    int        m_linhas = 0;
+    QByteArray m_tipos, m_ids, m_datas, m_valores, m_categoriaIds;
+    QByteArray m_descOffsets, m_descBytes, m_catOffsets, m_catBytes;
+};
+
+} // namespace
+
+// ── LedgerExporter ────────────────────────────────────────────────────────────
+
+LedgerExporter::LedgerExporter(const QString &caminhoBanco, const QString &destino,
+                               Formato formato, QObject *parent)
+    : QObject(parent)
+    , m_caminhoBanco(caminhoBanco)
+    , m_destino(destino)
+    , m_formato(formato)
+{
+}
+
+QString LedgerExporter::extensao(Formato formato)
+{
+    switch (formato) {
+    case Formato::Csv:       return "csv";
+    case Formato::JsonLines: return "jsonl";
+    default:                 return "orcc";
+    }
+}
+
+void LedgerExporter::executar()
+{
+    TRACE_SPAN("LedgerExporter::executar", "io");
+    const QString conexao = QString("exportador-%1").arg(quintptr(this));
+    QString erro;
+    bool ok = false;
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", conexao);
+        db.setDatabaseName(":memory:");
+
+        QFile arquivo(m_destino);
+        std::unique_ptr<Escritor> escritor;
+        switch (m_formato) {
+        case Formato::Csv:       escritor = std::make_unique<EscritorCsv>(arquivo);       break;
+        case Formato::JsonLines: escritor = std::make_unique<EscritorJsonLines>(arquivo); break;
+        case Formato::Colunar:   escritor = std::make_unique<EscritorColunar>(arquivo);   break;
+        }
+
+        if (!db.open()) {
+            erro = db.lastError().text();
+        } else if (!arquivo.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            erro = arquivo.errorString();
+        } else {
+            // Instantâneo em memória: um único CREATE TABLE AS lê o .db em
+            // uso (uma leitura consistente, lock compartilhado só durante a
+            // cópia) e o resto da exportação não toca mais nele
+            QSqlQuery q(db);
+            q.prepare("ATTACH DATABASE :origem AS origem");
+            q.bindValue(":origem", m_caminhoBanco);
+            ok = q.exec()
+              && q.exec(
+                "CREATE TABLE exportacao AS "
+                "SELECT 'entrada' AS tipo, e.id AS id, e.data AS data, e.origem AS descricao,"
+                "       e.valor_centavos AS valor_centavos, 0 AS categoria_id, '' AS categoria"
+                " FROM origem.entradas e"
+                " UNION ALL "
+                "SELECT 'gasto_fixo', gf.id, gf.data, gf.historico, gf.valor_centavos,"
+                "       gf.categoria_id, COALESCE(c.nome, '')"
+                " FROM origem.gastos_fixos gf LEFT JOIN origem.categorias c ON gf.categoria_id = c.id"
+                " UNION ALL "
+                "SELECT 'gasto_variavel', gv.id, gv.data, gv.historico, gv.valor_centavos,"
+                "       gv.categoria_id, COALESCE(c.nome, '')"
+                " FROM origem.gastos_variaveis gv LEFT JOIN origem.categorias c ON gv.categoria_id = c.id")
+              && q.exec("DETACH DATABASE origem");
+            if (!ok) erro = q.lastError().text();
+
+            q.exec("SELECT COUNT(*) FROM exportacao");
+            const qint64 total = q.next() ? q.value(0).toLongLong() : 0;
+            q.finish();
+            emit progresso(0, total);
+
+            // Cursor único, na ordem da cópia (rowid)
+            q.setForwardOnly(true);
+            if (ok) {
+                ok = q.exec("SELECT tipo, id, data, descricao, valor_centavos, categoria_id, categoria"
+                            " FROM exportacao");
+                if (!ok) erro = q.lastError().text();
+            }
+            ok = ok && escritor->iniciar();
+
+            Linha l;
+            qint64 exportadas = 0;
+            while (ok && q.next()) {
+                if (m_cancelado) { ok = false; erro = "Exportação cancelada."; break; }
+
+                l.tipo          = q.value(0).toByteArray();
+                l.id            = q.value(1).toLongLong();
+                l.data          = q.value(2).toString();
+                l.descricao     = q.value(3).toString();
+                l.valorCentavos = q.value(4).toLongLong();
+                l.categoriaId   = q.value(5).toInt();
+                l.categoria     = q.value(6).toString();
+                ok = escritor->escrever(l);
+
+                if (++exportadas % PROGRESSO_A_CADA == 0)
+                    emit progresso(exportadas, total);
+            }
+            ok = ok && escritor->finalizar();
+            if (ok) emit progresso(exportadas, total);
+            else if (erro.isEmpty()) erro = arquivo.errorString();
+        }
+
+        arquivo.close();
+        if (!ok) QFile::remove(m_destino);
+    }
+    QSqlDatabase::removeDatabase(conexao);
+
+    emit concluido(ok, erro);
+}
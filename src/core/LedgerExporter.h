@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+
+// Exporta entradas, gastos_fixos e gastos_variaveis (com o nome da categoria)
+// lendo por cursor forward-only, sem QList intermediária. Feito para rodar em
+// uma QThread própria: abre uma conexão :memory:, copia as linhas do .db em
+// uso (ATTACH + um CREATE TABLE AS, leitura consistente) e percorre a cópia.
+// O lock compartilhado no .db dura só a cópia — um cursor aberto nele até o
+// fim faria as edições esbarrarem em "database is locked" —, e nada em texto
+// claro vai para o disco além do próprio arquivo exportado.
+//
+// Colunas, em todos os formatos:
+//   tipo (entrada | gasto_fixo | gasto_variavel), id, data (yyyy-MM-dd),
+//   descricao, valor_centavos, categoria_id (0 em entradas), categoria
+//
+// Formato colunar (.orcc) — inteiros little-endian:
+//   "ORCC" | u16 versão (1) | u16 nº de colunas
+//   grupos de até LINHAS_POR_GRUPO linhas:
+//     u32 linhas | por coluna: u32 bytes + dados
+//       tipo: u8 · id: i64 · data: i32 (dias desde 1970-01-01)
+//       valor_centavos: i64 · categoria_id: i32
+//       descricao / categoria: u32 offsets[linhas + 1] + bytes UTF-8
+//   u32 0 — fim do arquivo
+class LedgerExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Formato { Csv, JsonLines, Colunar };
+
+    static constexpr int LINHAS_POR_GRUPO = 65536;
+
+    LedgerExporter(const QString &caminhoBanco, const QString &destino,
+                   Formato formato, QObject *parent = nullptr);
+
+    void cancelar() { m_cancelado = true; }
+
+    static QString extensao(Formato formato);
+
+public slots:
+    void executar();
+
+signals:
+    void progresso(qint64 exportadas, qint64 total);
+    void concluido(bool ok, const QString &erro);
+
+private:
+    QString           m_caminhoBanco;
+    QString           m_destino;
+    Formato           m_formato;
+    std::atomic<bool> m_cancelado{false};
+};
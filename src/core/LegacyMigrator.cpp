@@ -0,0 +1,324 @@
+#include "core/LegacyMigrator.h"
+
+#include "core/CryptoHelper.h"
+#include "core/DatabaseManager.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QStandardPaths>
+
+#include <cctype>
+#include <cstring>
+
+namespace LegacyMigrator {
+
+// ── Leitor JSON em streaming ──────────────────────────────────────────────────
+// Percorre o buffer decriptado uma única vez; cada registro é entregue assim
+// que seu objeto fecha, sem árvore QJsonValue para o arquivo inteiro.
+
+class LeitorJson
+{
+public:
+    explicit LeitorJson(const QByteArray &dados)
+        : m_p(dados.constData()), m_fim(dados.constData() + dados.size()) {}
+
+    bool consumir(char c)
+    {
+        pularEspacos();
+        if (m_p < m_fim && *m_p == c) { ++m_p; return true; }
+        return false;
+    }
+
+    bool proximoE(char c)
+    {
+        pularEspacos();
+        return m_p < m_fim && *m_p == c;
+    }
+
+    bool lerString(QString &saida)
+    {
+        saida.clear();
+        if (!consumir('"')) return false;
+
+        const char *inicio = m_p;
+        while (m_p < m_fim) {
+            const char c = *m_p;
+            if (c == '"') {
+                saida += QString::fromUtf8(inicio, m_p - inicio);
+                ++m_p;
+                return true;
+            }
+            if (c != '\\') { ++m_p; continue; }
+
+            saida += QString::fromUtf8(inicio, m_p - inicio);
+            if (++m_p >= m_fim) return false;
+            switch (*m_p++) {
+            case '"':  saida += '"';  break;
+            case '\\': saida += '\\'; break;
+            case '/':  saida += '/';  break;
+            case 'b':  saida += '\b'; break;
+            case 'f':  saida += '\f'; break;
+            case 'n':  saida += '\n'; break;
+            case 'r':  saida += '\r'; break;
+            case 't':  saida += '\t'; break;
+            case 'u': {
+                // Pares substitutos chegam como dois \u — cada um é uma unidade UTF-16
+                if (m_fim - m_p < 4) return false;
+                bool ok = false;
+                const ushort unidade = QByteArray(m_p, 4).toUShort(&ok, 16);
+                if (!ok) return false;
+                saida += QChar(unidade);
+                m_p += 4;
+                break;
+            }
+            default:
+                return false;
+            }
+            inicio = m_p;
+        }
+        return false;
+    }
+
+    // Números do legado são inteiros (centavos); tolera "1.5e+06" e strings
+    bool lerInteiro(qint64 &saida)
+    {
+        pularEspacos();
+        if (proximoE('"')) {
+            QString s;
+            bool ok = false;
+            if (!lerString(s)) return false;
+            saida = s.toLongLong(&ok);
+            return ok;
+        }
+        const char *inicio = m_p;
+        while (m_p < m_fim && (std::isdigit(uchar(*m_p)) || (*m_p && std::strchr("+-.eE", *m_p))))
+            ++m_p;
+        const QByteArray num(inicio, m_p - inicio);
+        bool ok = false;
+        saida = num.toLongLong(&ok);
+        if (!ok) saida = qRound64(num.toDouble(&ok));
+        return ok;
+    }
+
+    bool pularValor()
+    {
+        pularEspacos();
+        if (m_p >= m_fim) return false;
+        if (*m_p == '"') { QString s; return lerString(s); }
+        if (*m_p == '{' || *m_p == '[') {
+            const char fecha = *m_p == '{' ? '}' : ']';
+            ++m_p;
+            if (consumir(fecha)) return true;
+            do {
+                if (fecha == '}') {
+                    QString chave;
+                    if (!lerString(chave) || !consumir(':')) return false;
+                }
+                if (!pularValor()) return false;
+            } while (consumir(','));
+            return consumir(fecha);
+        }
+        // número, true, false, null
+        while (m_p < m_fim && *m_p && !std::strchr(",}] \t\r\n", *m_p)) ++m_p;
+        return true;
+    }
+
+private:
+    void pularEspacos()
+    {
+        while (m_p < m_fim && (*m_p == ' ' || *m_p == '\n' || *m_p == '\r' || *m_p == '\t'))
+            ++m_p;
+    }
+
+    const char *m_p;
+    const char *m_fim;
+};
+
+// ── Migração ──────────────────────────────────────────────────────────────────
+
+struct RegistroLegado {
+    QString data;
+    QString descricao;   // "origem" em entradas, "historico" em gastos
+    QString tipo;        // nome da categoria em gastos
+    qint64  valorCentavos = 0;
+};
+
+static QDate lerData(const QString &texto)
+{
+    // O legado gravava yyyy-MM-dd, mas a célula era editável livremente
+    for (const char *formato : {"yyyy-MM-dd", "dd/MM/yyyy"}) {
+        const QDate d = QDate::fromString(texto.trimmed(), formato);
+        if (d.isValid()) return d;
+    }
+    return {};
+}
+
+static bool lerRegistro(LeitorJson &json, RegistroLegado &reg)
+{
+    reg = {};
+    if (!json.consumir('{')) return false;
+    if (json.consumir('}')) return true;
+
+    QString chave;
+    do {
+        if (!json.lerString(chave) || !json.consumir(':')) return false;
+        bool ok = true;
+        if (chave == "data")                                  ok = json.lerString(reg.data);
+        else if (chave == "origem" || chave == "historico")   ok = json.lerString(reg.descricao);
+        else if (chave == "tipo")                             ok = json.lerString(reg.tipo);
+        else if (chave == "valor_centavos")                   ok = json.lerInteiro(reg.valorCentavos);
+        else                                                  ok = json.pularValor();
+        if (!ok) return false;
+    } while (json.consumir(','));
+    return json.consumir('}');
+}
+
+QString localizarArquivoLegado()
+{
+    // A versão 0.1 não definia applicationName/organizationName: o diretório
+    // era derivado do nome do executável
+    const QString base = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation);
+    const QStringList candidatos = {
+        base + "/orcamento-pessoal/orcamento.enc",
+        base + "/orcamento_pessoal/orcamento.enc",
+        base + "/" + QFileInfo(QCoreApplication::applicationFilePath()).fileName() + "/orcamento.enc",
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/orcamento.enc",
+    };
+    for (const QString &c : candidatos)
+        if (QFile::exists(c)) return c;
+    return {};
+}
+
+Resultado migrar(const QString &caminho, const QString &senha)
+{
+    Resultado res;
+
+    QFile arquivo(caminho);
+    if (!arquivo.open(QIODevice::ReadOnly)) {
+        res.erro = arquivo.errorString();
+        return res;
+    }
+    const QByteArray dados = arquivo.readAll();
+    arquivo.close();
+    if (dados.size() <= CryptoHelper::SALT_LENGTH) {
+        res.erro = "Arquivo legado vazio ou truncado.";
+        return res;
+    }
+
+    QByteArray chave, iv;
+    if (!CryptoHelper::derivarChaveEIV(dados.left(CryptoHelper::SALT_LENGTH), senha, chave, iv)) {
+        res.erro = "Falha ao derivar a chave.";
+        return res;
+    }
+    const QByteArray json = CryptoHelper::decrypt(dados.mid(CryptoHelper::SALT_LENGTH), chave, iv);
+    if (json.isEmpty()) {
+        res.senhaIncorreta = true;
+        res.erro = "Senha incorreta ou arquivo corrompido.";
+        return res;
+    }
+
+    auto &db = DatabaseManager::instance();
+
+    QHash<QString, int> categorias;
+    for (const Categoria &cat : db.listarCategorias())
+        categorias.insert(cat.nome, cat.id);
+
+    auto categoriaId = [&](const QString &nome) -> int {
+        const QString n = nome.trimmed().isEmpty() ? QStringLiteral("Outros") : nome.trimmed();
+        if (const auto it = categorias.constFind(n); it != categorias.cend()) return it.value();
+        Categoria cat;
+        cat.nome = n;
+        if (!db.inserirCategoria(cat)) return 0;
+        ++res.categoriasCriadas;
+        categorias.insert(n, cat.id);
+        return cat.id;
+    };
+
+    LeitorJson leitor(json);
+    db.iniciarLote();
+
+    auto falhar = [&](const QString &erro) {
+        db.cancelarLote();
+        res = {};
+        res.erro = erro;
+        return res;
+    };
+
+    if (!leitor.consumir('{')) return falhar("JSON legado inválido.");
+
+    QString chaveRaiz;
+    RegistroLegado reg;
+    bool vazio = leitor.consumir('}');
+    while (!vazio) {
+        if (!leitor.lerString(chaveRaiz) || !leitor.consumir(':'))
+            return falhar("JSON legado inválido.");
+
+        if (chaveRaiz == "categorias_gastos_fixos") {
+            if (!leitor.consumir('[')) return falhar("JSON legado inválido.");
+            if (!leitor.consumir(']')) {
+                QString nome;
+                do {
+                    if (!leitor.lerString(nome)) return falhar("JSON legado inválido.");
+                    categoriaId(nome);
+                } while (leitor.consumir(','));
+                if (!leitor.consumir(']')) return falhar("JSON legado inválido.");
+            }
+        } else if (chaveRaiz == "entradas" || chaveRaiz == "gastos_fixos"
+                   || chaveRaiz == "gastos_variaveis") {
+            if (!leitor.consumir('[')) return falhar("JSON legado inválido.");
+            if (!leitor.consumir(']')) {
+                do {
+                    if (!lerRegistro(leitor, reg)) return falhar("JSON legado inválido.");
+
+                    const QDate data = lerData(reg.data);
+                    if (!data.isValid()) { ++res.ignorados; continue; }
+
+                    bool ok = false;
+                    if (chaveRaiz == "entradas") {
+                        Entrada e{0, reg.descricao, reg.valorCentavos, data};
+                        ok = db.inserirEntrada(e);
+                        res.entradas += ok;
+                    } else if (chaveRaiz == "gastos_fixos") {
+                        GastoFixo g{0, reg.descricao, reg.valorCentavos, data,
+                                    categoriaId(reg.tipo), {}};
+                        ok = db.inserirGastoFixo(g);
+                        res.gastosFixos += ok;
+                    } else {
+                        GastoVariavel g{0, reg.descricao, reg.valorCentavos, data,
+                                        categoriaId(reg.tipo), {}};
+                        ok = db.inserirGastoVariavel(g);
+                        res.gastosVariaveis += ok;
+                    }
+                    if (!ok) return falhar("Falha ao gravar registro legado.");
+                } while (leitor.consumir(','));
+                if (!leitor.consumir(']')) return falhar("JSON legado inválido.");
+            }
+        } else if (!leitor.pularValor()) {
+            return falhar("JSON legado inválido.");
+        }
+
+        if (leitor.consumir(',')) continue;
+        if (!leitor.consumir('}')) return falhar("JSON legado inválido.");
+        vazio = true;
+    }
+
+    if (!db.concluirLote()) {
+        res = {};
+        res.erro = "Falha ao salvar o banco.";
+        return res;
+    }
+    res.ok = true;
+    return res;
+}
+
+bool marcarComoMigrado(const QString &caminho)
+{
+    const QString destino = caminho + ".migrado";
+    QFile::remove(destino);
+    return QFile::rename(caminho, destino);
+}
+
+} // namespace LegacyMigrator
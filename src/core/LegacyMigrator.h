@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QString>
+
+// Migração do formato da versão 0.1 (main.cpp monolítico): um único JSON
+// indentado, criptografado em AppLocalDataLocation/orcamento.enc com o mesmo
+// esquema salt + AES-256-CBC/PBKDF2 do CryptoHelper.
+namespace LegacyMigrator {
+
+struct Resultado {
+    bool ok               = false;
+    bool senhaIncorreta   = false;
+    int  entradas         = 0;
+    int  gastosFixos      = 0;
+    int  gastosVariaveis  = 0;
+    int  categoriasCriadas = 0;
+    int  ignorados        = 0;  // registros sem data válida
+    QString erro;
+};
+
+// Caminho do orcamento.enc legado, ou vazio se não houver
+QString localizarArquivoLegado();
+
+// Decripta, lê os arrays do JSON em streaming (sem montar QJsonDocument) e
+// insere tudo no banco conectado em um único lote
+Resultado migrar(const QString &caminho, const QString &senha);
+
+// Renomeia o arquivo legado para *.migrado — preserva o original sem
+// oferecer a migração de novo
+bool marcarComoMigrado(const QString &caminho);
+
+} // namespace LegacyMigrator
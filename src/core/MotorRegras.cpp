@@ -0,0 +1,108 @@
+#include "core/MotorRegras.h"
+
+#include "utils/Fingerprint.h"
+
+#include <QDebug>
+#include <QStringList>
+
+static constexpr auto OPCOES_REGEX = QRegularExpression::CaseInsensitiveOption
+                                   | QRegularExpression::UseUnicodePropertiesOption;
+
+// O texto testado vem de normalizarDescricao(): sem acentos e minúsculo. O
+// padrão perde os acentos do mesmo jeito ("farmácia" casa "Farmacia"); as
+// maiúsculas ficam com CaseInsensitiveOption, porque baixá-las trocaria o
+// sentido de escapes como \S, \W ou \D.
+static QString normalizarPadrao(const QString &padrao)
+{
+    const QString decomposto = padrao.normalized(QString::NormalizationForm_D);
+    QString saida;
+    saida.reserve(decomposto.size());
+    for (const QChar c : decomposto)
+        if (c.category() != QChar::Mark_NonSpacing) saida.append(c);
+    return saida;
+}
+
+void MotorRegras::compilar(const QList<RegraCategoria> &regras)
+{
+    m_regras.clear();
+    m_expressoes.clear();
+    m_faixas.clear();
+    m_combinada = QRegularExpression();
+
+    QStringList substrings;
+    QStringList alternativas;
+    for (const RegraCategoria &r : regras) {
+        const qsizetype indice = m_regras.size();
+        m_regras.append({r.categoriaId, r.valorMinCentavos, r.valorMaxCentavos});
+        substrings.append(r.tipo == RegraCategoria::Tipo::Contem
+                          ? normalizarDescricao(r.padrao) : QString());
+
+        if (r.tipo == RegraCategoria::Tipo::Faixa) {
+            m_faixas.append(indice);
+        } else if (r.tipo == RegraCategoria::Tipo::Regex) {
+            const QString padrao = normalizarPadrao(r.padrao);
+            QRegularExpression re(padrao, OPCOES_REGEX);
+            if (!re.isValid()) {
+                qDebug() << "MotorRegras: regra" << r.id << "com regex inválida:" << re.errorString();
+                continue;
+            }
+            re.optimize();
+            // Com grupos de captura (e possíveis retrorreferências), a numeração
+            // mudaria dentro da alternação — essa regra é sempre testada sozinha
+            const bool combinavel = re.captureCount() == 0;
+            if (combinavel) alternativas.append("(?:" + padrao + ")");
+            m_expressoes.append({indice, re, combinavel});
+        }
+    }
+
+    m_substrings.construir(substrings);
+    if (!alternativas.isEmpty()) {
+        m_combinada = QRegularExpression(alternativas.join('|'), OPCOES_REGEX);
+        m_combinada.optimize();
+        if (!m_combinada.isValid()) {  // sem pré-filtro: todas testadas sozinhas
+            for (Expressao &e : m_expressoes) e.naCombinada = false;
+        }
+    }
+}
+
+bool MotorRegras::naFaixa(qsizetype indice, qint64 valorCentavos) const
+{
+    const Regra &r = m_regras[indice];
+    return (r.minimo == 0 || valorCentavos >= r.minimo)
+        && (r.maximo == 0 || valorCentavos <= r.maximo);
+}
+
+int MotorRegras::categorizar(const QString &descricao, qint64 valorCentavos) const
+{
+    if (m_regras.isEmpty()) return 0;
+
+    // Índice da melhor regra até aqui; cada etapa só procura abaixo dele
+    qsizetype melhor = m_regras.size();
+    const QString texto = normalizarDescricao(descricao);
+
+    m_substrings.buscar(texto, [&](int i) {
+        if (i < melhor && naFaixa(i, valorCentavos)) melhor = i;
+    });
+
+    if (!m_expressoes.isEmpty()) {
+        const bool algumaCombinada = m_combinada.isValid() && m_combinada.match(texto).hasMatch();
+        for (const Expressao &e : m_expressoes) {
+            if (e.indice >= melhor) break;
+            if (e.naCombinada && !algumaCombinada) continue;
+            if (naFaixa(e.indice, valorCentavos) && e.re.match(texto).hasMatch()) {
+                melhor = e.indice;
+                break;
+            }
+        }
+    }
+
+    for (const qsizetype i : m_faixas) {
+        if (i >= melhor) break;
+        if (naFaixa(i, valorCentavos)) {
+            melhor = i;
+            break;
+        }
+    }
+
+    return melhor < m_regras.size() ? m_regras[melhor].categoriaId : 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "models/RegraCategoria.h"
+#include "utils/AhoCorasick.h"
+
+#include <QList>
+#include <QRegularExpression>
+#include <QString>
+#include <QtGlobal>
+
+// Conjunto de regras de categorização compilado para avaliação em lote.
+// Vence a primeira regra, na ordem recebida, cujo padrão casa e cujo valor
+// está na faixa. Padrões casam com a descrição normalizada (minúsculas, sem
+// acentos — ver normalizarDescricao), e também perdem os acentos; as regex
+// ignoram maiúsculas:
+//   - Contem: todos os padrões em um único autômato de Aho-Corasick;
+//   - Regex:  uma alternação de todas decide em uma passada se alguma casa,
+//             e só então cada uma é testada, até a melhor já encontrada;
+//   - Faixa:  só o valor.
+class MotorRegras
+{
+public:
+    void compilar(const QList<RegraCategoria> &regras);
+
+    // Categoria da regra vencedora; 0 se nenhuma casa
+    int categorizar(const QString &descricao, qint64 valorCentavos) const;
+
+    bool vazio() const { return m_regras.isEmpty(); }
+
+private:
+    struct Regra {
+        int    categoriaId = 0;
+        qint64 minimo      = 0;
+        qint64 maximo      = 0;
+    };
+    struct Expressao {
+        qsizetype          indice = 0;
+        QRegularExpression re;
+        bool               naCombinada = false;  // coberta pelo pré-filtro
+    };
+
+    bool naFaixa(qsizetype indice, qint64 valorCentavos) const;
+
+    QList<Regra>       m_regras;       // na ordem de prioridade
+    AhoCorasick        m_substrings;   // padrão i = regra i (vazio se não for Contem)
+    QList<Expressao>   m_expressoes;   // ordenadas por índice
+    QRegularExpression m_combinada;
+    QList<qsizetype>   m_faixas;       // índices das regras Faixa
+};
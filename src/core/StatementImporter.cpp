@@ -0,0 +1,152 @@
+#include "core/StatementImporter.h"
+
+#include "core/DatabaseManager.h"
+#include "utils/CurrencyUtils.h"
+#include "utils/Fingerprint.h"
+
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+
+namespace StatementImporter {
+
+static QDate lerData(const QString &texto)
+{
+    const QString t = texto.trimmed();
+    for (const char *formato : {"dd/MM/yyyy", "yyyy-MM-dd", "dd/MM/yy"}) {
+        const QDate d = QDate::fromString(t, formato);
+        if (d.isValid()) return d;
+    }
+    return {};
+}
+
+// Extratos trazem débitos como "-45,90" (ou "45,90-"): o valor volta sem
+// sinal e `debito` diz a direção
+static bool lerValor(const QString &texto, qint64 &centavos, bool &debito)
+{
+    QString t = texto.trimmed();
+    t.remove('"');
+    debito = t.startsWith('-') || t.endsWith('-');
+    t.remove('-');
+    if (t.isEmpty()) return false;
+    for (const QChar c : t)
+        if (!c.isDigit() && !QStringLiteral(".,R$ ").contains(c)) return false;
+    centavos = textoParaCentavos(t);
+    return true;
+}
+
+static QStringList dividirCampos(const QString &linha, QChar separador)
+{
+    QStringList campos;
+    QString atual;
+    bool aspas = false;
+    for (const QChar c : linha) {
+        if (c == '"') { aspas = !aspas; continue; }
+        if (c == separador && !aspas) { campos.append(atual); atual.clear(); continue; }
+        atual.append(c);
+    }
+    campos.append(atual);
+    return campos;
+}
+
+Resultado importarCsv(const QString &caminho, TipoLancamento destino, int categoriaId)
+{
+    Resultado res;
+
+    QFile arquivo(caminho);
+    if (!arquivo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        res.erro = arquivo.errorString();
+        return res;
+    }
+
+    auto &db = DatabaseManager::instance();
+
+    // Duplicatas legítimas (duas compras iguais no mesmo dia) existem: a n-ésima
+    // ocorrência de uma impressão no arquivo só é pulada se o banco já tinha n
+    QHash<quint64, int> existentes;
+    QHash<quint64, int> vistas;
+
+    db.iniciarLote();
+
+    QTextStream in(&arquivo);
+    while (!in.atEnd()) {
+        const QString linha = in.readLine();
+        if (linha.trimmed().isEmpty()) continue;
+
+        const QChar separador = linha.count(';') >= 2 ? ';' : ',';
+        const QStringList campos = dividirCampos(linha, separador);
+        if (campos.size() < 3) { ++res.invalidos; continue; }
+
+        const QDate   data      = lerData(campos.at(0));
+        const QString descricao = campos.at(1).trimmed();
+        qint64 valor  = 0;
+        bool   debito = false;
+        if (!data.isValid() || !lerValor(campos.at(2), valor, debito)) {
+            ++res.invalidos;  // inclui o cabeçalho, se houver
+            continue;
+        }
+        if (debito != (destino != TipoLancamento::Entrada)) {
+            ++res.opostos;  // estorno/depósito entre os gastos, ou o contrário
+            continue;
+        }
+
+        const quint64 hash = impressaoDigital(int(destino), data, valor, descricao);
+        if (!existentes.contains(hash))
+            existentes.insert(hash, db.contarDuplicatas(destino, data, valor, descricao));
+        if (++vistas[hash] <= existentes.value(hash)) {
+            ++res.duplicados;
+            continue;
+        }
+
+        // Regras compiladas (uma passada pela descrição, qualquer que seja o
+        // número delas); sem regra, o classificador, se estiver confiante
+        int categoria = categoriaId;
+        if (destino != TipoLancamento::Entrada) {
+            if (const int porRegra = db.categorizar(descricao, valor); porRegra > 0) {
+                categoria = porRegra;
+                ++res.categorizados;
+            } else if (const auto palpite = db.preverCategoria(descricao);
+                       palpite.confianca >= ClassificadorBayes::CONFIANCA_MINIMA) {
+                categoria = palpite.categoriaId;
+                ++res.previstos;
+            }
+            if (db.avaliarGasto(categoria, descricao, valor, false).anomalo)
+                ++res.atipicos;
+        }
+
+        bool ok = false;
+        switch (destino) {
+        case TipoLancamento::Entrada: {
+            Entrada e{0, descricao, valor, data};
+            ok = db.inserirEntrada(e);
+            break;
+        }
+        case TipoLancamento::GastoFixo: {
+            GastoFixo g{0, descricao, valor, data, categoria, {}};
+            ok = db.inserirGastoFixo(g);
+            break;
+        }
+        case TipoLancamento::GastoVariavel: {
+            GastoVariavel g{0, descricao, valor, data, categoria, {}};
+            ok = db.inserirGastoVariavel(g);
+            break;
+        }
+        }
+        if (!ok) {
+            db.cancelarLote();
+            res.erro = "Falha ao gravar a linha: " + linha;
+            return res;
+        }
+        ++res.importados;
+    }
+
+    if (!db.concluirLote()) {
+        res.erro = "Falha ao salvar o banco.";
+        return res;
+    }
+    res.ok = true;
+    return res;
+}
+
+} // namespace StatementImporter
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "models/Lancamento.h"
+
+#include <QString>
+
+namespace StatementImporter {
+
+struct Resultado {
+    bool ok            = false;
+    int  importados    = 0;
+    int  duplicados    = 0;  // já presentes no banco — ignorados
+    int  invalidos     = 0;  // linhas sem data/valor reconhecíveis
+    int  opostos       = 0;  // sinal oposto ao destino (crédito entre gastos) — ignorados
+    int  categorizados = 0;  // gastos cuja categoria veio de uma regra
+    int  previstos     = 0;  // ... ou do classificador aprendido
+    int  atipicos      = 0;  // gastos muito acima do habitual (DetectorAnomalias)
+    QString erro;
+};
+
+// Importa um extrato CSV (data;descrição;valor — separador ';' ou ',') para a
+// tabela de `destino`. Débitos vêm negativos ("-45,90"): num destino de gastos
+// só eles entram, numa Entrada só os positivos; as linhas de sinal oposto são
+// contadas em `opostos` e ignoradas. Linhas cuja impressão digital já existe
+// no banco são puladas; tudo é gravado em um único lote (uma transação, um
+// salvamento).
+// Gastos recebem a categoria das regras de categorização ou, sem regra, a do
+// classificador aprendido; `categoriaId` fica para as linhas sem nenhuma das
+// duas e é ignorado quando destino == Entrada. Cada gasto é avaliado contra
+// as médias do histórico antes de gravado — as linhas anteriores do próprio
+// extrato já contam —, sem reler o banco.
+Resultado importarCsv(const QString &caminho, TipoLancamento destino, int categoriaId);
+
+} // namespace StatementImporter
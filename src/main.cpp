@@ -2,12 +2,58 @@
 #include "ui/PasswordDialog.h"
 #include "ui/Theme.h"
 #include "core/DatabaseManager.h"
+#include "core/LegacyMigrator.h"
+#include "utils/Tracer.h"
 
 #include <QApplication>
+#include <QInputDialog>
+#include <QLineEdit>
 #include <QMessageBox>
 
+// Dados da versão 0.1 (JSON monolítico): oferece trazê-los para o banco novo
+static void oferecerMigracaoLegada(const QString &senha)
+{
+    const QString legado = LegacyMigrator::localizarArquivoLegado();
+    if (legado.isEmpty() || DatabaseManager::instance().possuiLancamentos())
+        return;
+
+    const auto resp = QMessageBox::question(
+        nullptr, "Dados da versão anterior",
+        "Foi encontrado um arquivo da versão anterior do Orçamento Pessoal:\n"
+        + legado + "\n\nImportar entradas, gastos e categorias para este usuário?",
+        QMessageBox::Yes | QMessageBox::No);
+    if (resp != QMessageBox::Yes) return;
+
+    // Tenta a senha do login; se não servir, pede a senha antiga
+    auto res = LegacyMigrator::migrar(legado, senha);
+    while (!res.ok && res.senhaIncorreta) {
+        bool ok = false;
+        const QString senhaAntiga = QInputDialog::getText(
+            nullptr, "Dados da versão anterior",
+            "Senha do arquivo da versão anterior:", QLineEdit::Password, QString(), &ok);
+        if (!ok) return;
+        res = LegacyMigrator::migrar(legado, senhaAntiga);
+    }
+
+    if (!res.ok) {
+        QMessageBox::warning(nullptr, "Dados da versão anterior",
+            "Não foi possível importar os dados.\n\n" + res.erro);
+        return;
+    }
+
+    LegacyMigrator::marcarComoMigrado(legado);
+    QMessageBox::information(nullptr, "Dados da versão anterior",
+        QString("Importação concluída:\n"
+                "%1 entrada(s), %2 gasto(s) fixo(s), %3 gasto(s) variável(is).\n"
+                "%4 categoria(s) criada(s), %5 registro(s) sem data válida ignorado(s).")
+            .arg(res.entradas).arg(res.gastosFixos).arg(res.gastosVariaveis)
+            .arg(res.categoriasCriadas).arg(res.ignorados));
+}
+
 int main(int argc, char *argv[])
 {
+    Tracer::inicializar();  // ORCAMENTO_TRACE=<arquivo.json>
+
     QApplication app(argc, argv);
     app.setApplicationName("Orçamento Pessoal");
     app.setOrganizationName("petrinhu");
@@ -25,7 +71,10 @@ int main(int argc, char *argv[])
             dlg.senha()
         );
 
-        if (ok) break;
+        if (ok) {
+            oferecerMigracaoLegada(dlg.senha());
+            break;
+        }
 
         QMessageBox::critical(
             nullptr,
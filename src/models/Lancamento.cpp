@@ -0,0 +1 @@
+#include "models/Lancamento.h"
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QtGlobal>
+
+// Tabela de origem de um lançamento
+enum class TipoLancamento {
+    Entrada,
+    GastoFixo,
+    GastoVariavel
+};
+
+// Visão genérica de uma linha de entradas / gastos_fixos / gastos_variaveis
+struct Lancamento {
+    int            id            = 0;
+    TipoLancamento tipo          = TipoLancamento::GastoVariavel;
+    QString        descricao;        // origem (entradas) ou historico (gastos)
+    qint64         valorCentavos = 0;
+    QDate          data;
+    int            categoriaId   = 0; // 0 para entradas
+};
@@ -0,0 +1,43 @@
+#include "models/Parcelamento.h"
+
+#include <algorithm>
+
+qint64 Parcelamento::valorParcela(int k) const
+{
+    if (parcelas <= 0 || k < 0 || k >= parcelas) return 0;
+    return totalCentavos / parcelas + (k < totalCentavos % parcelas ? 1 : 0);
+}
+
+// base × quantidade + as parcelas de [de, ate] entre as `resto` primeiras
+qint64 Parcelamento::somaParcelas(int de, int ate) const
+{
+    de  = std::max(de, 0);
+    ate = std::min(ate, quantidadeVigente() - 1);
+    if (parcelas <= 0 || de > ate) return 0;
+
+    const qint64 base  = totalCentavos / parcelas;
+    const qint64 resto = totalCentavos % parcelas;
+    const qint64 extra = std::max<qint64>(0, std::min<qint64>(ate, resto - 1) - de + 1);
+    return base * (ate - de + 1) + extra;
+}
+
+// A parcela do mês de `data` é a de índice = meses entre as datas; ela pode
+// vencer antes ou depois de `data` dentro do mesmo mês
+int Parcelamento::mesesEntre(const QDate &a, const QDate &b)
+{
+    return (b.year() - a.year()) * 12 + b.month() - a.month();
+}
+
+void Parcelamento::parcelasEntre(const QDate &inicio, const QDate &fim, int &de, int &ate) const
+{
+    de  = 0;
+    ate = quantidadeVigente() - 1;
+    if (inicio.isValid()) {
+        const int k = mesesEntre(primeiraData, inicio);
+        de = std::max(de, dataParcela(k) < inicio ? k + 1 : k);
+    }
+    if (fim.isValid()) {
+        const int k = mesesEntre(primeiraData, fim);
+        ate = std::min(ate, dataParcela(k) > fim ? k - 1 : k);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QtGlobal>
+
+// Compra parcelada: só o plano é gravado. A parcela k (0-based) vence em
+// primeiraData + k meses (último dia nos meses mais curtos) e vale
+// total / N, com o resto da divisão distribuído um centavo por parcela a partir
+// da primeira — a soma das N parcelas é sempre o total, sem arredondar.
+// Encerrado antes do fim, só as `vigentes` primeiras vencem; os valores delas
+// não mudam, porque continuam calculados sobre o plano de N parcelas.
+struct Parcelamento {
+    int     id            = 0;
+    QString historico;
+    qint64  totalCentavos = 0;
+    int     parcelas      = 1;
+    QDate   primeiraData;
+    int     categoriaId   = 0;
+    QString categoriaNome;  // preenchido via JOIN ao carregar do banco
+    int     vigentes      = 0;  // 0 = todas; menos que `parcelas` se encerrado
+
+    int    quantidadeVigente() const { return vigentes > 0 && vigentes < parcelas ? vigentes : parcelas; }
+    bool   encerrado() const { return quantidadeVigente() < parcelas; }
+    QDate  ultimaData() const { return dataParcela(quantidadeVigente() - 1); }
+    QDate  dataParcela(int k) const { return primeiraData.addMonths(k); }
+    qint64 valorParcela(int k) const;
+
+    // Id da parcela k nas agregações em memória (cache analítico): negativo,
+    // nunca colide com o id de um gasto variável
+    int    idParcela(int k) const { return -(id * 256 + k + 1); }
+
+    // Meses do calendário de `a` até `b` (a parcela do mês de `b` é essa)
+    static int mesesEntre(const QDate &a, const QDate &b);
+
+    // Soma das parcelas k ∈ [de, ate] em O(1); intervalo vazio = 0
+    qint64 somaParcelas(int de, int ate) const;
+
+    // Índices das parcelas vigentes que vencem em [inicio, fim] (datas
+    // inválidas = sem limite), em O(1) pela distância em meses; de > ate se nenhuma
+    void parcelasEntre(const QDate &inicio, const QDate &fim, int &de, int &ate) const;
+};
+
+// Uma parcela calculada de um Parcelamento — existe só em memória
+struct Parcela {
+    int     parcelamentoId = 0;
+    int     numero         = 0;  // 1-based
+    int     parcelas       = 0;
+    QDate   data;
+    QString historico;
+    qint64  valorCentavos  = 0;
+    int     categoriaId    = 0;
+    QString categoriaNome;
+};
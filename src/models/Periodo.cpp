@@ -0,0 +1 @@
+#include "models/Periodo.h"
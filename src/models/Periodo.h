@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QDate>
+#include <QtGlobal>
+
+// Intervalo de datas aplicado a todas as abas (SeletorPeriodo, no topo da
+// janela). Fechado nas duas pontas; data inválida = sem limite daquele lado.
+struct Periodo {
+    enum class Tipo { Tudo, Mes, Trimestre, Ano, Personalizado };
+
+    Tipo  tipo = Tipo::Tudo;
+    QDate inicio;
+    QDate fim;
+
+    bool limitado() const { return inicio.isValid() || fim.isValid(); }
+
+    bool contem(const QDate &data) const
+    {
+        return (!inicio.isValid() || data >= inicio) && (!fim.isValid() || data <= fim);
+    }
+
+    static Periodo mes(const QDate &referencia)
+    {
+        const QDate primeiro(referencia.year(), referencia.month(), 1);
+        return {Tipo::Mes, primeiro, primeiro.addMonths(1).addDays(-1)};
+    }
+
+    static Periodo trimestre(const QDate &referencia)
+    {
+        const QDate primeiro(referencia.year(), (referencia.month() - 1) / 3 * 3 + 1, 1);
+        return {Tipo::Trimestre, primeiro, primeiro.addMonths(3).addDays(-1)};
+    }
+
+    static Periodo ano(const QDate &referencia)
+    {
+        return {Tipo::Ano, QDate(referencia.year(), 1, 1), QDate(referencia.year(), 12, 31)};
+    }
+
+    static Periodo personalizado(const QDate &a, const QDate &b)
+    {
+        return {Tipo::Personalizado, qMin(a, b), qMax(a, b)};
+    }
+
+    // O mesmo tipo de período `passos` vezes adiante (negativo = para trás);
+    // personalizado anda o próprio tamanho; Tudo não muda
+    Periodo deslocado(int passos) const
+    {
+        switch (tipo) {
+        case Tipo::Tudo:          return *this;
+        case Tipo::Mes:           return mes(inicio.addMonths(passos));
+        case Tipo::Trimestre:     return trimestre(inicio.addMonths(3 * passos));
+        case Tipo::Ano:           return ano(inicio.addYears(passos));
+        case Tipo::Personalizado: break;
+        }
+        const qint64 dias = (inicio.daysTo(fim) + 1) * passos;
+        return personalizado(inicio.addDays(dias), fim.addDays(dias));
+    }
+
+    bool operator==(const Periodo &) const = default;
+};
@@ -0,0 +1,17 @@
+#include "models/Recorrencia.h"
+
+#include <algorithm>
+
+QList<QDate> Recorrencia::datasEntre(const QDate &de, const QDate &ate) const
+{
+    QList<QDate> datas;
+    const QDate primeira = std::max(de, inicio);
+    const QDate ultima   = fim.isValid() ? std::min(ate, fim) : ate;
+    if (!primeira.isValid() || !ultima.isValid() || primeira > ultima) return datas;
+
+    for (QDate mes(primeira.year(), primeira.month(), 1); mes <= ultima; mes = mes.addMonths(1)) {
+        const QDate data(mes.year(), mes.month(), std::min(dia, mes.daysInMonth()));
+        if (data >= primeira && data <= ultima) datas.append(data);
+    }
+    return datas;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QDate>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+// Gasto fixo que se repete todo mês (aluguel, assinaturas). Só a regra é
+// gravada; as ocorrências de um período são calculadas na consulta e viram
+// gastos fixos apenas quando confirmadas.
+struct Recorrencia {
+    int     id            = 0;
+    QString historico;
+    qint64  valorCentavos = 0;
+    int     dia           = 1;  // 1–31; em meses mais curtos, o último dia
+    int     categoriaId   = 0;
+    QDate   inicio;             // primeira ocorrência possível
+    QDate   fim;                // inválida = sem fim
+    QString categoriaNome;      // preenchido via JOIN ao carregar do banco
+
+    // Datas das ocorrências em [de, ate] ∩ [inicio, fim], uma por mês
+    QList<QDate> datasEntre(const QDate &de, const QDate &ate) const;
+};
+
+// Uma ocorrência ainda não confirmada nem dispensada — existe só em memória
+struct Ocorrencia {
+    int     recorrenciaId = 0;
+    QDate   data;
+    QString historico;
+    qint64  valorCentavos = 0;
+    int     categoriaId   = 0;
+    QString categoriaNome;
+};
@@ -0,0 +1 @@
+#include "models/RegraCategoria.h"
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+// Regra de categorização automática: descrição (e, opcionalmente, faixa de
+// valor) → categoria. Aplicada na digitação do histórico e na importação.
+struct RegraCategoria {
+    enum class Tipo { Contem = 0, Regex = 1, Faixa = 2 };  // valores persistidos
+
+    int     id               = 0;
+    Tipo    tipo             = Tipo::Contem;
+    QString padrao;                 // vazio em Faixa
+    qint64  valorMinCentavos = 0;   // 0 = sem limite
+    qint64  valorMaxCentavos = 0;   // 0 = sem limite
+    int     categoriaId      = 0;
+    QString categoriaNome;          // preenchido via JOIN ao carregar do banco
+};
@@ -0,0 +1,172 @@
+#include "ui/CalendarioWidget.h"
+
+#include "core/DatabaseManager.h"
+#include "ui/MapaCalor.h"
+#include "utils/CurrencyUtils.h"
+#include "utils/Tracer.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+static constexpr int COL_TIPO      = 0;
+static constexpr int COL_HISTORICO = 1;
+static constexpr int COL_CATEGORIA = 2;
+static constexpr int COL_VALOR     = 3;
+
+static QTableWidgetItem *makeItem(const QString &texto)
+{
+    auto *item = new QTableWidgetItem(texto);
+    item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+    return item;
+}
+
+// ── Construtor ────────────────────────────────────────────────────────────────
+
+CalendarioWidget::CalendarioWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    auto *root = new QVBoxLayout(this);
+    root->setContentsMargins(24, 24, 24, 16);
+    root->setSpacing(12);
+
+    // ── Cabeçalho ─────────────────────────────────────────────────────────────
+    auto *titulo = new QLabel("Gastos por dia");
+    titulo->setFont(QFont("Inter", 13, QFont::DemiBold));
+
+    auto *btnAnterior = new QPushButton("‹");
+    auto *btnProximo  = new QPushButton("›");
+    for (auto *btn : {btnAnterior, btnProximo}) {
+        btn->setProperty("secondary", true);
+        btn->setFixedWidth(32);
+    }
+
+    m_rotuloAno = new QLabel;
+    m_rotuloAno->setMinimumWidth(60);
+    m_rotuloAno->setAlignment(Qt::AlignCenter);
+    m_rotuloAno->setStyleSheet("font-size: 13px; font-weight: 500;");
+
+    m_totalAno = new QLabel;
+    m_totalAno->setStyleSheet("font-size: 13px; color: palette(mid);");
+
+    auto *cabecalho = new QHBoxLayout;
+    cabecalho->setSpacing(6);
+    cabecalho->addWidget(titulo);
+    cabecalho->addSpacing(12);
+    cabecalho->addWidget(btnAnterior);
+    cabecalho->addWidget(m_rotuloAno);
+    cabecalho->addWidget(btnProximo);
+    cabecalho->addStretch();
+    cabecalho->addWidget(m_totalAno);
+    root->addLayout(cabecalho);
+
+    // ── Mapa ──────────────────────────────────────────────────────────────────
+    m_mapa = new MapaCalor;
+    root->addWidget(m_mapa);
+
+    // ── Gastos do dia ─────────────────────────────────────────────────────────
+    m_rotuloDia = new QLabel("Clique em um dia para ver os gastos");
+    m_rotuloDia->setStyleSheet("font-size: 13px; font-weight: 500;");
+    root->addWidget(m_rotuloDia);
+
+    m_tabelaDia = new QTableWidget(0, 4, this);
+    m_tabelaDia->setHorizontalHeaderLabels({"Tipo", "Histórico", "Categoria", "Valor"});
+    m_tabelaDia->horizontalHeader()->setSectionResizeMode(COL_TIPO,      QHeaderView::ResizeToContents);
+    m_tabelaDia->horizontalHeader()->setSectionResizeMode(COL_HISTORICO, QHeaderView::Stretch);
+    m_tabelaDia->horizontalHeader()->setSectionResizeMode(COL_CATEGORIA, QHeaderView::ResizeToContents);
+    m_tabelaDia->horizontalHeader()->setSectionResizeMode(COL_VALOR,     QHeaderView::ResizeToContents);
+    m_tabelaDia->verticalHeader()->setVisible(false);
+    m_tabelaDia->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tabelaDia->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tabelaDia->setAlternatingRowColors(true);
+    m_tabelaDia->setShowGrid(false);
+    root->addWidget(m_tabelaDia, 1);
+
+    connect(btnAnterior, &QPushButton::clicked, this, [this]() { mostrarAno(m_ano - 1); });
+    connect(btnProximo,  &QPushButton::clicked, this, [this]() { mostrarAno(m_ano + 1); });
+    connect(m_mapa, &MapaCalor::diaSelecionado, this, &CalendarioWidget::mostrarDia);
+
+    atualizar();
+}
+
+// ── Ano ───────────────────────────────────────────────────────────────────────
+
+void CalendarioWidget::definirPeriodo(const Periodo &periodo)
+{
+    if (periodo.fim.isValid())         mostrarAno(periodo.fim.year());
+    else if (periodo.inicio.isValid()) mostrarAno(periodo.inicio.year());
+}
+
+void CalendarioWidget::mostrarAno(int ano)
+{
+    if (ano == m_ano) return;
+    m_ano = ano;
+    atualizar();
+}
+
+void CalendarioWidget::atualizar()
+{
+    TRACE_SPAN("CalendarioWidget::atualizar", "ui");
+    const QList<GastoDiario> dias =
+        DatabaseManager::instance().gastosPorDia(Periodo::ano(QDate(m_ano, 1, 1)));
+
+    qint64 total = 0;
+    for (const GastoDiario &d : dias) total += d.totalCentavos;
+
+    m_rotuloAno->setText(QString::number(m_ano));
+    m_totalAno->setText("Total no ano: " + centavosParaTexto(total));
+    m_mapa->definirAno(m_ano, dias);
+
+    // O dia aberto pode ter mudado (edição em outra aba); fora do ano, some
+    if (m_dia.isValid() && m_dia.year() == m_ano) {
+        mostrarDia(m_dia);
+    } else {
+        m_dia = {};
+        m_rotuloDia->setText("Clique em um dia para ver os gastos");
+        m_tabelaDia->setRowCount(0);
+    }
+}
+
+// ── Dia ───────────────────────────────────────────────────────────────────────
+
+void CalendarioWidget::mostrarDia(const QDate &dia)
+{
+    TRACE_SPAN("CalendarioWidget::mostrarDia", "ui");
+    m_dia = dia;
+
+    DatabaseManager &db = DatabaseManager::instance();
+    const Periodo umDia = Periodo::personalizado(dia, dia);
+    const QList<GastoFixo>     fixos     = db.listarGastosFixos(umDia);
+    const QList<GastoVariavel> variaveis = db.listarGastosVariaveis(umDia);
+
+    m_tabelaDia->setUpdatesEnabled(false);
+    m_tabelaDia->setRowCount(0);
+    m_tabelaDia->setRowCount(int(fixos.size() + variaveis.size()));
+
+    int row = 0;
+    qint64 total = 0;
+    auto adicionar = [&](const QString &tipo, const QString &historico,
+                         const QString &categoria, qint64 valorCentavos) {
+        auto *valor = makeItem(centavosParaTexto(valorCentavos));
+        valor->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        m_tabelaDia->setItem(row, COL_TIPO,      makeItem(tipo));
+        m_tabelaDia->setItem(row, COL_HISTORICO, makeItem(historico));
+        m_tabelaDia->setItem(row, COL_CATEGORIA, makeItem(categoria));
+        m_tabelaDia->setItem(row, COL_VALOR,     valor);
+        total += valorCentavos;
+        ++row;
+    };
+    for (const GastoFixo &g : fixos)
+        adicionar("Fixo", g.historico, g.categoriaNome, g.valorCentavos);
+    for (const GastoVariavel &g : variaveis)
+        adicionar("Variável", g.historico, g.categoriaNome, g.valorCentavos);
+    m_tabelaDia->setUpdatesEnabled(true);
+
+    m_rotuloDia->setText(row == 0
+        ? dia.toString("dd/MM/yyyy") + " — sem gastos"
+        : QString("%1 — %2 em %3 gasto(s)").arg(dia.toString("dd/MM/yyyy"),
+                                                centavosParaTexto(total)).arg(row));
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "models/Periodo.h"
+
+#include <QDate>
+#include <QWidget>
+
+class MapaCalor;
+class QLabel;
+class QTableWidget;
+
+// Aba Calendário: mapa de calor dos gastos do ano (MapaCalor) e, abaixo, os
+// gastos do dia clicado. O ano vem de agregado_diario em uma query; o dia, de
+// listarGastosFixos/listarGastosVariaveis com período de um dia — range scan
+// em idx_<tabela>_data.
+class CalendarioWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CalendarioWidget(QWidget *parent = nullptr);
+
+    // Passa a mostrar o ano do fim do período (ou do início; Tudo mantém o ano)
+    void definirPeriodo(const Periodo &periodo);
+
+public slots:
+    void atualizar();
+
+private:
+    void mostrarAno(int ano);
+    void mostrarDia(const QDate &dia);
+
+    MapaCalor    *m_mapa;
+    QLabel       *m_rotuloAno;
+    QLabel       *m_totalAno;
+    QLabel       *m_rotuloDia;
+    QTableWidget *m_tabelaDia;
+    int           m_ano = QDate::currentDate().year();
+    QDate         m_dia;  // dia cujos gastos estão na tabela
+};
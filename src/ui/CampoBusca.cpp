@@ -0,0 +1,14 @@
+#include "ui/CampoBusca.h"
+
+CampoBusca::CampoBusca(QWidget *parent)
+    : QLineEdit(parent)
+{
+    setPlaceholderText("Buscar…");
+    setClearButtonEnabled(true);
+
+    m_atraso.setSingleShot(true);
+    m_atraso.setInterval(ATRASO_MS);
+
+    connect(this, &QLineEdit::textChanged, &m_atraso, qOverload<>(&QTimer::start));
+    connect(&m_atraso, &QTimer::timeout, this, [this]() { emit buscaAlterada(text().trimmed()); });
+}
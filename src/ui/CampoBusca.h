@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QLineEdit>
+#include <QTimer>
+
+// Caixa de busca das abas de lançamentos: emite buscaAlterada() quando a
+// digitação pausa (debounce), não a cada tecla
+class CampoBusca : public QLineEdit
+{
+    Q_OBJECT
+
+signals:
+    void buscaAlterada(const QString &texto);
+
+public:
+    static constexpr int ATRASO_MS = 150;
+
+    explicit CampoBusca(QWidget *parent = nullptr);
+
+private:
+    QTimer m_atraso;
+};
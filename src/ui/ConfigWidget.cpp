@@ -1,15 +1,66 @@
 #include "ui/ConfigWidget.h"
 
 #include "core/DatabaseManager.h"
+#include "core/LedgerExporter.h"
 #include "models/Categoria.h"
+#include "models/RegraCategoria.h"
+#include "utils/Agregacao.h"
+#include "utils/Cpu.h"
+#include "utils/CurrencyUtils.h"
+#include "utils/MemoriaProcesso.h"
 
+#include <QDir>
+#include <QFileDialog>
+#include <QFormLayout>
 #include <QFrame>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QMessageBox>
-#include <QPushButton>
+#include <QRegularExpression>
+#include <QShowEvent>
+#include <QThread>
 #include <QVBoxLayout>
 
+// ── Formatação ────────────────────────────────────────────────────────────────
+
+static QString formatarBytes(qint64 bytes)
+{
+    if (bytes < 0)            return "—";
+    if (bytes < 1024)         return QString("%1 B").arg(bytes);
+    if (bytes < 1024 * 1024)  return QString("%L1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    return QString("%L1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+static QString formatarMs(qint64 ms)
+{
+    return ms < 0 ? QString("—") : QString("%L1 ms").arg(ms);
+}
+
+// "contém “uber” entre R$ 10,00 e R$ 80,00  →  Transporte"
+static QString descreverRegra(const RegraCategoria &r)
+{
+    QString texto;
+    switch (r.tipo) {
+    case RegraCategoria::Tipo::Contem: texto = QString("contém “%1”").arg(r.padrao); break;
+    case RegraCategoria::Tipo::Regex:  texto = QString("regex /%1/").arg(r.padrao);  break;
+    case RegraCategoria::Tipo::Faixa:  texto = "valor";                              break;
+    }
+    if (r.valorMinCentavos > 0 && r.valorMaxCentavos > 0)
+        texto += QString(" entre %1 e %2").arg(centavosParaTexto(r.valorMinCentavos),
+                                               centavosParaTexto(r.valorMaxCentavos));
+    else if (r.valorMinCentavos > 0)
+        texto += " a partir de " + centavosParaTexto(r.valorMinCentavos);
+    else if (r.valorMaxCentavos > 0)
+        texto += " até " + centavosParaTexto(r.valorMaxCentavos);
+    return texto + "  →  " + r.categoriaNome;
+}
+
+static QString formatarNs(quint64 ns)
+{
+    return ns < 1000000 ? QString("%L1 µs").arg(ns / 1000.0, 0, 'f', 0)
+                        : QString("%L1 ms").arg(ns / 1e6, 0, 'f', 1);
+}
+
 ConfigWidget::ConfigWidget(QWidget *parent)
     : QWidget(parent)
 {
@@ -17,22 +68,30 @@ ConfigWidget::ConfigWidget(QWidget *parent)
     root->setContentsMargins(24, 24, 24, 24);
     root->setSpacing(16);
 
+    // Categorias, orçamentos e regras num contêiner: a manutenção desabilita
+    // tudo de uma vez, e cada filho volta ao próprio estado depois
+    m_edicao = new QWidget;
+    auto *edicao = new QVBoxLayout(m_edicao);
+    edicao->setContentsMargins(0, 0, 0, 0);
+    edicao->setSpacing(16);
+    root->addWidget(m_edicao, 1);
+
     // ── Título ────────────────────────────────────────────────────────────────
     auto *titulo = new QLabel("Categorias de gastos");
     titulo->setStyleSheet("font-size: 15px; font-weight: 600;");
-    root->addWidget(titulo);
+    edicao->addWidget(titulo);
 
     auto *subtitulo = new QLabel(
         "Categorias são compartilhadas entre Gastos Fixos e Gastos Variáveis.");
     subtitulo->setProperty("secondary", true);
     subtitulo->setStyleSheet("font-size: 12px; color: palette(mid);");
     subtitulo->setWordWrap(true);
-    root->addWidget(subtitulo);
+    edicao->addWidget(subtitulo);
 
     // ── Lista ─────────────────────────────────────────────────────────────────
     m_lista = new QListWidget;
     m_lista->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    root->addWidget(m_lista);
+    edicao->addWidget(m_lista);
 
     // ── Input + botão Adicionar ───────────────────────────────────────────────
     auto *addRow = new QHBoxLayout;
@@ -46,18 +105,192 @@ ConfigWidget::ConfigWidget(QWidget *parent)
     btnAdicionar->setFixedWidth(100);
     addRow->addWidget(btnAdicionar);
 
-    root->addLayout(addRow);
+    edicao->addLayout(addRow);
 
     // ── Botão Remover ─────────────────────────────────────────────────────────
     auto *btnRemover = new QPushButton("Remover selecionada");
     btnRemover->setProperty("secondary", true);
-    root->addWidget(btnRemover);
+    edicao->addWidget(btnRemover);
+
+    // ── Orçamento da selecionada ──────────────────────────────────────────────
+    auto *orcamentoRow = new QHBoxLayout;
+    orcamentoRow->setSpacing(8);
+    orcamentoRow->addWidget(new QLabel("Orçamento mensal da selecionada:"));
+
+    m_inputOrcamento = new QLineEdit;
+    m_inputOrcamento->setPlaceholderText("Sem limite");
+    m_inputOrcamento->setToolTip("Limite do mês para gastos fixos, variáveis e parcelas de "
+                                 "compras parceladas da categoria");
+    m_inputOrcamento->setEnabled(false);
+    orcamentoRow->addWidget(m_inputOrcamento);
+
+    auto *btnOrcamento = new QPushButton("Definir");
+    btnOrcamento->setFixedWidth(100);
+    orcamentoRow->addWidget(btnOrcamento);
+    edicao->addLayout(orcamentoRow);
+
+    // ── Regras de categorização ───────────────────────────────────────────────
+    auto *tituloRegras = new QLabel("Regras de categorização");
+    tituloRegras->setStyleSheet("font-size: 15px; font-weight: 600;");
+    edicao->addSpacing(8);
+    edicao->addWidget(tituloRegras);
+
+    auto *subtituloRegras = new QLabel(
+        "Aplicadas ao digitar o histórico de um gasto e ao importar extratos. "
+        "Vence a primeira regra da lista que casar; o texto é comparado sem "
+        "acentos e sem diferenciar maiúsculas.");
+    subtituloRegras->setStyleSheet("font-size: 12px; color: palette(mid);");
+    subtituloRegras->setWordWrap(true);
+    edicao->addWidget(subtituloRegras);
+
+    m_listaRegras = new QListWidget;
+    m_listaRegras->setMaximumHeight(140);
+    edicao->addWidget(m_listaRegras);
+
+    auto *regraRow = new QHBoxLayout;
+    regraRow->setSpacing(8);
+
+    m_regraTipo = new QComboBox;
+    m_regraTipo->addItem("Contém",            int(RegraCategoria::Tipo::Contem));
+    m_regraTipo->addItem("Expressão regular", int(RegraCategoria::Tipo::Regex));
+    m_regraTipo->addItem("Faixa de valor",    int(RegraCategoria::Tipo::Faixa));
+    regraRow->addWidget(m_regraTipo);
+
+    m_regraPadrao = new QLineEdit;
+    m_regraPadrao->setPlaceholderText("Texto ou expressão…");
+    regraRow->addWidget(m_regraPadrao, 1);
+
+    m_regraMin = new QLineEdit;
+    m_regraMin->setPlaceholderText("Valor mín.");
+    m_regraMin->setFixedWidth(90);
+    regraRow->addWidget(m_regraMin);
+
+    m_regraMax = new QLineEdit;
+    m_regraMax->setPlaceholderText("Valor máx.");
+    m_regraMax->setFixedWidth(90);
+    regraRow->addWidget(m_regraMax);
+
+    m_regraCategoria = new QComboBox;
+    regraRow->addWidget(m_regraCategoria);
+
+    auto *btnAdicionarRegra = new QPushButton("Adicionar");
+    btnAdicionarRegra->setFixedWidth(100);
+    regraRow->addWidget(btnAdicionarRegra);
+
+    edicao->addLayout(regraRow);
+
+    auto *btnRemoverRegra = new QPushButton("Remover regra selecionada");
+    btnRemoverRegra->setProperty("secondary", true);
+    edicao->addWidget(btnRemoverRegra);
+
+    connect(m_regraTipo, &QComboBox::currentIndexChanged, this, [this]() {
+        m_regraPadrao->setEnabled(
+            RegraCategoria::Tipo(m_regraTipo->currentData().toInt()) != RegraCategoria::Tipo::Faixa);
+    });
+    connect(btnAdicionarRegra, &QPushButton::clicked,     this, &ConfigWidget::adicionarRegra);
+    connect(m_regraPadrao,     &QLineEdit::returnPressed, this, &ConfigWidget::adicionarRegra);
+    connect(btnRemoverRegra,   &QPushButton::clicked,     this, &ConfigWidget::removerRegra);
+
+    // ── Exportação ────────────────────────────────────────────────────────────
+    auto *tituloExport = new QLabel("Exportar lançamentos");
+    tituloExport->setStyleSheet("font-size: 15px; font-weight: 600;");
+    root->addSpacing(8);
+    root->addWidget(tituloExport);
+
+    auto *exportRow = new QHBoxLayout;
+    exportRow->setSpacing(8);
+
+    m_formatoExport = new QComboBox;
+    m_formatoExport->addItem("CSV",                int(LedgerExporter::Formato::Csv));
+    m_formatoExport->addItem("JSON Lines",         int(LedgerExporter::Formato::JsonLines));
+    m_formatoExport->addItem("Colunar (.orcc)",    int(LedgerExporter::Formato::Colunar));
+    exportRow->addWidget(m_formatoExport);
+
+    m_btnExportar = new QPushButton("Exportar…");
+    m_btnExportar->setProperty("secondary", true);
+    exportRow->addWidget(m_btnExportar);
+
+    m_btnCancelarExport = new QPushButton("Cancelar");
+    m_btnCancelarExport->setProperty("secondary", true);
+    m_btnCancelarExport->setVisible(false);
+    exportRow->addWidget(m_btnCancelarExport);
+
+    m_progressoExport = new QProgressBar;
+    m_progressoExport->setVisible(false);
+    exportRow->addWidget(m_progressoExport, 1);
+
+    root->addLayout(exportRow);
+
+    // ── Diagnóstico ───────────────────────────────────────────────────────────
+    auto *tituloDiag = new QLabel("Diagnóstico");
+    tituloDiag->setStyleSheet("font-size: 15px; font-weight: 600;");
+    root->addSpacing(8);
+    root->addWidget(tituloDiag);
+
+    auto *form = new QFormLayout;
+    form->setHorizontalSpacing(16);
+    form->setVerticalSpacing(4);
+    auto novoValor = []() {
+        auto *l = new QLabel("—");
+        l->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        return l;
+    };
+    m_diagTamanho = novoValor();
+    m_diagLinhas  = novoValor();
+    m_diagCache   = novoValor();
+    m_diagCripto  = novoValor();
+    m_diagQueries = novoValor();
+    m_diagMemoria = novoValor();
+    m_diagSimd    = novoValor();
+    m_diagLinhas->setWordWrap(true);
+    form->addRow("Banco / .enc:",         m_diagTamanho);
+    form->addRow("Linhas:",               m_diagLinhas);
+    form->addRow("Cache de páginas:",     m_diagCache);
+    form->addRow("PBKDF2 / salvamento:",  m_diagCripto);
+    form->addRow("Queries p50 / p99:",    m_diagQueries);
+    form->addRow("Memória (RSS / pico):", m_diagMemoria);
+    form->addRow("SIMD (agregações):",    m_diagSimd);
+    root->addLayout(form);
+
+    auto *diagRow = new QHBoxLayout;
+    diagRow->setSpacing(8);
+
+    auto *btnAtualizarDiag = new QPushButton("Atualizar");
+    btnAtualizarDiag->setProperty("secondary", true);
+    diagRow->addWidget(btnAtualizarDiag);
+    connect(btnAtualizarDiag, &QPushButton::clicked, this, &ConfigWidget::atualizarDiagnostico);
+
+    using Operacao = DatabaseMaintenance::Operacao;
+    for (const Operacao op : {Operacao::Analisar, Operacao::Compactar, Operacao::VerificarIntegridade}) {
+        auto *btn = new QPushButton(DatabaseMaintenance::descricao(op));
+        btn->setProperty("secondary", true);
+        diagRow->addWidget(btn);
+        connect(btn, &QPushButton::clicked, this, [this, op]() { executarManutencao(op); });
+        m_botoesManutencao.append(btn);
+    }
+    diagRow->addStretch();
+    root->addLayout(diagRow);
+
+    m_diagStatus = new QLabel;
+    m_diagStatus->setStyleSheet("font-size: 12px; color: palette(mid);");
+    m_diagStatus->setWordWrap(true);
+    root->addWidget(m_diagStatus);
 
     root->addStretch();
 
     connect(btnAdicionar,  &QPushButton::clicked,  this, &ConfigWidget::adicionarCategoria);
     connect(m_inputNova,   &QLineEdit::returnPressed, this, &ConfigWidget::adicionarCategoria);
     connect(btnRemover,    &QPushButton::clicked,  this, &ConfigWidget::removerCategoria);
+    connect(btnOrcamento,  &QPushButton::clicked,  this, &ConfigWidget::definirOrcamento);
+    connect(m_inputOrcamento, &QLineEdit::returnPressed, this, &ConfigWidget::definirOrcamento);
+    connect(m_lista, &QListWidget::currentItemChanged, this, [this](QListWidgetItem *item) {
+        m_inputOrcamento->setEnabled(item != nullptr);
+        const qint64 limite = item
+            ? DatabaseManager::instance().orcamentos().value(item->data(Qt::UserRole).toInt()) : 0;
+        m_inputOrcamento->setText(limite > 0 ? centavosParaTexto(limite) : QString());
+    });
+    connect(m_btnExportar, &QPushButton::clicked,  this, &ConfigWidget::exportar);
+    connect(m_btnCancelarExport, &QPushButton::clicked, this, &ConfigWidget::cancelarExportacao);
 
     carregar();
 }
@@ -72,6 +305,26 @@ void ConfigWidget::carregar()
         item->setData(Qt::UserRole, cat.id);
         m_lista->addItem(item);
     }
+    carregarRegras();
+}
+
+void ConfigWidget::carregarRegras()
+{
+    auto &db = DatabaseManager::instance();
+
+    m_listaRegras->clear();
+    for (const RegraCategoria &r : db.listarRegras()) {
+        auto *item = new QListWidgetItem(descreverRegra(r));
+        item->setData(Qt::UserRole, r.id);
+        m_listaRegras->addItem(item);
+    }
+
+    const int selecionada = m_regraCategoria->currentData().toInt();
+    m_regraCategoria->clear();
+    for (const Categoria &cat : db.listarCategorias())
+        m_regraCategoria->addItem(cat.nome, cat.id);
+    const int idx = m_regraCategoria->findData(selecionada);
+    if (idx >= 0) m_regraCategoria->setCurrentIndex(idx);
 }
 
 // ── Adicionar ─────────────────────────────────────────────────────────────────
@@ -96,6 +349,7 @@ void ConfigWidget::adicionarCategoria()
     m_lista->addItem(item);
     m_lista->setCurrentItem(item);
     m_inputNova->clear();
+    carregarRegras();
 
     emit categoriasAlteradas();
 }
@@ -127,5 +381,256 @@ void ConfigWidget::removerCategoria()
     }
 
     delete m_lista->takeItem(m_lista->row(item));
+    carregarRegras();  // a cascata também remove as regras da categoria
     emit categoriasAlteradas();
 }
+
+// ── Orçamento ─────────────────────────────────────────────────────────────────
+
+// Campo vazio ou zerado remove o limite
+void ConfigWidget::definirOrcamento()
+{
+    auto *item = m_lista->currentItem();
+    if (!item) return;
+
+    const qint64 limite = textoParaCentavos(m_inputOrcamento->text());
+    if (limite < 0) {
+        QMessageBox::warning(this, "Orçamento", "O limite não pode ser negativo.");
+        return;
+    }
+    if (!DatabaseManager::instance().definirOrcamento(item->data(Qt::UserRole).toInt(), limite)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível gravar o orçamento.");
+        return;
+    }
+    m_inputOrcamento->setText(limite > 0 ? centavosParaTexto(limite) : QString());
+    emit categoriasAlteradas();  // barras do Dashboard e destaque nas tabelas
+}
+
+// ── Regras ────────────────────────────────────────────────────────────────────
+
+void ConfigWidget::adicionarRegra()
+{
+    RegraCategoria regra;
+    regra.tipo             = RegraCategoria::Tipo(m_regraTipo->currentData().toInt());
+    regra.padrao           = regra.tipo == RegraCategoria::Tipo::Faixa
+                             ? QString() : m_regraPadrao->text().trimmed();
+    regra.valorMinCentavos = textoParaCentavos(m_regraMin->text());
+    regra.valorMaxCentavos = textoParaCentavos(m_regraMax->text());
+    regra.categoriaId      = m_regraCategoria->currentData().toInt();
+    regra.categoriaNome    = m_regraCategoria->currentText();
+
+    QString problema;
+    if (regra.categoriaId <= 0)
+        problema = "Cadastre ao menos uma categoria.";
+    else if (regra.tipo != RegraCategoria::Tipo::Faixa && regra.padrao.isEmpty())
+        problema = "Informe o texto ou a expressão da regra.";
+    else if (regra.tipo == RegraCategoria::Tipo::Faixa
+             && regra.valorMinCentavos <= 0 && regra.valorMaxCentavos <= 0)
+        problema = "Uma regra de faixa precisa de valor mínimo ou máximo.";
+    else if (regra.valorMinCentavos < 0 || regra.valorMaxCentavos < 0
+             || (regra.valorMaxCentavos > 0 && regra.valorMinCentavos > regra.valorMaxCentavos))
+        problema = "Faixa de valor inválida.";
+    else if (regra.tipo == RegraCategoria::Tipo::Regex) {
+        const QRegularExpression re(regra.padrao);
+        if (!re.isValid()) problema = "Expressão regular inválida: " + re.errorString();
+    }
+    if (!problema.isEmpty()) {
+        QMessageBox::warning(this, "Regra de categorização", problema);
+        return;
+    }
+
+    if (!DatabaseManager::instance().inserirRegra(regra)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível adicionar a regra.");
+        return;
+    }
+
+    auto *item = new QListWidgetItem(descreverRegra(regra));
+    item->setData(Qt::UserRole, regra.id);
+    m_listaRegras->addItem(item);
+    m_listaRegras->setCurrentItem(item);
+    m_regraPadrao->clear();
+    m_regraMin->clear();
+    m_regraMax->clear();
+}
+
+void ConfigWidget::removerRegra()
+{
+    auto *item = m_listaRegras->currentItem();
+    if (!item) {
+        QMessageBox::information(this, "Remover", "Selecione uma regra para remover.");
+        return;
+    }
+
+    if (!DatabaseManager::instance().removerRegra(item->data(Qt::UserRole).toInt())) {
+        QMessageBox::warning(this, "Erro", "Não foi possível remover a regra.");
+        return;
+    }
+    delete m_listaRegras->takeItem(m_listaRegras->row(item));
+}
+
+// ── Exportar ──────────────────────────────────────────────────────────────────
+
+void ConfigWidget::exportar()
+{
+    const auto formato = LedgerExporter::Formato(m_formatoExport->currentData().toInt());
+    const QString ext  = LedgerExporter::extensao(formato);
+
+    const QString destino = QFileDialog::getSaveFileName(
+        this, "Exportar lançamentos",
+        QDir::homePath() + "/lancamentos." + ext,
+        QString("*.%1").arg(ext));
+    if (destino.isEmpty()) return;
+
+    // Cópia e cursor em thread própria: a UI segue responsiva e editável em
+    // exportações grandes (o exportador lê de um instantâneo em memória)
+    auto *thread     = new QThread(this);
+    auto *exportador = new LedgerExporter(DatabaseManager::instance().caminhoBanco(),
+                                          destino, formato);
+    exportador->moveToThread(thread);
+    m_threadExport    = thread;
+    m_exportador      = exportador;
+    m_exportCancelada = false;
+
+    connect(thread, &QThread::started, exportador, &LedgerExporter::executar);
+    connect(exportador, &LedgerExporter::progresso, this, [this](qint64 feitas, qint64 total) {
+        // QProgressBar usa int: trabalha em milésimos
+        m_progressoExport->setRange(0, 1000);
+        m_progressoExport->setValue(total > 0 ? int(feitas * 1000 / total) : 1000);
+    });
+    connect(exportador, &LedgerExporter::concluido, this, [this, destino](bool ok, const QString &erro) {
+        m_btnExportar->setEnabled(true);
+        for (auto *btn : std::as_const(m_botoesManutencao)) btn->setEnabled(true);
+        m_btnCancelarExport->setVisible(false);
+        m_progressoExport->setVisible(false);
+        if (ok)
+            QMessageBox::information(this, "Exportar", "Lançamentos exportados para\n" + destino);
+        else if (!m_exportCancelada)
+            QMessageBox::warning(this, "Exportar", "Falha na exportação.\n\n" + erro);
+    });
+    connect(exportador, &LedgerExporter::concluido, thread, &QThread::quit);
+    // Apagado na thread da GUI, a única que usa m_exportador: cancelar nunca
+    // corre contra o deleteLater da thread que terminou
+    connect(thread, &QThread::finished, this,
+            [exportador = QPointer<LedgerExporter>(exportador)]() { delete exportador.data(); });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    m_btnExportar->setEnabled(false);
+    for (auto *btn : std::as_const(m_botoesManutencao)) btn->setEnabled(false);  // VACUUM esperaria a cópia
+    m_btnCancelarExport->setEnabled(true);
+    m_btnCancelarExport->setVisible(true);
+    m_progressoExport->setValue(0);
+    m_progressoExport->setVisible(true);
+    thread->start();
+}
+
+// O exportador confere a flag a cada linha, apaga o arquivo parcial e emite
+// concluido(false) — que reabilita os botões
+void ConfigWidget::cancelarExportacao()
+{
+    if (!m_exportador) return;
+    m_exportCancelada = true;
+    m_exportador->cancelar();
+    m_btnCancelarExport->setEnabled(false);
+}
+
+// Uma QThread destruída em execução aborta o processo: cancela o que dá para
+// cancelar (VACUUM não dá) e espera as duas threads terminarem
+void ConfigWidget::encerrarTarefas()
+{
+    if (m_exportador) {
+        disconnect(m_exportador, nullptr, this, nullptr);  // sem diálogo ao sair
+        m_exportador->cancelar();
+    }
+    for (QThread *thread : {m_threadExport.data(), m_threadManutencao.data()}) {
+        if (!thread) continue;
+        thread->quit();  // vale mesmo antes do exec(): o loop retorna ao começar
+        thread->wait();
+    }
+    delete m_exportador.data();  // a thread parou; o slot de finished pode não rodar mais
+}
+
+ConfigWidget::~ConfigWidget()
+{
+    encerrarTarefas();
+}
+
+// ── Diagnóstico ───────────────────────────────────────────────────────────────
+
+void ConfigWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    atualizarDiagnostico();
+}
+
+void ConfigWidget::atualizarDiagnostico()
+{
+    auto &db = DatabaseManager::instance();
+    if (!db.isConectado()) return;
+
+    const DiagnosticoBanco d = db.diagnostico();
+    m_diagTamanho->setText(formatarBytes(d.bytesBanco) + " / " + formatarBytes(d.bytesEnc));
+
+    QStringList linhas;
+    for (const auto &[tabela, n] : d.linhasPorTabela)
+        linhas << QString("%1: %L2").arg(tabela).arg(n);
+    m_diagLinhas->setText(linhas.join(" · "));
+
+    m_diagCache->setText(d.taxaAcertoCache < 0
+        ? QString("indisponível (compilado sem ORCAMENTO_SQLITE_NATIVO)")
+        : QString("%L1% de acertos").arg(d.taxaAcertoCache * 100.0, 0, 'f', 1));
+    m_diagCripto->setText(formatarMs(d.derivacaoMs) + " / " + formatarMs(d.salvamentoMs));
+
+    const HistogramaLatencia latencia = db.latenciaQueries();
+    m_diagQueries->setText(latencia.contagem() == 0 ? QString("—")
+        : QString("%1 / %2 (%L3 execuções)")
+              .arg(formatarNs(latencia.percentil(0.50)), formatarNs(latencia.percentil(0.99)))
+              .arg(latencia.contagem()));
+
+    m_diagMemoria->setText(formatarBytes(MemoriaProcesso::rssAtualKiB() * 1024) + " / "
+                           + formatarBytes(MemoriaProcesso::rssPicoKiB() * 1024));
+
+    // Variante dos kernels em uso / a maior que o processador suporta
+    m_diagSimd->setText(QString("%1 / %2").arg(Cpu::nomeNivel(Agregacao::nivel()),
+                                               Cpu::nomeNivel(Cpu::nivelSuportado())));
+}
+
+void ConfigWidget::executarManutencao(DatabaseMaintenance::Operacao operacao)
+{
+    // Conexão própria em outra thread: VACUUM em bancos grandes leva segundos
+    auto *thread = new QThread(this);
+    auto *tarefa = new DatabaseMaintenance(DatabaseManager::instance().caminhoBanco(), operacao);
+    tarefa->moveToThread(thread);
+    m_threadManutencao = thread;
+
+    connect(thread, &QThread::started, tarefa, &DatabaseMaintenance::executar);
+    connect(tarefa, &DatabaseMaintenance::concluido, this,
+            [this, operacao](bool ok, const QString &resultado) {
+        for (auto *btn : std::as_const(m_botoesManutencao)) btn->setEnabled(true);
+        m_btnExportar->setEnabled(true);
+        m_edicao->setEnabled(true);
+        emit manutencaoEmAndamento(false);
+
+        // ANALYZE e VACUUM alteram o .db: leva o resultado ao .enc
+        if (ok && operacao != DatabaseMaintenance::Operacao::VerificarIntegridade
+            && !DatabaseManager::instance().salvar()) {
+            ok = false;
+        }
+        m_diagStatus->setText(DatabaseMaintenance::descricao(operacao) + ": " + resultado);
+        atualizarDiagnostico();
+        if (!ok)
+            QMessageBox::warning(this, DatabaseMaintenance::descricao(operacao),
+                                 resultado.isEmpty() ? QString("Falha ao salvar o banco.") : resultado);
+    });
+    connect(tarefa, &DatabaseMaintenance::concluido, thread, &QThread::quit);
+    connect(thread, &QThread::finished, tarefa, &QObject::deleteLater);
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+
+    // VACUUM e ANALYZE escrevem no .db: sem edições pela conexão principal
+    // (nem exportação) até terminar, em vez de esbarrar em "database is locked"
+    for (auto *btn : std::as_const(m_botoesManutencao)) btn->setEnabled(false);
+    m_btnExportar->setEnabled(false);
+    m_edicao->setEnabled(false);
+    emit manutencaoEmAndamento(true);
+    m_diagStatus->setText(DatabaseMaintenance::descricao(operacao) + " em andamento…");
+    thread->start();
+}
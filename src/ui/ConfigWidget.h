@@ -1,26 +1,87 @@
 #pragma once
 
+#include "core/DatabaseMaintenance.h"
+
+#include <QComboBox>
+#include <QLabel>
 #include <QLineEdit>
 #include <QListWidget>
+#include <QPointer>
+#include <QProgressBar>
+#include <QPushButton>
 #include <QWidget>
 
+class LedgerExporter;
+class QThread;
+
 class ConfigWidget : public QWidget
 {
     Q_OBJECT
 
 signals:
     void categoriasAlteradas();
+    void manutencaoEmAndamento(bool emAndamento);  // MainWindow trava as abas de lançamentos
 
 public:
     explicit ConfigWidget(QWidget *parent = nullptr);
+    ~ConfigWidget() override;
+
+    // Cancela a exportação e espera as threads de exportação e manutenção.
+    // Chamado ao fechar a janela, antes de DatabaseManager::desconectar()
+    // apagar o .db temporário que elas leem; o destrutor repete por garantia.
+    void encerrarTarefas();
 
 private slots:
     void adicionarCategoria();
     void removerCategoria();
+    void definirOrcamento();
+    void adicionarRegra();
+    void removerRegra();
+    void exportar();
+    void cancelarExportacao();
+    void atualizarDiagnostico();
+
+protected:
+    void showEvent(QShowEvent *event) override;
 
 private:
     void carregar();
+    void carregarRegras();
+    void executarManutencao(DatabaseMaintenance::Operacao operacao);
 
+    QWidget     *m_edicao;  // categorias, orçamentos e regras
     QListWidget *m_lista;
     QLineEdit   *m_inputNova;
+    QLineEdit   *m_inputOrcamento;
+
+    // Regras de categorização
+    QListWidget *m_listaRegras;
+    QComboBox   *m_regraTipo;
+    QLineEdit   *m_regraPadrao;
+    QLineEdit   *m_regraMin;
+    QLineEdit   *m_regraMax;
+    QComboBox   *m_regraCategoria;
+
+    // Exportação
+    QComboBox    *m_formatoExport;
+    QPushButton  *m_btnExportar;
+    QPushButton  *m_btnCancelarExport;
+    QProgressBar *m_progressoExport;
+
+    // Tarefas em thread própria; QPointer zera quando deleteLater as leva
+    QPointer<QThread>        m_threadExport;
+    QPointer<LedgerExporter> m_exportador;
+    bool                     m_exportCancelada = false;
+    QPointer<QThread>        m_threadManutencao;
+
+    // Diagnóstico
+    QLabel              *m_diagTamanho;
+    QLabel              *m_diagLinhas;
+    QLabel              *m_diagCache;
+    QLabel              *m_diagCripto;
+    QLabel              *m_diagQueries;
+    QLabel              *m_diagMemoria;
+    QLabel              *m_diagSimd;
+    QLabel              *m_diagStatus;
+    QList<QPushButton *> m_botoesManutencao;
 };
@@ -1,15 +1,20 @@
 #include "ui/DashboardWidget.h"
 
 #include "core/DatabaseManager.h"
+#include "ui/DesenhoGraficos.h"
+#include "ui/GraficoTendencia.h"
+#include "ui/ImagemGrafico.h"
+#include "ui/SeletorPeriodo.h"
 #include "ui/Theme.h"
 #include "utils/CurrencyUtils.h"
+#include "utils/Tracer.h"
 
-#include <QChart>
 #include <QFrame>
+#include <QGridLayout>
 #include <QHBoxLayout>
-#include <QPieSeries>
-#include <QPieSlice>
-#include <QPainter>
+#include <QHeaderView>
+#include <QProgressBar>
+#include <QTableWidget>
 #include <QVBoxLayout>
 
 // ── Card de resumo ────────────────────────────────────────────────────────────
@@ -70,7 +75,7 @@ DashboardWidget::DashboardWidget(QWidget *parent)
     auto *saldoLayout = new QVBoxLayout(cardSaldo);
     saldoLayout->setContentsMargins(20, 16, 20, 16);
     saldoLayout->setSpacing(6);
-    auto *saldoTitulo = new QLabel("Saldo Atual");
+    auto *saldoTitulo = new QLabel("Saldo do Período");
     saldoTitulo->setStyleSheet("font-size: 11px; font-weight: 500; color: palette(mid);");
     m_valorSaldo = new QLabel("R$ 0,00");
     m_valorSaldo->setStyleSheet("font-size: 26px; font-weight: 600;");
@@ -80,91 +85,192 @@ DashboardWidget::DashboardWidget(QWidget *parent)
     cardsRow->addWidget(cardSaldo);
     root->addLayout(cardsRow);
 
-    // ── Gráfico ───────────────────────────────────────────────────────────────
-    m_chartView = new QChartView;
-    m_chartView->setRenderHint(QPainter::Antialiasing);
-    m_chartView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_chartView->setStyleSheet("border: none; background: transparent;");
-
-    auto *chart = new QChart;
-    chart->setTitle("");
-    chart->setBackgroundVisible(false);
-    chart->setMargins(QMargins(0, 0, 0, 0));
-    m_chartView->setChart(chart);
-
-    root->addWidget(m_chartView);
+    m_parcelas = new QLabel;
+    m_parcelas->setStyleSheet("font-size: 12px; color: palette(mid);");
+    root->addWidget(m_parcelas);
+
+    // ── Gráficos ──────────────────────────────────────────────────────────────
+    // Pintados em QImage fora da thread da GUI e guardados por versão dos
+    // dados, tamanho, DPI e tema: repintar ou voltar à aba só copia pixels
+    m_donut     = new ImagemGrafico;
+    m_tendencia = new GraficoTendencia;
+
+    auto *graficosRow = new QHBoxLayout;
+    graficosRow->setSpacing(16);
+    graficosRow->addWidget(m_donut, 1);
+    graficosRow->addWidget(m_tendencia, 2);
+    root->addLayout(graficosRow, 1);
+
+    // ── Orçamentos do mês ─────────────────────────────────────────────────────
+    m_orcamentos = new QWidget;
+    auto *orcamentosLayout = new QVBoxLayout(m_orcamentos);
+    orcamentosLayout->setContentsMargins(0, 0, 0, 0);
+    orcamentosLayout->setSpacing(8);
+    m_tituloOrcamentos = new QLabel;
+    m_tituloOrcamentos->setStyleSheet("font-size: 13px; font-weight: 500;");
+    orcamentosLayout->addWidget(m_tituloOrcamentos);
+    m_gradeOrcamentos = new QGridLayout;
+    m_gradeOrcamentos->setHorizontalSpacing(12);
+    m_gradeOrcamentos->setVerticalSpacing(6);
+    m_gradeOrcamentos->setColumnStretch(1, 1);
+    orcamentosLayout->addLayout(m_gradeOrcamentos);
+    root->addWidget(m_orcamentos);
+
+    // ── Gastos por categoria ──────────────────────────────────────────────────
+    m_categorias = new QTableWidget(0, 6, this);
+    m_categorias->setHorizontalHeaderLabels(
+        {"Categoria", "Lançamentos", "Mediana", "p90", "p99", "Mediana mensal"});
+    m_categorias->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_categorias->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_categorias->verticalHeader()->setVisible(false);
+    m_categorias->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_categorias->setSelectionMode(QAbstractItemView::NoSelection);
+    m_categorias->setAlternatingRowColors(true);
+    m_categorias->setShowGrid(false);
+    m_categorias->setMaximumHeight(200);
+    root->addWidget(m_categorias);
 
     atualizar();
 }
 
 // ── Atualizar ─────────────────────────────────────────────────────────────────
 
-void DashboardWidget::atualizar()
+void DashboardWidget::definirPeriodo(const Periodo &periodo)
 {
-    auto &db = DatabaseManager::instance();
+    if (periodo == m_periodo) return;
+    m_periodo = periodo;
+    m_tendencia->definirPeriodo(periodo);
+    atualizar();
+}
 
-    const qint64 entradas  = db.totalEntradas();
-    const qint64 fixos     = db.totalGastosFixos();
-    const qint64 variaveis = db.totalGastosVariaveis();
+void DashboardWidget::atualizar()
+{
+    TRACE_SPAN("DashboardWidget::atualizar", "ui");
+    // Totais do cache colunar: sem ida ao SQLite a cada dadosAlterados; o
+    // período vira uma fatia por busca binária nas colunas ordenadas por dia
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    const QDate inicio = m_periodo.inicio, fim = m_periodo.fim;
+
+    const qint64 entradas  = cache.soma(TipoLancamento::Entrada,       inicio, fim);
+    const qint64 fixos     = cache.soma(TipoLancamento::GastoFixo,     inicio, fim);
+    // Parcelas já estão no cache como gastos variáveis (como no calendário,
+    // na tendência e nos orçamentos); a linha abaixo dos cards só as destaca
+    DatabaseManager &db = DatabaseManager::instance();
+    const qint64 parcelas  = db.totalParcelas(m_periodo);
+    const qint64 aVencer   = db.parcelasAVencer(fim.isValid() ? qMin(fim, QDate::currentDate())
+                                                              : QDate::currentDate());
+    const qint64 variaveis = cache.soma(TipoLancamento::GastoVariavel, inicio, fim);
     const qint64 saldo     = entradas - fixos - variaveis;
 
     m_valorEntradas->setText(centavosParaTexto(entradas));
     m_valorFixos->setText(centavosParaTexto(fixos));
     m_valorVariaveis->setText(centavosParaTexto(variaveis));
     m_valorSaldo->setText(centavosParaTexto(saldo));
+    m_parcelas->setVisible(parcelas > 0 || aVencer > 0);
+    m_parcelas->setText(QString("Compras parceladas: %1 no período (incluído nos variáveis) · "
+                                "%2 a vencer")
+                            .arg(centavosParaTexto(parcelas), centavosParaTexto(aVencer)));
 
     atualizarCores(saldo);
 
     // ── Gráfico de pizza ──────────────────────────────────────────────────────
-    auto *series = new QPieSeries;
-    series->setHoleSize(0.40); // donut moderno
-
-    const bool dark = Theme::isDark();
-    const QColor corEntradas  = dark ? QColor("#22A367") : QColor("#166F4A");
-    const QColor corFixos     = dark ? QColor("#E85555") : QColor("#C94040");
-    const QColor corVariaveis = dark ? QColor("#D4A017") : QColor("#B8860B");
-
-    if (entradas > 0) {
-        auto *sl = series->append("Entradas",        entradas / 100.0);
-        sl->setColor(corEntradas);
-        sl->setLabelVisible(true);
-    }
-    if (fixos > 0) {
-        auto *sl = series->append("Gastos Fixos",    fixos / 100.0);
-        sl->setColor(corFixos);
-        sl->setLabelVisible(true);
-    }
-    if (variaveis > 0) {
-        auto *sl = series->append("Gastos Variáveis", variaveis / 100.0);
-        sl->setColor(corVariaveis);
-        sl->setLabelVisible(true);
-    }
+    // Só os números entram na versão: com os mesmos totais e título a imagem
+    // guardada é reaproveitada, sem nova renderização
+    DesenhoGraficos::Donut donut;
+    donut.titulo = "Distribuição — " + SeletorPeriodo::descrever(m_periodo);
+    if (entradas > 0)
+        donut.fatias.append({"Entradas",         entradas,  QColor("#166F4A"), QColor("#22A367")});
+    if (fixos > 0)
+        donut.fatias.append({"Gastos Fixos",     fixos,     QColor("#C94040"), QColor("#E85555")});
+    if (variaveis > 0)
+        donut.fatias.append({"Gastos Variáveis", variaveis, QColor("#B8860B"), QColor("#D4A017")});
+
+    m_donut->definirDesenho(qHashMulti(0, donut.titulo, entradas, fixos, variaveis),
+                            [donut](QPainter &p, const QRectF &area, bool escuro) {
+        DesenhoGraficos::donut(p, area, donut, escuro);
+    });
+
+    m_tendencia->atualizar();
+    atualizarOrcamentos();
+    atualizarCategorias();
+}
 
-    // Sem dados: placeholder
-    if (series->count() == 0) {
-        auto *sl = series->append("Sem dados", 1);
-        sl->setColor(dark ? QColor("#32323A") : QColor("#E0DED8"));
-        sl->setLabelVisible(false);
+// Uma barra por categoria com orçamento, no mês do fim do período (o mês
+// corrente em "Tudo" ou se o fim ainda não chegou). Gasto do mês pela soma
+// mantida pelas mutações: O(1) por categoria, sem SUM no banco.
+void DashboardWidget::atualizarOrcamentos()
+{
+    DatabaseManager &db = DatabaseManager::instance();
+    const QHash<int, qint64> orcamentos = db.orcamentos();
+    m_orcamentos->setVisible(!orcamentos.isEmpty());
+    if (orcamentos.isEmpty()) return;
+
+    const QDate hoje = QDate::currentDate();
+    const QDate mes  = m_periodo.fim.isValid() ? qMin(m_periodo.fim, hoje) : hoje;
+    m_tituloOrcamentos->setText("Orçamentos — " + mes.toString("MM/yyyy"));
+
+    while (QLayoutItem *item = m_gradeOrcamentos->takeAt(0)) {
+        delete item->widget();
+        delete item;
     }
 
-    for (auto *sl : series->slices()) {
-        sl->setLabelColor(dark ? QColor("#F0EFED") : QColor("#18181A"));
-        sl->setBorderColor(Qt::transparent);
-        sl->setLabelPosition(QPieSlice::LabelOutside);
+    const bool    dark    = Theme::isDark();
+    const QString verde   = dark ? "#22A367" : "#166F4A";
+    const QString amarelo = dark ? "#D4A017" : "#B8860B";
+    const QString verme   = dark ? "#E85555" : "#C94040";
+
+    int row = 0;
+    for (const Categoria &cat : db.listarCategorias()) {
+        if (!orcamentos.contains(cat.id)) continue;
+        const ConsumoOrcamento c = db.consumoOrcamento(cat.id, mes);
+        const int percentual = int(c.fracao() * 100 + 0.5);
+
+        auto *barra = new QProgressBar;
+        barra->setRange(0, 100);
+        barra->setValue(qMin(percentual, 100));
+        barra->setFormat(QString("%1%").arg(percentual));
+        barra->setFixedHeight(16);
+        barra->setStyleSheet(QString("QProgressBar::chunk { background-color: %1; border-radius: 3px; }")
+            .arg(c.estourado() ? verme : c.fracao() >= 0.8 ? amarelo : verde));
+
+        auto *valores = new QLabel(centavosParaTexto(c.gastoCentavos) + " de "
+                                   + centavosParaTexto(c.limiteCentavos));
+        valores->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        if (c.estourado()) valores->setStyleSheet(QString("color: %1;").arg(verme));
+
+        m_gradeOrcamentos->addWidget(new QLabel(cat.nome), row, 0);
+        m_gradeOrcamentos->addWidget(barra,                row, 1);
+        m_gradeOrcamentos->addWidget(valores,              row, 2);
+        ++row;
     }
+}
 
-    auto *chart = new QChart;
-    chart->addSeries(series);
-    chart->setTitle("Distribuição do período");
-    chart->setTitleFont(QFont("Inter", 13, QFont::DemiBold));
-    chart->setTitleBrush(dark ? QColor("#F0EFED") : QColor("#18181A"));
-    chart->setBackgroundVisible(false);
-    chart->setMargins(QMargins(8, 8, 8, 8));
-    chart->legend()->setFont(QFont("Inter", 11));
-    chart->legend()->setLabelColor(dark ? QColor("#9A9895") : QColor("#6E6D6A"));
-    chart->legend()->setAlignment(Qt::AlignBottom);
-
-    m_chartView->setChart(chart);
+// Quantis dos sketches por categoria e mês: mesclar os meses do período, sem
+// ler nem ordenar lançamentos
+void DashboardWidget::atualizarCategorias()
+{
+    const EstatisticasCategoria &estatisticas = DatabaseManager::instance().estatisticasCategoria();
+    const QDate inicio = m_periodo.inicio, fim = m_periodo.fim;
+
+    m_categorias->setUpdatesEnabled(false);
+    m_categorias->setRowCount(0);
+    for (const Categoria &cat : DatabaseManager::instance().listarCategorias()) {
+        const EstatisticasCategoria::Resumo r = estatisticas.resumo(cat.id, inicio, fim);
+        if (r.quantidade == 0) continue;
+        const EstatisticasCategoria::Resumo mensal = estatisticas.resumoMensal(cat.id, inicio, fim);
+
+        const int row = m_categorias->rowCount();
+        m_categorias->insertRow(row);
+        const QStringList colunas = {cat.nome, QString::number(r.quantidade),
+                                     centavosParaTexto(r.mediana), centavosParaTexto(r.p90),
+                                     centavosParaTexto(r.p99), centavosParaTexto(mensal.mediana)};
+        for (int col = 0; col < colunas.size(); ++col) {
+            auto *item = new QTableWidgetItem(colunas.at(col));
+            if (col > 0) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_categorias->setItem(row, col, item);
+        }
+    }
+    m_categorias->setUpdatesEnabled(true);
 }
 
 void DashboardWidget::atualizarCores(qint64 saldo)
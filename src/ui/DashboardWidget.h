@@ -1,10 +1,16 @@
 #pragma once
 
+#include "models/Periodo.h"
+
 #include <QLabel>
 #include <QWidget>
-#include <QtCharts/QChartView>
 #include <QtGlobal>
 
+class GraficoTendencia;
+class ImagemGrafico;
+class QGridLayout;
+class QTableWidget;
+
 class DashboardWidget : public QWidget
 {
     Q_OBJECT
@@ -12,18 +18,30 @@ class DashboardWidget : public QWidget
 public:
     explicit DashboardWidget(QWidget *parent = nullptr);
 
+    // Período selecionado na janela; cards e gráfico passam a somar só ele
+    void definirPeriodo(const Periodo &periodo);
+
 public slots:
     void atualizar();
 
 private:
     QWidget    *makeCard(const QString &titulo, QLabel *&valorLabel);
     void        atualizarCores(qint64 saldo);
+    void        atualizarCategorias();
+    void        atualizarOrcamentos();
 
     // Cards de resumo
     QLabel *m_valorEntradas;
     QLabel *m_valorFixos;
     QLabel *m_valorVariaveis;
     QLabel *m_valorSaldo;
+    QLabel *m_parcelas;  // parcelas no período e a vencer; oculto sem compras parceladas
 
-    QChartView *m_chartView;
+    ImagemGrafico    *m_donut;
+    GraficoTendencia *m_tendencia;
+    QTableWidget     *m_categorias;
+    QWidget          *m_orcamentos;       // oculto sem nenhum orçamento definido
+    QLabel           *m_tituloOrcamentos;
+    QGridLayout      *m_gradeOrcamentos;  // categoria | barra | gasto de limite
+    Periodo           m_periodo;
 };
@@ -0,0 +1,74 @@
+#include "ui/DelegateHistorico.h"
+
+#include "core/IndiceAutocomplete.h"
+#include "utils/CurrencyUtils.h"
+
+#include <QAbstractItemView>
+#include <QCompleter>
+#include <QLineEdit>
+#include <QStandardItemModel>
+
+static constexpr int HIST_ROLE  = Qt::UserRole;
+static constexpr int CAT_ROLE   = Qt::UserRole + 1;
+static constexpr int VALOR_ROLE = Qt::UserRole + 2;
+
+DelegateHistorico::DelegateHistorico(TipoLancamento tipo, QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_indice(new IndiceAutocomplete(tipo))
+{
+}
+
+DelegateHistorico::~DelegateHistorico()
+{
+    delete m_indice;
+}
+
+void DelegateHistorico::definirCategorias(const QList<Categoria> &categorias)
+{
+    m_categorias.clear();
+    for (const Categoria &cat : categorias)
+        m_categorias.insert(cat.id, cat.nome);
+}
+
+QWidget *DelegateHistorico::createEditor(QWidget *parent, const QStyleOptionViewItem &,
+                                         const QModelIndex &index) const
+{
+    auto *editor = new QLineEdit(parent);
+    editor->setFrame(false);
+
+    // O índice já ordena e limita: o completer só exibe, sem filtrar de novo
+    auto *modelo    = new QStandardItemModel(editor);
+    auto *completer = new QCompleter(modelo, editor);
+    completer->setWidget(editor);
+    completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+
+    connect(editor, &QLineEdit::textEdited, completer, [this, modelo, completer](const QString &texto) {
+        modelo->clear();
+        for (const SugestaoHistorico &s : m_indice->sugerir(texto)) {
+            QString rotulo = s.historico;
+            if (s.categoriaId > 0 && m_categorias.contains(s.categoriaId))
+                rotulo += "  ·  " + m_categorias.value(s.categoriaId);
+            rotulo += "  ·  " + centavosParaTexto(s.valorCentavos);
+
+            auto *item = new QStandardItem(rotulo);
+            item->setData(s.historico,     HIST_ROLE);
+            item->setData(s.categoriaId,   CAT_ROLE);
+            item->setData(s.valorCentavos, VALOR_ROLE);
+            modelo->appendRow(item);
+        }
+        if (modelo->rowCount() > 0) completer->complete();
+        else completer->popup()->hide();
+    });
+
+    const int row = index.row();
+    connect(completer, qOverload<const QModelIndex &>(&QCompleter::activated), editor,
+            [this, editor, row](const QModelIndex &escolhido) {
+        const QString historico = escolhido.data(HIST_ROLE).toString();
+        editor->setText(historico);
+        emit const_cast<DelegateHistorico *>(this)->sugestaoEscolhida(
+            row, historico, escolhido.data(CAT_ROLE).toInt(),
+            escolhido.data(VALOR_ROLE).toLongLong());
+    });
+
+    return editor;
+}
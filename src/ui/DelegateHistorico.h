@@ -0,0 +1,37 @@
+#pragma once
+
+#include "models/Categoria.h"
+#include "models/Lancamento.h"
+
+#include <QHash>
+#include <QList>
+#include <QStyledItemDelegate>
+
+class IndiceAutocomplete;
+
+// Editor da coluna Histórico com autocompletar: a cada tecla consulta o
+// IndiceAutocomplete do tipo e lista "histórico · categoria · último valor".
+// Escolher uma sugestão emite sugestaoEscolhida() para a aba preencher
+// categoria e valor da mesma linha.
+class DelegateHistorico : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+signals:
+    void sugestaoEscolhida(int row, const QString &historico,
+                           int categoriaId, qint64 valorCentavos);
+
+public:
+    explicit DelegateHistorico(TipoLancamento tipo, QObject *parent = nullptr);
+    ~DelegateHistorico() override;
+
+    // Nomes exibidos nas sugestões
+    void definirCategorias(const QList<Categoria> &categorias);
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+
+private:
+    IndiceAutocomplete  *m_indice;
+    QHash<int, QString>  m_categorias;  // id → nome
+};
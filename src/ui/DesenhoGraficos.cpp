@@ -0,0 +1,211 @@
+#include "ui/DesenhoGraficos.h"
+
+#include <QDateTime>
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QPainterPath>
+#include <QPolygonF>
+#include <QtMath>
+
+#include <cmath>
+
+namespace DesenhoGraficos {
+
+// Margens da área de plotagem em linhas(): rótulos do eixo y à esquerda,
+// rótulos do eixo x e legenda embaixo
+static constexpr qreal MARGEM_ESQUERDA = 64;
+static constexpr qreal MARGEM_DIREITA  = 12;
+static constexpr qreal MARGEM_TOPO     = 8;
+static constexpr qreal ALTURA_EIXO_X   = 22;
+static constexpr qreal ALTURA_LEGENDA  = 24;
+
+static QColor corTexto(bool escuro)      { return escuro ? QColor("#F0EFED") : QColor("#18181A"); }
+static QColor corSecundaria(bool escuro) { return escuro ? QColor("#9A9895") : QColor("#6E6D6A"); }
+static QColor corGrade(bool escuro)      { return escuro ? QColor("#32323A") : QColor("#E0DED8"); }
+
+// Legenda centrada: marcador + nome por item
+template <typename Item, typename Marcador>
+static void legenda(QPainter &p, const QRectF &faixa, const QList<Item> &itens,
+                    bool escuro, Marcador marcador)
+{
+    const QFontMetricsF fm(p.font());
+    constexpr qreal MARCADOR = 14, RESPIRO = 6, ENTRE = 16;
+
+    qreal largura = 0;
+    for (const Item &item : itens)
+        largura += MARCADOR + RESPIRO + fm.horizontalAdvance(item.nome) + ENTRE;
+    largura -= ENTRE;
+
+    qreal x = faixa.center().x() - largura / 2;
+    const qreal meio = faixa.center().y();
+    for (const Item &item : itens) {
+        const QColor cor = escuro ? item.corEscura : item.corClara;
+        marcador(QRectF(x, meio - MARCADOR / 2, MARCADOR, MARCADOR), cor);
+        x += MARCADOR + RESPIRO;
+        const qreal texto = fm.horizontalAdvance(item.nome);
+        p.setPen(corSecundaria(escuro));
+        p.drawText(QRectF(x, faixa.top(), texto + 1, faixa.height()), Qt::AlignVCenter, item.nome);
+        x += texto + ENTRE;
+    }
+}
+
+// ── Donut ─────────────────────────────────────────────────────────────────────
+
+void donut(QPainter &p, const QRectF &area, const Donut &d, bool escuro)
+{
+    const QRectF r = area.adjusted(8, 8, -8, -8);
+
+    p.setFont(QFont("Inter", 13, QFont::DemiBold));
+    p.setPen(corTexto(escuro));
+    const qreal alturaTitulo = QFontMetricsF(p.font()).height() + 8;
+    p.drawText(QRectF(r.left(), r.top(), r.width(), alturaTitulo),
+               Qt::AlignHCenter | Qt::AlignTop, d.titulo);
+
+    p.setFont(QFont("Inter", 11));
+    const QFontMetricsF fm(p.font());
+    const qreal alturaLegenda = fm.height() + 8;
+    const QRectF faixaLegenda(r.left(), r.bottom() - alturaLegenda, r.width(), alturaLegenda);
+    const QRectF corpo(r.left(), r.top() + alturaTitulo,
+                       r.width(), r.height() - alturaTitulo - alturaLegenda);
+
+    QList<Fatia> fatias = d.fatias;
+    const bool vazio = fatias.isEmpty();
+    if (vazio)
+        fatias.append({"Sem dados", 1, QColor("#E0DED8"), QColor("#32323A")});
+
+    qint64 total = 0;
+    qreal  maiorRotulo = 0;
+    for (const Fatia &f : std::as_const(fatias)) {
+        total += f.valor;
+        maiorRotulo = qMax(maiorRotulo, fm.horizontalAdvance(f.nome));
+    }
+    if (vazio) maiorRotulo = 0;  // o placeholder não tem rótulo
+
+    // Rótulos fora do anel: o raio cede espaço ao maior deles
+    const qreal raio = qMax<qreal>(12, qMin(corpo.width() / 2 - maiorRotulo - 20,
+                                            corpo.height() / 2 - fm.height() - 8));
+    const QPointF centro = corpo.center();
+    const QRectF  externo(centro - QPointF(raio, raio), QSizeF(2 * raio, 2 * raio));
+    const qreal   furo = raio * 0.40;
+    const QRectF  interno(centro - QPointF(furo, furo), QSizeF(2 * furo, 2 * furo));
+
+    qreal angulo = 90;  // começa às 12 horas, sentido horário
+    for (const Fatia &f : std::as_const(fatias)) {
+        const QColor cor  = escuro ? f.corEscura : f.corClara;
+        const qreal  arco = -360.0 * qreal(f.valor) / qreal(total);
+
+        QPainterPath caminho;
+        caminho.arcMoveTo(externo, angulo);
+        caminho.arcTo(externo, angulo, arco);
+        caminho.arcTo(interno, angulo + arco, -arco);
+        caminho.closeSubpath();
+        p.fillPath(caminho, cor);
+
+        if (!vazio) {
+            const qreal   meio = qDegreesToRadians(angulo + arco / 2);
+            const QPointF direcao(qCos(meio), -qSin(meio));
+            const QPointF ponta = centro + direcao * (raio + 14);
+            p.setPen(QPen(cor, 1));
+            p.drawLine(centro + direcao * (raio + 4), ponta);
+
+            const qreal   largura = fm.horizontalAdvance(f.nome) + 1;
+            const bool    direita = direcao.x() >= 0;
+            const QRectF  caixa(direita ? ponta.x() + 4 : ponta.x() - 4 - largura,
+                                ponta.y() - fm.height() / 2, largura, fm.height());
+            p.setPen(corTexto(escuro));
+            p.drawText(caixa, Qt::AlignVCenter | (direita ? Qt::AlignLeft : Qt::AlignRight), f.nome);
+        }
+        angulo += arco;
+    }
+
+    legenda(p, faixaLegenda, fatias, escuro, [&p](const QRectF &marcador, const QColor &cor) {
+        p.setPen(Qt::NoPen);
+        p.setBrush(cor);
+        p.drawRoundedRect(marcador.adjusted(2, 2, -2, -2), 2, 2);
+    });
+}
+
+// ── Linhas ────────────────────────────────────────────────────────────────────
+
+QRectF areaPlotagem(const QRectF &area)
+{
+    return area.adjusted(MARGEM_ESQUERDA, MARGEM_TOPO,
+                         -MARGEM_DIREITA, -(ALTURA_EIXO_X + ALTURA_LEGENDA));
+}
+
+// 1, 2 ou 5 × 10^n mais próximo acima de `bruto`
+static qreal passoRedondo(qreal bruto)
+{
+    if (bruto <= 0) return 1;
+    const qreal magnitude = std::pow(10.0, std::floor(std::log10(bruto)));
+    const qreal r = bruto / magnitude;
+    return (r <= 1 ? 1 : r <= 2 ? 2 : r <= 5 ? 5 : 10) * magnitude;
+}
+
+void linhas(QPainter &p, const QRectF &area, const Linhas &l, bool escuro)
+{
+    const QRectF plot = areaPlotagem(area);
+    if (plot.width() < 8 || plot.height() < 8) return;
+
+    const qreal larguraX = qMax<qreal>(l.xMax - l.xMin, 1);
+    const qreal yMax     = l.yMax > 0 ? l.yMax : 1;
+    auto mapear = [&](const QPointF &d) {
+        return QPointF(plot.left() + (d.x() - l.xMin) / larguraX * plot.width(),
+                       plot.bottom() - d.y() / yMax * plot.height());
+    };
+
+    p.setFont(QFont("Inter", 10));
+    const QFontMetricsF fm(p.font());
+    const QPen grade(corGrade(escuro), 1);
+
+    // ── Eixo y ────────────────────────────────────────────────────────────────
+    const qreal passoY = passoRedondo(yMax / 5);
+    for (qreal v = 0; v <= yMax * 1.0001; v += passoY) {
+        const qreal y = plot.bottom() - v / yMax * plot.height();
+        p.setPen(grade);
+        p.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+        p.setPen(corSecundaria(escuro));
+        p.drawText(QRectF(area.left(), y - fm.height() / 2, plot.left() - area.left() - 6, fm.height()),
+                   Qt::AlignRight | Qt::AlignVCenter, QString::number(v, 'f', 0));
+    }
+
+    // ── Eixo x ────────────────────────────────────────────────────────────────
+    const int divisoes = qMax(2, int(plot.width() / 110));
+    for (int i = 0; i <= divisoes; ++i) {
+        const qreal x  = plot.left() + plot.width() * i / divisoes;
+        const qreal ms = l.xMin + larguraX * i / divisoes;
+        p.setPen(grade);
+        p.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+
+        const QString rotulo  = QDateTime::fromMSecsSinceEpoch(qint64(ms)).toString(l.formatoData);
+        const qreal   largura = fm.horizontalAdvance(rotulo) + 1;
+        const qreal   esquerda = qBound(area.left(), x - largura / 2, area.right() - largura);
+        p.setPen(corSecundaria(escuro));
+        p.drawText(QRectF(esquerda, plot.bottom() + 4, largura, ALTURA_EIXO_X - 4),
+                   Qt::AlignHCenter | Qt::AlignTop, rotulo);
+    }
+
+    // ── Séries ────────────────────────────────────────────────────────────────
+    p.save();
+    p.setClipRect(plot.adjusted(-2, -2, 2, 2));
+    p.setBrush(Qt::NoBrush);
+    for (const Serie &serie : l.series) {
+        QPolygonF poligono;
+        poligono.reserve(serie.pontos.size());
+        for (const QPointF &ponto : serie.pontos) poligono.append(mapear(ponto));
+        p.setPen(QPen(escuro ? serie.corEscura : serie.corClara, 2,
+                      Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        p.drawPolyline(poligono);
+    }
+    p.restore();
+
+    p.setFont(QFont("Inter", 11));
+    const QRectF faixaLegenda(area.left(), area.bottom() - ALTURA_LEGENDA, area.width(), ALTURA_LEGENDA);
+    legenda(p, faixaLegenda, l.series, escuro, [&p](const QRectF &marcador, const QColor &cor) {
+        p.setPen(QPen(cor, 2, Qt::SolidLine, Qt::RoundCap));
+        p.drawLine(QPointF(marcador.left(), marcador.center().y()),
+                   QPointF(marcador.right(), marcador.center().y()));
+    });
+}
+
+} // namespace DesenhoGraficos
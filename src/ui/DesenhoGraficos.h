@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QColor>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+
+class QPainter;
+
+// Gráficos do Dashboard pintados só com QPainter — sem QGraphicsScene, então
+// podem rodar numa thread do pool sobre um QImage (ver ImagemGrafico). Cada
+// estrutura é um valor autocontido: é copiada para a tarefa de renderização.
+namespace DesenhoGraficos {
+
+struct Fatia
+{
+    QString nome;
+    qint64  valor = 0;  // centavos; só a proporção importa
+    QColor  corClara;
+    QColor  corEscura;
+};
+
+struct Donut
+{
+    QString      titulo;
+    QList<Fatia> fatias;  // valor > 0; vazia desenha o anel cinza de "Sem dados"
+};
+
+struct Serie
+{
+    QString        nome;
+    QList<QPointF> pontos;  // x em ms desde a época, y em reais
+    QColor         corClara;
+    QColor         corEscura;
+};
+
+struct Linhas
+{
+    QList<Serie> series;
+    qreal        xMin = 0, xMax = 1;  // ms
+    qreal        yMax = 1;            // reais
+    QString      formatoData;         // rótulos do eixo x (QDateTime::toString)
+};
+
+void donut(QPainter &p, const QRectF &area, const Donut &d, bool escuro);
+void linhas(QPainter &p, const QRectF &area, const Linhas &l, bool escuro);
+
+// Retângulo dos dados dentro de `area` em linhas(): para converter pixels de
+// uma seleção do usuário em datas
+QRectF areaPlotagem(const QRectF &area);
+
+} // namespace DesenhoGraficos
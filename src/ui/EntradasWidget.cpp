@@ -2,7 +2,9 @@
 
 #include "core/DatabaseManager.h"
 #include "models/Entrada.h"
+#include "ui/CampoBusca.h"
 #include "utils/CurrencyUtils.h"
+#include "utils/Tracer.h"
 
 #include <QDate>
 #include <QHBoxLayout>
@@ -44,6 +46,14 @@ EntradasWidget::EntradasWidget(QWidget *parent)
     root->setContentsMargins(24, 24, 24, 16);
     root->setSpacing(12);
 
+    // ── Busca ─────────────────────────────────────────────────────────────────
+    m_busca = new CampoBusca;
+    root->addWidget(m_busca);
+    connect(m_busca, &CampoBusca::buscaAlterada, this, [this](const QString &texto) {
+        m_filtro = texto;
+        aplicarFiltro();
+    });
+
     // ── Tabela ────────────────────────────────────────────────────────────────
     m_tabela = new QTableWidget(0, 3, this);
     m_tabela->setHorizontalHeaderLabels({"Data", "Origem / Descrição", "Valor"});
@@ -80,17 +90,26 @@ EntradasWidget::EntradasWidget(QWidget *parent)
 
 void EntradasWidget::carregar()
 {
+    TRACE_SPAN("EntradasWidget::carregar", "ui");
     m_carregando = true;
     m_tabela->setRowCount(0);
 
-    for (const Entrada &e : DatabaseManager::instance().listarEntradas())
+    for (const Entrada &e : DatabaseManager::instance().listarEntradas(m_periodo))
         adicionarLinha(e.id, e.data, e.origem, e.valorCentavos);
 
     inserirLinhaTotalVazia();
     atualizarTotal();
+    aplicarFiltro();
     m_carregando = false;
 }
 
+void EntradasWidget::definirPeriodo(const Periodo &periodo)
+{
+    if (periodo == m_periodo) return;
+    m_periodo = periodo;
+    carregar();
+}
+
 void EntradasWidget::adicionarLinha(int id, const QDate &data,
                                      const QString &origem, qint64 valorCentavos)
 {
@@ -146,6 +165,21 @@ void EntradasWidget::atualizarTotal()
     m_carregando = false;
 }
 
+// Busca por texto (FTS5): esconde as linhas fora do resultado; TOTAL sempre visível
+void EntradasWidget::aplicarFiltro()
+{
+    const int totalRow = m_tabela->rowCount() - 1;
+    if (m_filtro.isEmpty()) {
+        for (int r = 0; r < totalRow; ++r)
+            m_tabela->setRowHidden(r, false);
+        return;
+    }
+
+    const QSet<int> ids = DatabaseManager::instance().buscarIds(TipoLancamento::Entrada, m_filtro);
+    for (int r = 0; r < totalRow; ++r)
+        m_tabela->setRowHidden(r, !ids.contains(idDaLinha(r)));
+}
+
 // ── Adicionar ─────────────────────────────────────────────────────────────────
 
 void EntradasWidget::adicionarEntrada()
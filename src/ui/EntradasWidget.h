@@ -1,8 +1,12 @@
 #pragma once
 
+#include "models/Periodo.h"
+
 #include <QTableWidget>
 #include <QWidget>
 
+class CampoBusca;
+
 class EntradasWidget : public QWidget
 {
     Q_OBJECT
@@ -13,20 +17,29 @@ signals:
 public:
     explicit EntradasWidget(QWidget *parent = nullptr);
 
+    // Relê o banco e reconstrói a tabela
+    void carregar();
+
+    // Período selecionado na janela; recarrega só as linhas dele
+    void definirPeriodo(const Periodo &periodo);
+
 private slots:
     void adicionarEntrada();
     void removerEntrada();
     void onItemChanged(QTableWidgetItem *item);
 
 private:
-    void carregar();
     void adicionarLinha(int id, const QDate &data,
                         const QString &origem, qint64 valorCentavos);
     void inserirLinhaTotalVazia();
     void atualizarTotal();
+    void aplicarFiltro();
     int  idDaLinha(int row) const;
     bool isTotalRow(int row) const;
 
     QTableWidget *m_tabela;
+    CampoBusca   *m_busca;
+    QString       m_filtro;             // texto da busca ativa
+    Periodo       m_periodo;
     bool          m_carregando = false; // bloqueia itemChanged durante load
 };
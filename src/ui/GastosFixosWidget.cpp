@@ -1,13 +1,19 @@
 #include "ui/GastosFixosWidget.h"
 
 #include "core/DatabaseManager.h"
+#include "ui/CampoBusca.h"
+#include "ui/DelegateHistorico.h"
+#include "ui/Theme.h"
 #include "utils/CurrencyUtils.h"
+#include "utils/Fingerprint.h"
+#include "utils/Tracer.h"
 
 #include <QDate>
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QSet>
 #include <QTableWidgetItem>
 #include <QVBoxLayout>
 
@@ -17,6 +23,8 @@ static constexpr int COL_VALOR = 2;
 static constexpr int COL_CAT   = 3;
 static constexpr int ID_ROLE   = Qt::UserRole;
 static constexpr int CATID_ROLE = Qt::UserRole + 1; // id da categoria no combo
+static constexpr int OCORRENCIA_ROLE = Qt::UserRole + 2; // linha prevista: índice em m_pendentes
+static constexpr int ORCAMENTO_ROLE = Qt::UserRole + 3; // par (categoria, mês) no índice de orçamentos
 
 // ── Helpers de item ───────────────────────────────────────────────────────────
 
@@ -36,6 +44,12 @@ static QTableWidgetItem *makeTotalItem(const QString &texto)
     return item;
 }
 
+// Par (categoria, mês) do índice de orçamentos numa chave de 64 bits
+static quint64 chaveOrcamento(int categoriaId, const QDate &data)
+{
+    return quint64(quint32(categoriaId)) << 32 | quint32(data.year() * 12 + data.month() - 1);
+}
+
 // ── Construtor ────────────────────────────────────────────────────────────────
 
 GastosFixosWidget::GastosFixosWidget(QWidget *parent)
@@ -45,6 +59,14 @@ GastosFixosWidget::GastosFixosWidget(QWidget *parent)
     root->setContentsMargins(24, 24, 24, 16);
     root->setSpacing(12);
 
+    // ── Busca ─────────────────────────────────────────────────────────────────
+    m_busca = new CampoBusca;
+    root->addWidget(m_busca);
+    connect(m_busca, &CampoBusca::buscaAlterada, this, [this](const QString &texto) {
+        m_filtro = texto;
+        aplicarFiltro();
+    });
+
     m_tabela = new QTableWidget(0, 4, this);
     m_tabela->setHorizontalHeaderLabels({"Data", "Histórico", "Valor", "Categoria"});
     m_tabela->horizontalHeader()->setSectionResizeMode(COL_DATA,  QHeaderView::ResizeToContents);
@@ -56,25 +78,40 @@ GastosFixosWidget::GastosFixosWidget(QWidget *parent)
     m_tabela->setSelectionMode(QAbstractItemView::SingleSelection);
     m_tabela->setAlternatingRowColors(true);
     m_tabela->setShowGrid(false);
+
+    // Autocompletar do histórico: escolher uma sugestão preenche categoria e valor
+    m_delegateHist = new DelegateHistorico(TipoLancamento::GastoFixo, this);
+    m_tabela->setItemDelegateForColumn(COL_HIST, m_delegateHist);
+    connect(m_delegateHist, &DelegateHistorico::sugestaoEscolhida, this,
+            [this](int row, const QString &historico, int categoriaId, qint64 valorCentavos) {
+        m_sugestao = {row, historico, categoriaId, valorCentavos};
+    });
+
     root->addWidget(m_tabela);
 
     auto *btnAdicionar = new QPushButton("+ Adicionar gasto fixo");
     auto *btnRemover   = new QPushButton("Remover selecionado");
     auto *btnRepetir   = new QPushButton("Repetir mês anterior");
+    auto *btnConfirmar = new QPushButton("Confirmar previsto");
     btnRemover->setProperty("secondary", true);
     btnRepetir->setProperty("secondary", true);
+    btnConfirmar->setProperty("secondary", true);
+    btnRepetir->setToolTip("Transforma os gastos fixos do mês anterior em recorrências: "
+                           "a cada mês aparecem como previstos, sem gravar nada até confirmar");
 
     auto *botoesRow = new QHBoxLayout;
     botoesRow->setSpacing(8);
     botoesRow->addWidget(btnAdicionar);
     botoesRow->addWidget(btnRemover);
     botoesRow->addWidget(btnRepetir);
+    botoesRow->addWidget(btnConfirmar);
     botoesRow->addStretch();
     root->addLayout(botoesRow);
 
     connect(btnAdicionar, &QPushButton::clicked, this, &GastosFixosWidget::adicionarGasto);
     connect(btnRemover,   &QPushButton::clicked, this, &GastosFixosWidget::removerGasto);
     connect(btnRepetir,   &QPushButton::clicked, this, &GastosFixosWidget::repetirMesAnterior);
+    connect(btnConfirmar, &QPushButton::clicked, this, &GastosFixosWidget::confirmarOcorrencia);
     connect(m_tabela, &QTableWidget::itemChanged, this, &GastosFixosWidget::onItemChanged);
 
     carregar();
@@ -84,15 +121,25 @@ GastosFixosWidget::GastosFixosWidget(QWidget *parent)
 
 void GastosFixosWidget::carregar()
 {
+    TRACE_SPAN("GastosFixosWidget::carregar", "ui");
     m_carregando = true;
     m_tabela->setRowCount(0);
+    m_linhasOrcamento.clear();
+    m_estourado.clear();
     m_categorias = DatabaseManager::instance().listarCategorias();
+    m_delegateHist->definirCategorias(m_categorias);
+
+    // Previstos primeiro: são os que pedem ação
+    m_pendentes = DatabaseManager::instance().listarOcorrenciasPendentes(m_periodo);
+    for (int i = 0; i < m_pendentes.size(); ++i)
+        adicionarOcorrencia(i);
 
-    for (const GastoFixo &g : DatabaseManager::instance().listarGastosFixos())
+    for (const GastoFixo &g : DatabaseManager::instance().listarGastosFixos(m_periodo))
         adicionarLinha(g);
 
     inserirLinhaTotalVazia();
     atualizarTotal();
+    aplicarFiltro();
     m_carregando = false;
 }
 
@@ -101,6 +148,13 @@ void GastosFixosWidget::recarregarCategorias()
     carregar();
 }
 
+void GastosFixosWidget::definirPeriodo(const Periodo &periodo)
+{
+    if (periodo == m_periodo) return;
+    m_periodo = periodo;
+    carregar();
+}
+
 void GastosFixosWidget::adicionarLinha(const GastoFixo &g)
 {
     const int row = m_tabela->rowCount();
@@ -126,6 +180,37 @@ void GastosFixosWidget::adicionarLinha(const GastoFixo &g)
 
     m_tabela->setCellWidget(row, COL_CAT, combo);
     conectarCombo(combo, row);
+    marcarAtipico(row);
+    marcarOrcamento(row);
+}
+
+// Ocorrência prevista: só leitura, em itálico e esmaecida, fora do total.
+// Confirmar grava o gasto; remover dispensa a ocorrência ou encerra a regra.
+void GastosFixosWidget::adicionarOcorrencia(int indice)
+{
+    const Ocorrencia &o = m_pendentes.at(indice);
+    const int row = m_tabela->rowCount();
+    m_tabela->insertRow(row);
+    m_tabela->setRowHeight(row, 36);
+
+    auto *itemData  = makeItem(o.data.toString("dd/MM/yyyy"), false);
+    auto *itemValor = makeItem(centavosParaTexto(o.valorCentavos), false);
+    itemData->setData(ID_ROLE, 0);
+    itemData->setData(OCORRENCIA_ROLE, indice);
+    itemValor->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    const QColor cor(Theme::isDark() ? "#8C8C8C" : "#7A7A7A");
+    const QList<QTableWidgetItem *> itens = {itemData, makeItem(o.historico, false), itemValor,
+                                             makeItem(o.categoriaNome, false)};
+    for (int col = 0; col < itens.size(); ++col) {
+        QTableWidgetItem *item = itens.at(col);
+        QFont fonte = item->font();
+        fonte.setItalic(true);
+        item->setFont(fonte);
+        item->setForeground(cor);
+        item->setToolTip("Previsto pela recorrência — \"Confirmar previsto\" grava o gasto");
+        m_tabela->setItem(row, col, item);
+    }
 }
 
 void GastosFixosWidget::inserirLinhaTotalVazia()
@@ -155,6 +240,13 @@ bool GastosFixosWidget::isTotalRow(int row) const
     return idDaLinha(row) == -1;
 }
 
+int GastosFixosWidget::ocorrenciaDaLinha(int row) const
+{
+    auto *item = m_tabela->item(row, COL_DATA);
+    const QVariant indice = item ? item->data(OCORRENCIA_ROLE) : QVariant();
+    return indice.isValid() ? indice.toInt() : -1;
+}
+
 QComboBox *GastosFixosWidget::comboDaLinha(int row) const
 {
     return qobject_cast<QComboBox*>(m_tabela->cellWidget(row, COL_CAT));
@@ -165,13 +257,69 @@ void GastosFixosWidget::atualizarTotal()
     const int totalRow = m_tabela->rowCount() - 1;
     qint64 total = 0;
     for (int r = 0; r < totalRow; ++r)
-        total += textoParaCentavos(m_tabela->item(r, COL_VALOR)->text());
+        if (ocorrenciaDaLinha(r) < 0)  // previstos ainda não são gastos
+            total += textoParaCentavos(m_tabela->item(r, COL_VALOR)->text());
 
     m_carregando = true;
     m_tabela->item(totalRow, COL_VALOR)->setText(centavosParaTexto(total));
     m_carregando = false;
 }
 
+// Busca por texto (FTS5): esconde as linhas fora do resultado; TOTAL sempre visível
+void GastosFixosWidget::aplicarFiltro()
+{
+    const int totalRow = m_tabela->rowCount() - 1;
+    if (m_filtro.isEmpty()) {
+        for (int r = 0; r < totalRow; ++r)
+            m_tabela->setRowHidden(r, false);
+        return;
+    }
+
+    // Previstos não estão no índice FTS: casam pelo histórico da recorrência,
+    // normalizado como o texto indexado (sem acentos, minúsculo)
+    const QSet<int> ids   = DatabaseManager::instance().buscarIds(TipoLancamento::GastoFixo, m_filtro);
+    const QString   chave = normalizarDescricao(m_filtro);
+    for (int r = 0; r < totalRow; ++r) {
+        const int indice = ocorrenciaDaLinha(r);
+        m_tabela->setRowHidden(r, indice >= 0
+            ? !normalizarDescricao(m_pendentes.at(indice).historico).contains(chave)
+            : !ids.contains(idDaLinha(r)));
+    }
+}
+
+// Autocompletar: a categoria sugerida entra sempre; o valor, só em linha zerada.
+// Sob m_carregando, para que onItemChanged grave a linha uma única vez.
+void GastosFixosWidget::aplicarSugestao(int row)
+{
+    m_carregando = true;
+    if (auto *combo = comboDaLinha(row)) {
+        const int idx = combo->findData(m_sugestao.categoriaId);
+        if (idx >= 0) combo->setCurrentIndex(idx);
+    }
+    auto *itemValor = m_tabela->item(row, COL_VALOR);
+    if (itemValor && textoParaCentavos(itemValor->text()) == 0)
+        itemValor->setText(centavosParaTexto(m_sugestao.valorCentavos));
+    m_carregando = false;
+}
+
+// Regras de categorização ou, sem regra, o classificador aprendido: o histórico
+// digitado escolhe a categoria da linha
+void GastosFixosWidget::aplicarCategoriaAutomatica(int row)
+{
+    auto *combo = comboDaLinha(row);
+    if (!combo) return;
+
+    const int categoriaId = DatabaseManager::instance().sugerirCategoria(
+        m_tabela->item(row, COL_HIST)->text(),
+        textoParaCentavos(m_tabela->item(row, COL_VALOR)->text()));
+    const int idx = categoriaId > 0 ? combo->findData(categoriaId) : -1;
+    if (idx < 0) return;
+
+    m_carregando = true;
+    combo->setCurrentIndex(idx);
+    m_carregando = false;
+}
+
 void GastosFixosWidget::salvarLinha(int row)
 {
     if (isTotalRow(row)) return;
@@ -188,6 +336,121 @@ void GastosFixosWidget::salvarLinha(int row)
     g.categoriaId   = combo ? combo->currentData().toInt() : 0;
 
     DatabaseManager::instance().atualizarGastoFixo(g);
+    marcarAtipico(row);
+    marcarOrcamento(row);  // o par (categoria, mês) antigo e o novo podem ter cruzado o limite
+}
+
+// Valor muito acima da média do mesmo histórico ou da categoria
+// (DetectorAnomalias), ou acima do p99 da categoria (EstatisticasCategoria):
+// vermelho, negrito e o motivo no tooltip. Cor e tooltip também disparam
+// itemChanged, daí a trava.
+void GastosFixosWidget::marcarAtipico(int row)
+{
+    auto *itemValor = m_tabela->item(row, COL_VALOR);
+    auto *itemHist  = m_tabela->item(row, COL_HIST);
+    auto *combo     = comboDaLinha(row);
+    if (!itemValor || !itemHist || !combo) return;
+
+    const DatabaseManager &db = DatabaseManager::instance();
+    const int    categoriaId  = combo->currentData().toInt();
+    const qint64 valor        = textoParaCentavos(itemValor->text());
+    const auto   avaliacao    = db.avaliarGasto(categoriaId, itemHist->text(), valor, true);
+    const qint64 limite       = db.estatisticasCategoria().limiteAtipico(categoriaId);
+
+    QString motivo;
+    if (avaliacao.anomalo)
+        motivo = QString("%1σ acima da média %2 (%3 em %4 lançamentos)")
+                     .arg(avaliacao.escore, 0, 'f', 1)
+                     .arg(avaliacao.porHistorico ? "deste histórico" : "da categoria",
+                          centavosParaTexto(qRound64(avaliacao.media)))
+                     .arg(avaliacao.amostra);
+    else if (limite > 0 && valor > limite)
+        motivo = "Acima do p99 da categoria (" + centavosParaTexto(limite) + ")";
+    const bool atipico = !motivo.isEmpty();
+
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    QFont fonte = itemValor->font();
+    fonte.setBold(atipico);
+    itemValor->setFont(fonte);
+    itemValor->setData(Qt::ForegroundRole, atipico
+        ? QVariant(QColor(Theme::isDark() ? "#E85555" : "#C94040")) : QVariant());
+    itemValor->setToolTip(motivo);
+    m_carregando = carregando;
+}
+
+// Categoria acima do orçamento no mês da linha: fundo âmbar em Data e
+// Histórico. As linhas ficam indexadas por (categoria, mês): uma edição
+// reavalia só o par que a linha deixou e o par em que entrou, e as linhas de
+// um par só são repintadas quando ele cruza o limite.
+void GastosFixosWidget::marcarOrcamento(int row)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    auto *combo    = comboDaLinha(row);
+    if (!itemData || !combo) return;
+    const int categoriaId = combo->currentData().toInt();
+
+    const quint64  chave    = chaveOrcamento(categoriaId,
+                                             QDate::fromString(itemData->text(), "dd/MM/yyyy"));
+    const QVariant anterior = itemData->data(ORCAMENTO_ROLE);
+    if (anterior.isValid() && anterior.toULongLong() == chave) {
+        reavaliarOrcamento(chave);
+        return;
+    }
+    if (anterior.isValid()) {
+        m_linhasOrcamento[anterior.toULongLong()].removeOne(itemData);
+        reavaliarOrcamento(anterior.toULongLong());
+    }
+    m_linhasOrcamento[chave].append(itemData);
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    itemData->setData(ORCAMENTO_ROLE, chave);
+    m_carregando = carregando;
+    pintarOrcamento(row, m_estourado.value(chave));
+    reavaliarOrcamento(chave);
+}
+
+// Linha que sai da tabela: devolve o par dela, a reavaliar depois da remoção
+QVariant GastosFixosWidget::desindexarOrcamento(int row)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    const QVariant chave = itemData ? itemData->data(ORCAMENTO_ROLE) : QVariant();
+    if (chave.isValid()) m_linhasOrcamento[chave.toULongLong()].removeOne(itemData);
+    return chave;
+}
+
+// consumoOrcamento() é O(1); repinta o par só se ele mudou de lado do limite
+void GastosFixosWidget::reavaliarOrcamento(quint64 chave)
+{
+    const int  mes       = int(chave & 0xFFFFFFFF);
+    const bool estourado = DatabaseManager::instance()
+        .consumoOrcamento(int(chave >> 32), QDate(mes / 12, mes % 12 + 1, 1)).estourado();
+    if (m_estourado.value(chave) == estourado) return;
+    m_estourado.insert(chave, estourado);
+    for (QTableWidgetItem *item : std::as_const(m_linhasOrcamento[chave]))
+        pintarOrcamento(item->row(), estourado);
+}
+
+void GastosFixosWidget::pintarOrcamento(int row, bool estourado)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    auto *itemHist = m_tabela->item(row, COL_HIST);
+    if (!itemData || !itemHist) return;
+
+    const QVariant fundo = estourado
+        ? QVariant(QColor(Theme::isDark() ? "#4A3A12" : "#FBEFD0")) : QVariant();
+    const QString dica = estourado
+        ? QString("Categoria acima do orçamento em %1 (consumo no Dashboard)")
+              .arg(QDate::fromString(itemData->text(), "dd/MM/yyyy").toString("MM/yyyy"))
+        : QString();
+
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    for (QTableWidgetItem *item : {itemData, itemHist}) {
+        item->setData(Qt::BackgroundRole, fundo);
+        item->setToolTip(dica);
+    }
+    m_carregando = carregando;
 }
 
 void GastosFixosWidget::conectarCombo(QComboBox *combo, int row)
@@ -238,6 +501,7 @@ void GastosFixosWidget::adicionarGasto()
     m_carregando = false;
 
     conectarCombo(combo, totalRow);
+    marcarOrcamento(totalRow);
     atualizarTotal();
     m_tabela->selectRow(totalRow);
     m_tabela->scrollToItem(m_tabela->item(totalRow, COL_HIST));
@@ -254,6 +518,35 @@ void GastosFixosWidget::removerGasto()
         return;
     }
 
+    // Previsto: nada a apagar — dispensa esta ocorrência ou encerra a regra
+    if (const int indice = ocorrenciaDaLinha(row); indice >= 0) {
+        const Ocorrencia o = m_pendentes.at(indice);
+        QMessageBox caixa(QMessageBox::Question, "Remover previsto",
+            QString("\"%1\" se repete todo mês. Remover só a de %2 ou encerrar a recorrência?")
+                .arg(o.historico, o.data.toString("MM/yyyy")),
+            QMessageBox::Cancel, this);
+        auto *soEsta   = caixa.addButton("Só esta",            QMessageBox::AcceptRole);
+        auto *proximas = caixa.addButton("Esta e as próximas", QMessageBox::DestructiveRole);
+        caixa.exec();
+
+        auto &db = DatabaseManager::instance();
+        bool ok = true;
+        if (caixa.clickedButton() == soEsta) {
+            ok = db.dispensarOcorrencia(o);
+        } else if (caixa.clickedButton() == proximas) {
+            for (Recorrencia r : db.listarRecorrencias()) {
+                if (r.id != o.recorrenciaId) continue;
+                r.fim = o.data.addDays(-1);
+                ok = r.fim < r.inicio ? db.removerRecorrencia(r.id) : db.atualizarRecorrencia(r);
+            }
+        } else {
+            return;
+        }
+        if (!ok) QMessageBox::warning(this, "Erro", "Não foi possível alterar a recorrência.");
+        carregar();
+        return;
+    }
+
     const auto resp = QMessageBox::question(
         this, "Confirmar remoção", "Remover o gasto fixo selecionado?",
         QMessageBox::Yes | QMessageBox::No
@@ -262,77 +555,95 @@ void GastosFixosWidget::removerGasto()
 
     if (!DatabaseManager::instance().removerGastoFixo(idDaLinha(row))) return;
 
+    const QVariant chave = desindexarOrcamento(row);
     m_carregando = true;
     m_tabela->removeRow(row);
     m_carregando = false;
+    if (chave.isValid()) reavaliarOrcamento(chave.toULongLong());
 
     atualizarTotal();
     emit dadosAlterados();
 }
 
-// ── Repetir mês anterior ──────────────────────────────────────────────────────
+// ── Recorrências ──────────────────────────────────────────────────────────────
 
+// Operação só de metadados: cada gasto fixo do mês anterior vira uma regra de
+// recorrência (valor, dia, categoria), sem gravar um gasto por mês. Os meses
+// seguintes mostram a ocorrência prevista até ela ser confirmada.
 void GastosFixosWidget::repetirMesAnterior()
 {
+    auto &db = DatabaseManager::instance();
     const QDate hoje        = QDate::currentDate();
-    const QDate mesAnterior = hoje.addMonths(-1);
+    const QDate inicioMes   = QDate(hoje.year(), hoje.month(), 1);
+    const QDate mesAnterior = inicioMes.addMonths(-1);
+
+    // Já recorrentes: mesmo histórico (normalizado) e categoria, ainda vigentes
+    QSet<QPair<QString, int>> cobertos;
+    for (const Recorrencia &r : db.listarRecorrencias())
+        if (!r.fim.isValid() || r.fim >= inicioMes)
+            cobertos.insert({normalizarDescricao(r.historico), r.categoriaId});
+
+    // Já lançados neste mês: a regra começa no próximo, sem prever de novo
+    QSet<QPair<QString, int>> lancadosNoMes;
+    for (const GastoFixo &g : db.listarGastosFixos(Periodo::mes(inicioMes)))
+        lancadosNoMes.insert({normalizarDescricao(g.historico), g.categoriaId});
+
+    QList<Recorrencia> novas;
+    for (const GastoFixo &g : db.listarGastosFixos(Periodo::mes(mesAnterior))) {
+        const QPair<QString, int> chave(normalizarDescricao(g.historico), g.categoriaId);
+        if (cobertos.contains(chave)) continue;
+        cobertos.insert(chave);
+
+        Recorrencia r;
+        r.historico     = g.historico;
+        r.valorCentavos = g.valorCentavos;
+        r.dia           = g.data.day();
+        r.categoriaId   = g.categoriaId;
+        r.inicio        = lancadosNoMes.contains(chave) ? inicioMes.addMonths(1) : inicioMes;
+        novas.append(r);
+    }
 
-    QList<GastoFixo> paraRepetir;
-    const int totalRow = m_tabela->rowCount() - 1;
+    if (novas.isEmpty()) {
+        QMessageBox::information(this, "Repetir mês anterior",
+            "Nenhum gasto fixo do mês anterior que já não se repita.");
+        return;
+    }
 
-    for (int r = 0; r < totalRow; ++r) {
-        const QDate data = QDate::fromString(
-            m_tabela->item(r, COL_DATA)->text(), "dd/MM/yyyy");
-        if (data.month() == mesAnterior.month() && data.year() == mesAnterior.year()) {
-            GastoFixo g;
-            g.data          = hoje;
-            g.historico     = m_tabela->item(r, COL_HIST)->text();
-            g.valorCentavos = 0;  // valor em aberto, usuário preenche
-            auto *combo     = comboDaLinha(r);
-            g.categoriaId   = combo ? combo->currentData().toInt()
-                                    : m_categorias.first().id;
-            paraRepetir.append(g);
+    db.iniciarLote();  // um único salvamento criptografado
+    for (Recorrencia &r : novas) {
+        if (!db.inserirRecorrencia(r)) {
+            db.cancelarLote();
+            QMessageBox::warning(this, "Erro", "Não foi possível criar as recorrências.");
+            return;
         }
     }
-
-    if (paraRepetir.isEmpty()) {
-        QMessageBox::information(this, "Repetir mês anterior",
-            "Nenhum gasto fixo encontrado no mês anterior.");
+    if (!db.concluirLote()) {
+        QMessageBox::warning(this, "Erro", "Não foi possível salvar o banco.");
         return;
     }
 
-    m_carregando = true;
-    for (GastoFixo &g : paraRepetir) {
-        if (!DatabaseManager::instance().inserirGastoFixo(g)) continue;
-
-        const int row = m_tabela->rowCount() - 1; // antes da linha total
-        m_tabela->insertRow(row);
-        m_tabela->setRowHeight(row, 36);
-
-        auto *itemData = makeItem(g.data.toString("dd/MM/yyyy"));
-        itemData->setData(ID_ROLE, g.id);
-        m_tabela->setItem(row, COL_DATA,  itemData);
-        m_tabela->setItem(row, COL_HIST,  makeItem(g.historico));
-
-        auto *itemValor = makeItem(centavosParaTexto(g.valorCentavos));
-        itemValor->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_tabela->setItem(row, COL_VALOR, itemValor);
-
-        auto *combo = new QComboBox;
-        for (const Categoria &cat : m_categorias)
-            combo->addItem(cat.nome, cat.id);
-        combo->setCurrentIndex(combo->findData(g.categoriaId));
-        m_tabela->setCellWidget(row, COL_CAT, combo);
-        conectarCombo(combo, row);
+    carregar();
+    QMessageBox::information(this, "Repetir mês anterior",
+        QString("%1 gasto(s) passam a se repetir todo mês. Aparecem como previstos "
+                "e só são gravados ao confirmar.").arg(novas.size()));
+}
+
+void GastosFixosWidget::confirmarOcorrencia()
+{
+    const int row    = m_tabela->currentRow();
+    const int indice = row >= 0 ? ocorrenciaDaLinha(row) : -1;
+    if (indice < 0) {
+        QMessageBox::information(this, "Confirmar previsto", "Selecione um gasto previsto.");
+        return;
     }
-    m_carregando = false;
 
-    atualizarTotal();
+    GastoFixo gerado;
+    if (!DatabaseManager::instance().confirmarOcorrencia(m_pendentes.at(indice), gerado)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível gravar o gasto.");
+        return;
+    }
+    carregar();
     emit dadosAlterados();
-
-    QMessageBox::information(this, "Repetir mês anterior",
-        QString("%1 gasto(s) repetido(s) com valor em aberto.")
-            .arg(paraRepetir.size()));
 }
 
 // ── Edição inline ─────────────────────────────────────────────────────────────
@@ -350,6 +661,12 @@ void GastosFixosWidget::onItemChanged(QTableWidgetItem *item)
         m_carregando = false;
     }
 
+    if (item->column() == COL_HIST) {
+        if (m_sugestao.row == row && item->text() == m_sugestao.historico) aplicarSugestao(row);
+        else aplicarCategoriaAutomatica(row);
+        m_sugestao = {};
+    }
+
     salvarLinha(row);
     atualizarTotal();
     emit dadosAlterados();
@@ -2,12 +2,18 @@
 
 #include "models/Categoria.h"
 #include "models/GastoFixo.h"
+#include "models/Periodo.h"
+#include "models/Recorrencia.h"
 
 #include <QComboBox>
+#include <QHash>
 #include <QList>
 #include <QTableWidget>
 #include <QWidget>
 
+class CampoBusca;
+class DelegateHistorico;
+
 class GastosFixosWidget : public QWidget
 {
     Q_OBJECT
@@ -18,6 +24,12 @@ signals:
 public:
     explicit GastosFixosWidget(QWidget *parent = nullptr);
 
+    // Relê o banco e reconstrói a tabela
+    void carregar();
+
+    // Período selecionado na janela; recarrega só as linhas dele
+    void definirPeriodo(const Periodo &periodo);
+
     // Chamado pelo ConfigWidget quando categorias mudam
     void recarregarCategorias();
 
@@ -25,21 +37,50 @@ private slots:
     void adicionarGasto();
     void removerGasto();
     void repetirMesAnterior();
+    void confirmarOcorrencia();
     void onItemChanged(QTableWidgetItem *item);
 
 private:
-    void carregar();
     void adicionarLinha(const GastoFixo &g);
+    void adicionarOcorrencia(int indice);
     void inserirLinhaTotalVazia();
     void atualizarTotal();
+    void aplicarFiltro();
+    void aplicarSugestao(int row);
+    void aplicarCategoriaAutomatica(int row);
     void salvarLinha(int row);
     void conectarCombo(QComboBox *combo, int row);
+    void marcarAtipico(int row);
+    void marcarOrcamento(int row);
+    QVariant desindexarOrcamento(int row);
+    void reavaliarOrcamento(quint64 chave);
+    void pintarOrcamento(int row, bool estourado);
 
     int       idDaLinha(int row) const;
     bool      isTotalRow(int row) const;
+    int       ocorrenciaDaLinha(int row) const;  // índice em m_pendentes; -1 = linha gravada
     QComboBox *comboDaLinha(int row) const;
 
-    QList<Categoria> m_categorias;
-    QTableWidget    *m_tabela;
-    bool             m_carregando = false;
+    // Sugestão escolhida no autocompletar, aplicada quando o histórico é gravado
+    struct SugestaoPendente {
+        int     row = -1;
+        QString historico;
+        int     categoriaId   = 0;
+        qint64  valorCentavos = 0;
+    };
+
+    QList<Categoria>   m_categorias;
+    QList<Ocorrencia>  m_pendentes;  // previstas pelas recorrências no período, não gravadas
+    QTableWidget      *m_tabela;
+    CampoBusca        *m_busca;
+    QString            m_filtro;  // texto da busca ativa
+    DelegateHistorico *m_delegateHist;
+    SugestaoPendente   m_sugestao;
+    Periodo            m_periodo;
+    bool               m_carregando = false;
+
+    // Índice de orçamentos: item de Data das linhas de cada (categoria, mês) e
+    // se o par estava estourado na última avaliação
+    QHash<quint64, QList<QTableWidgetItem *>> m_linhasOrcamento;
+    QHash<quint64, bool>                      m_estourado;
 };
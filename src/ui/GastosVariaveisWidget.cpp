@@ -1,13 +1,27 @@
 #include "ui/GastosVariaveisWidget.h"
 
 #include "core/DatabaseManager.h"
+#include "core/StatementImporter.h"
+#include "ui/CampoBusca.h"
+#include "ui/DelegateHistorico.h"
+#include "ui/Theme.h"
 #include "utils/CurrencyUtils.h"
+#include "utils/Fingerprint.h"
+#include "utils/Tracer.h"
 
 #include <QDate>
+#include <QDateEdit>
+#include <QCheckBox>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFormLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QLineEdit>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QSpinBox>
 #include <QTableWidgetItem>
 #include <QVBoxLayout>
 
@@ -16,6 +30,8 @@ static constexpr int COL_HIST  = 1;
 static constexpr int COL_VALOR = 2;
 static constexpr int COL_CAT   = 3;
 static constexpr int ID_ROLE   = Qt::UserRole;
+static constexpr int PARCELA_ROLE = Qt::UserRole + 2; // parcela calculada: índice em m_parcelas
+static constexpr int ORCAMENTO_ROLE = Qt::UserRole + 3; // par (categoria, mês) no índice de orçamentos
 
 // ── Helpers de item ───────────────────────────────────────────────────────────
 
@@ -35,6 +51,12 @@ static QTableWidgetItem *makeTotalItem(const QString &texto)
     return item;
 }
 
+// Par (categoria, mês) do índice de orçamentos numa chave de 64 bits
+static quint64 chaveOrcamento(int categoriaId, const QDate &data)
+{
+    return quint64(quint32(categoriaId)) << 32 | quint32(data.year() * 12 + data.month() - 1);
+}
+
 // ── Construtor ────────────────────────────────────────────────────────────────
 
 GastosVariaveisWidget::GastosVariaveisWidget(QWidget *parent)
@@ -44,6 +66,14 @@ GastosVariaveisWidget::GastosVariaveisWidget(QWidget *parent)
     root->setContentsMargins(24, 24, 24, 16);
     root->setSpacing(12);
 
+    // ── Busca ─────────────────────────────────────────────────────────────────
+    m_busca = new CampoBusca;
+    root->addWidget(m_busca);
+    connect(m_busca, &CampoBusca::buscaAlterada, this, [this](const QString &texto) {
+        m_filtro = texto;
+        aplicarFiltro();
+    });
+
     m_tabela = new QTableWidget(0, 4, this);
     m_tabela->setHorizontalHeaderLabels({"Data", "Histórico", "Valor", "Categoria"});
     m_tabela->horizontalHeader()->setSectionResizeMode(COL_DATA,  QHeaderView::ResizeToContents);
@@ -55,22 +85,43 @@ GastosVariaveisWidget::GastosVariaveisWidget(QWidget *parent)
     m_tabela->setSelectionMode(QAbstractItemView::SingleSelection);
     m_tabela->setAlternatingRowColors(true);
     m_tabela->setShowGrid(false);
+
+    // Autocompletar do histórico: escolher uma sugestão preenche categoria e valor
+    m_delegateHist = new DelegateHistorico(TipoLancamento::GastoVariavel, this);
+    m_tabela->setItemDelegateForColumn(COL_HIST, m_delegateHist);
+    connect(m_delegateHist, &DelegateHistorico::sugestaoEscolhida, this,
+            [this](int row, const QString &historico, int categoriaId, qint64 valorCentavos) {
+        m_sugestao = {row, historico, categoriaId, valorCentavos};
+    });
+
     root->addWidget(m_tabela);
 
     auto *btnAdicionar = new QPushButton("+ Adicionar gasto variável");
     auto *btnRemover   = new QPushButton("Remover selecionado");
+    auto *btnParcelada = new QPushButton("+ Compra parcelada…");
+    auto *btnImportar  = new QPushButton("Importar extrato…");
     btnRemover->setProperty("secondary", true);
+    btnParcelada->setProperty("secondary", true);
+    btnImportar->setProperty("secondary", true);
 
     auto *botoesRow = new QHBoxLayout;
     botoesRow->setSpacing(8);
     botoesRow->addWidget(btnAdicionar);
     botoesRow->addWidget(btnRemover);
+    botoesRow->addWidget(btnParcelada);
+    botoesRow->addWidget(btnImportar);
     botoesRow->addStretch();
     root->addLayout(botoesRow);
 
     connect(btnAdicionar, &QPushButton::clicked, this, &GastosVariaveisWidget::adicionarGasto);
     connect(btnRemover,   &QPushButton::clicked, this, &GastosVariaveisWidget::removerGasto);
+    connect(btnParcelada, &QPushButton::clicked, this, &GastosVariaveisWidget::adicionarCompraParcelada);
+    connect(btnImportar,  &QPushButton::clicked, this, &GastosVariaveisWidget::importarExtrato);
     connect(m_tabela, &QTableWidget::itemChanged, this, &GastosVariaveisWidget::onItemChanged);
+    connect(m_tabela, &QTableWidget::itemDoubleClicked, this, [this](QTableWidgetItem *item) {
+        if (const int indice = parcelaDaLinha(item->row()); indice >= 0)
+            editarCompraParcelada(m_parcelas.at(indice).parcelamentoId);
+    });
 
     carregar();
 }
@@ -79,15 +130,29 @@ GastosVariaveisWidget::GastosVariaveisWidget(QWidget *parent)
 
 void GastosVariaveisWidget::carregar()
 {
+    TRACE_SPAN("GastosVariaveisWidget::carregar", "ui");
     m_carregando = true;
     m_tabela->setRowCount(0);
+    m_linhasOrcamento.clear();
+    m_estourado.clear();
     m_categorias = DatabaseManager::instance().listarCategorias();
-
-    for (const GastoVariavel &g : DatabaseManager::instance().listarGastosVariaveis())
+    m_delegateHist->definirCategorias(m_categorias);
+
+    // Parcelas intercaladas por data (as duas listas vêm da mais recente)
+    const QList<GastoVariavel> gastos = DatabaseManager::instance().listarGastosVariaveis(m_periodo);
+    m_parcelas = DatabaseManager::instance().listarParcelas(m_periodo);
+    int p = 0;
+    for (const GastoVariavel &g : gastos) {
+        for (; p < m_parcelas.size() && m_parcelas.at(p).data > g.data; ++p)
+            adicionarParcela(p);
         adicionarLinha(g);
+    }
+    for (; p < m_parcelas.size(); ++p)
+        adicionarParcela(p);
 
     inserirLinhaTotalVazia();
     atualizarTotal();
+    aplicarFiltro();
     m_carregando = false;
 }
 
@@ -96,6 +161,13 @@ void GastosVariaveisWidget::recarregarCategorias()
     carregar();
 }
 
+void GastosVariaveisWidget::definirPeriodo(const Periodo &periodo)
+{
+    if (periodo == m_periodo) return;
+    m_periodo = periodo;
+    carregar();
+}
+
 void GastosVariaveisWidget::adicionarLinha(const GastoVariavel &g)
 {
     const int row = m_tabela->rowCount();
@@ -118,6 +190,38 @@ void GastosVariaveisWidget::adicionarLinha(const GastoVariavel &g)
     combo->setCurrentIndex(idx >= 0 ? idx : 0);
     m_tabela->setCellWidget(row, COL_CAT, combo);
     conectarCombo(combo, row);
+    marcarAtipico(row);
+    marcarOrcamento(row);
+}
+
+// Parcela de compra parcelada: só leitura e em itálico, mas entra no total —
+// é gasto do mês. Duplo clique edita a compra; remover a linha encerra a
+// compra a partir dela ou a remove inteira.
+void GastosVariaveisWidget::adicionarParcela(int indice)
+{
+    const Parcela &p = m_parcelas.at(indice);
+    const int row = m_tabela->rowCount();
+    m_tabela->insertRow(row);
+    m_tabela->setRowHeight(row, 36);
+
+    auto *itemData  = makeItem(p.data.toString("dd/MM/yyyy"), false);
+    auto *itemValor = makeItem(centavosParaTexto(p.valorCentavos), false);
+    itemData->setData(ID_ROLE, 0);
+    itemData->setData(PARCELA_ROLE, indice);
+    itemValor->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    const QString historico = QString("%1 (%2/%3)").arg(p.historico).arg(p.numero).arg(p.parcelas);
+    const QList<QTableWidgetItem *> itens = {itemData, makeItem(historico, false), itemValor,
+                                             makeItem(p.categoriaNome, false)};
+    for (int col = 0; col < itens.size(); ++col) {
+        QTableWidgetItem *item = itens.at(col);
+        QFont fonte = item->font();
+        fonte.setItalic(true);
+        item->setFont(fonte);
+        item->setToolTip("Parcela de compra parcelada — duplo clique edita a compra");
+        m_tabela->setItem(row, col, item);
+    }
+    marcarOrcamento(row);
 }
 
 void GastosVariaveisWidget::inserirLinhaTotalVazia()
@@ -147,6 +251,13 @@ bool GastosVariaveisWidget::isTotalRow(int row) const
     return idDaLinha(row) == -1;
 }
 
+int GastosVariaveisWidget::parcelaDaLinha(int row) const
+{
+    auto *item = m_tabela->item(row, COL_DATA);
+    const QVariant indice = item ? item->data(PARCELA_ROLE) : QVariant();
+    return indice.isValid() ? indice.toInt() : -1;
+}
+
 QComboBox *GastosVariaveisWidget::comboDaLinha(int row) const
 {
     return qobject_cast<QComboBox*>(m_tabela->cellWidget(row, COL_CAT));
@@ -164,6 +275,61 @@ void GastosVariaveisWidget::atualizarTotal()
     m_carregando = false;
 }
 
+// Busca por texto (FTS5): esconde as linhas fora do resultado; TOTAL sempre visível
+void GastosVariaveisWidget::aplicarFiltro()
+{
+    const int totalRow = m_tabela->rowCount() - 1;
+    if (m_filtro.isEmpty()) {
+        for (int r = 0; r < totalRow; ++r)
+            m_tabela->setRowHidden(r, false);
+        return;
+    }
+
+    // Parcelas não estão no índice FTS: casam pelo histórico, normalizado como
+    // o texto indexado (sem acentos, minúsculo)
+    const QSet<int> ids   = DatabaseManager::instance().buscarIds(TipoLancamento::GastoVariavel, m_filtro);
+    const QString   chave = normalizarDescricao(m_filtro);
+    for (int r = 0; r < totalRow; ++r) {
+        const int indice = parcelaDaLinha(r);
+        m_tabela->setRowHidden(r, indice >= 0
+            ? !normalizarDescricao(m_parcelas.at(indice).historico).contains(chave)
+            : !ids.contains(idDaLinha(r)));
+    }
+}
+
+// Autocompletar: a categoria sugerida entra sempre; o valor, só em linha zerada.
+// Sob m_carregando, para que onItemChanged grave a linha uma única vez.
+void GastosVariaveisWidget::aplicarSugestao(int row)
+{
+    m_carregando = true;
+    if (auto *combo = comboDaLinha(row)) {
+        const int idx = combo->findData(m_sugestao.categoriaId);
+        if (idx >= 0) combo->setCurrentIndex(idx);
+    }
+    auto *itemValor = m_tabela->item(row, COL_VALOR);
+    if (itemValor && textoParaCentavos(itemValor->text()) == 0)
+        itemValor->setText(centavosParaTexto(m_sugestao.valorCentavos));
+    m_carregando = false;
+}
+
+// Regras de categorização ou, sem regra, o classificador aprendido: o histórico
+// digitado escolhe a categoria da linha
+void GastosVariaveisWidget::aplicarCategoriaAutomatica(int row)
+{
+    auto *combo = comboDaLinha(row);
+    if (!combo) return;
+
+    const int categoriaId = DatabaseManager::instance().sugerirCategoria(
+        m_tabela->item(row, COL_HIST)->text(),
+        textoParaCentavos(m_tabela->item(row, COL_VALOR)->text()));
+    const int idx = categoriaId > 0 ? combo->findData(categoriaId) : -1;
+    if (idx < 0) return;
+
+    m_carregando = true;
+    combo->setCurrentIndex(idx);
+    m_carregando = false;
+}
+
 void GastosVariaveisWidget::salvarLinha(int row)
 {
     if (isTotalRow(row)) return;
@@ -180,6 +346,124 @@ void GastosVariaveisWidget::salvarLinha(int row)
     g.categoriaId   = combo ? combo->currentData().toInt() : 0;
 
     DatabaseManager::instance().atualizarGastoVariavel(g);
+    marcarAtipico(row);
+    marcarOrcamento(row);  // o par (categoria, mês) antigo e o novo podem ter cruzado o limite
+}
+
+// Valor muito acima da média do mesmo histórico ou da categoria
+// (DetectorAnomalias), ou acima do p99 da categoria (EstatisticasCategoria):
+// vermelho, negrito e o motivo no tooltip. Cor e tooltip também disparam
+// itemChanged, daí a trava.
+void GastosVariaveisWidget::marcarAtipico(int row)
+{
+    auto *itemValor = m_tabela->item(row, COL_VALOR);
+    auto *itemHist  = m_tabela->item(row, COL_HIST);
+    auto *combo     = comboDaLinha(row);
+    if (!itemValor || !itemHist || !combo) return;
+
+    const DatabaseManager &db = DatabaseManager::instance();
+    const int    categoriaId  = combo->currentData().toInt();
+    const qint64 valor        = textoParaCentavos(itemValor->text());
+    const auto   avaliacao    = db.avaliarGasto(categoriaId, itemHist->text(), valor, true);
+    const qint64 limite       = db.estatisticasCategoria().limiteAtipico(categoriaId);
+
+    QString motivo;
+    if (avaliacao.anomalo)
+        motivo = QString("%1σ acima da média %2 (%3 em %4 lançamentos)")
+                     .arg(avaliacao.escore, 0, 'f', 1)
+                     .arg(avaliacao.porHistorico ? "deste histórico" : "da categoria",
+                          centavosParaTexto(qRound64(avaliacao.media)))
+                     .arg(avaliacao.amostra);
+    else if (limite > 0 && valor > limite)
+        motivo = "Acima do p99 da categoria (" + centavosParaTexto(limite) + ")";
+    const bool atipico = !motivo.isEmpty();
+
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    QFont fonte = itemValor->font();
+    fonte.setBold(atipico);
+    itemValor->setFont(fonte);
+    itemValor->setData(Qt::ForegroundRole, atipico
+        ? QVariant(QColor(Theme::isDark() ? "#E85555" : "#C94040")) : QVariant());
+    itemValor->setToolTip(motivo);
+    m_carregando = carregando;
+}
+
+// Categoria acima do orçamento no mês da linha: fundo âmbar em Data e
+// Histórico. As linhas ficam indexadas por (categoria, mês): uma edição
+// reavalia só o par que a linha deixou e o par em que entrou, e as linhas de
+// um par só são repintadas quando ele cruza o limite.
+void GastosVariaveisWidget::marcarOrcamento(int row)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    int categoriaId = 0;
+    if (auto *combo = comboDaLinha(row))
+        categoriaId = combo->currentData().toInt();
+    else if (const int indice = parcelaDaLinha(row); indice >= 0)
+        categoriaId = m_parcelas.at(indice).categoriaId;  // parcelas contam no orçamento
+    if (!itemData || categoriaId == 0) return;
+
+    const quint64  chave    = chaveOrcamento(categoriaId,
+                                             QDate::fromString(itemData->text(), "dd/MM/yyyy"));
+    const QVariant anterior = itemData->data(ORCAMENTO_ROLE);
+    if (anterior.isValid() && anterior.toULongLong() == chave) {
+        reavaliarOrcamento(chave);
+        return;
+    }
+    if (anterior.isValid()) {
+        m_linhasOrcamento[anterior.toULongLong()].removeOne(itemData);
+        reavaliarOrcamento(anterior.toULongLong());
+    }
+    m_linhasOrcamento[chave].append(itemData);
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    itemData->setData(ORCAMENTO_ROLE, chave);
+    m_carregando = carregando;
+    pintarOrcamento(row, m_estourado.value(chave));
+    reavaliarOrcamento(chave);
+}
+
+// Linha que sai da tabela: devolve o par dela, a reavaliar depois da remoção
+QVariant GastosVariaveisWidget::desindexarOrcamento(int row)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    const QVariant chave = itemData ? itemData->data(ORCAMENTO_ROLE) : QVariant();
+    if (chave.isValid()) m_linhasOrcamento[chave.toULongLong()].removeOne(itemData);
+    return chave;
+}
+
+// consumoOrcamento() é O(1); repinta o par só se ele mudou de lado do limite
+void GastosVariaveisWidget::reavaliarOrcamento(quint64 chave)
+{
+    const int  mes       = int(chave & 0xFFFFFFFF);
+    const bool estourado = DatabaseManager::instance()
+        .consumoOrcamento(int(chave >> 32), QDate(mes / 12, mes % 12 + 1, 1)).estourado();
+    if (m_estourado.value(chave) == estourado) return;
+    m_estourado.insert(chave, estourado);
+    for (QTableWidgetItem *item : std::as_const(m_linhasOrcamento[chave]))
+        pintarOrcamento(item->row(), estourado);
+}
+
+void GastosVariaveisWidget::pintarOrcamento(int row, bool estourado)
+{
+    auto *itemData = m_tabela->item(row, COL_DATA);
+    auto *itemHist = m_tabela->item(row, COL_HIST);
+    if (!itemData || !itemHist) return;
+
+    const QVariant fundo = estourado
+        ? QVariant(QColor(Theme::isDark() ? "#4A3A12" : "#FBEFD0")) : QVariant();
+    const QString dica = estourado
+        ? QString("Categoria acima do orçamento em %1 (consumo no Dashboard)")
+              .arg(QDate::fromString(itemData->text(), "dd/MM/yyyy").toString("MM/yyyy"))
+        : QString();
+
+    const bool carregando = m_carregando;
+    m_carregando = true;
+    for (QTableWidgetItem *item : {itemData, itemHist}) {
+        item->setData(Qt::BackgroundRole, fundo);
+        if (parcelaDaLinha(row) < 0) item->setToolTip(dica);  // a da parcela fica
+    }
+    m_carregando = carregando;
 }
 
 void GastosVariaveisWidget::conectarCombo(QComboBox *combo, int row)
@@ -230,6 +514,7 @@ void GastosVariaveisWidget::adicionarGasto()
     m_carregando = false;
 
     conectarCombo(combo, totalRow);
+    marcarOrcamento(totalRow);
     atualizarTotal();
     m_tabela->selectRow(totalRow);
     m_tabela->scrollToItem(m_tabela->item(totalRow, COL_HIST));
@@ -246,6 +531,46 @@ void GastosVariaveisWidget::removerGasto()
         return;
     }
 
+    // Parcela: não existe sozinha no banco. Encerrar mantém as parcelas
+    // anteriores no histórico; remover leva a compra inteira.
+    if (const int indice = parcelaDaLinha(row); indice >= 0) {
+        const Parcela p = m_parcelas.at(indice);
+        DatabaseManager &db = DatabaseManager::instance();
+        Parcelamento plano;
+        if (!db.lerParcelamento(p.parcelamentoId, plano)) return;
+
+        QMessageBox caixa(QMessageBox::Question, "Remover compra parcelada",
+                          QString("\"%1\" é a parcela %2 de %3.")
+                              .arg(p.historico).arg(p.numero).arg(p.parcelas),
+                          QMessageBox::Cancel, this);
+        QAbstractButton *encerrar = nullptr;
+        if (p.numero > 1) {
+            encerrar = caixa.addButton("Encerrar a partir desta parcela", QMessageBox::AcceptRole);
+            caixa.setInformativeText(QString("Encerrar mantém as parcelas 1 a %1 no histórico.")
+                                         .arg(p.numero - 1));
+        }
+        QAbstractButton *inteira = caixa.addButton("Remover a compra inteira",
+                                                   QMessageBox::DestructiveRole);
+        caixa.exec();
+
+        bool ok = false;
+        if (encerrar && caixa.clickedButton() == encerrar) {
+            plano.vigentes = p.numero - 1;
+            ok = db.atualizarParcelamento(plano);
+        } else if (caixa.clickedButton() == inteira) {
+            ok = db.removerParcelamento(p.parcelamentoId);
+        } else {
+            return;
+        }
+        if (!ok) {
+            QMessageBox::warning(this, "Erro", "Não foi possível alterar a compra parcelada.");
+            return;
+        }
+        carregar();
+        emit dadosAlterados();
+        return;
+    }
+
     const auto resp = QMessageBox::question(
         this, "Confirmar remoção", "Remover o gasto variável selecionado?",
         QMessageBox::Yes | QMessageBox::No
@@ -254,14 +579,152 @@ void GastosVariaveisWidget::removerGasto()
 
     if (!DatabaseManager::instance().removerGastoVariavel(idDaLinha(row))) return;
 
+    const QVariant chave = desindexarOrcamento(row);
     m_carregando = true;
     m_tabela->removeRow(row);
     m_carregando = false;
+    if (chave.isValid()) reavaliarOrcamento(chave.toULongLong());
 
     atualizarTotal();
     emit dadosAlterados();
 }
 
+// ── Compra parcelada ──────────────────────────────────────────────────────────
+
+void GastosVariaveisWidget::adicionarCompraParcelada()
+{
+    if (m_categorias.isEmpty()) {
+        QMessageBox::warning(this, "Sem categorias",
+            "Cadastre ao menos uma categoria em Configurações.");
+        return;
+    }
+
+    Parcelamento p;
+    p.parcelas     = 2;
+    p.primeiraData = QDate::currentDate();
+    for (const Categoria &cat : m_categorias)
+        if (cat.nome == "Crédito") p.categoriaId = cat.id;
+    if (!dialogoParcelamento(p, "Compra parcelada")) return;
+
+    if (!DatabaseManager::instance().inserirParcelamento(p)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível gravar a compra parcelada.");
+        return;
+    }
+    carregar();
+    emit dadosAlterados();
+}
+
+void GastosVariaveisWidget::editarCompraParcelada(int parcelamentoId)
+{
+    Parcelamento p;
+    if (!DatabaseManager::instance().lerParcelamento(parcelamentoId, p)) return;
+    if (!dialogoParcelamento(p, "Editar compra parcelada")) return;
+
+    if (!DatabaseManager::instance().atualizarParcelamento(p)) {
+        QMessageBox::warning(this, "Erro", "Não foi possível gravar a compra parcelada.");
+        return;
+    }
+    carregar();
+    emit dadosAlterados();
+}
+
+// Formulário do plano, preenchido com `p`; uma compra encerrada pode ser
+// reaberta desmarcando o encerramento. false se cancelado ou inválido.
+bool GastosVariaveisWidget::dialogoParcelamento(Parcelamento &p, const QString &titulo)
+{
+    QDialog dialogo(this);
+    dialogo.setWindowTitle(titulo);
+
+    auto *historico = new QLineEdit(p.historico);
+    auto *total     = new QLineEdit(p.totalCentavos > 0 ? centavosParaTexto(p.totalCentavos) : QString());
+    total->setPlaceholderText("R$ 0,00");
+    auto *parcelas  = new QSpinBox;
+    parcelas->setRange(2, 120);
+    parcelas->setValue(p.parcelas);
+    parcelas->setSuffix("×");
+    auto *primeira  = new QDateEdit(p.primeiraData);
+    primeira->setCalendarPopup(true);
+    primeira->setDisplayFormat("dd/MM/yyyy");
+    auto *categoria = new QComboBox;
+    for (const Categoria &cat : m_categorias)
+        categoria->addItem(cat.nome, cat.id);
+    const int atual = categoria->findData(p.categoriaId);
+    if (atual >= 0) categoria->setCurrentIndex(atual);
+
+    auto *botoes = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+    connect(botoes, &QDialogButtonBox::accepted, &dialogo, &QDialog::accept);
+    connect(botoes, &QDialogButtonBox::rejected, &dialogo, &QDialog::reject);
+
+    auto *form = new QFormLayout(&dialogo);
+    form->addRow("Histórico",        historico);
+    form->addRow("Valor total",      total);
+    form->addRow("Parcelas",         parcelas);
+    form->addRow("Primeira parcela", primeira);
+    form->addRow("Categoria",        categoria);
+    QCheckBox *encerrada = nullptr;
+    if (p.encerrado()) {
+        encerrada = new QCheckBox(QString("Encerrada após a parcela %1").arg(p.quantidadeVigente()));
+        encerrada->setChecked(true);
+        form->addRow(QString(), encerrada);
+    }
+    form->addRow(botoes);
+
+    if (dialogo.exec() != QDialog::Accepted) return false;
+
+    p.historico     = historico->text().trimmed();
+    p.totalCentavos = textoParaCentavos(total->text());
+    p.parcelas      = parcelas->value();
+    p.primeiraData  = primeira->date();
+    p.categoriaId   = categoria->currentData().toInt();
+    if (encerrada && !encerrada->isChecked()) p.vigentes = 0;
+    if (p.totalCentavos <= 0) {
+        QMessageBox::warning(this, titulo, "Informe o valor total da compra.");
+        return false;
+    }
+    return true;
+}
+
+// ── Importar extrato ──────────────────────────────────────────────────────────
+
+void GastosVariaveisWidget::importarExtrato()
+{
+    if (m_categorias.isEmpty()) {
+        QMessageBox::warning(this, "Sem categorias",
+            "Cadastre ao menos uma categoria em Configurações.");
+        return;
+    }
+
+    const QString caminho = QFileDialog::getOpenFileName(
+        this, "Importar extrato", QString(), "Extratos CSV (*.csv *.txt)");
+    if (caminho.isEmpty()) return;
+
+    // Linhas sem regra nem palpite confiante caem em "Outros" (ou na primeira categoria)
+    int categoriaId = m_categorias.first().id;
+    for (const Categoria &cat : m_categorias)
+        if (cat.nome == "Outros") categoriaId = cat.id;
+
+    const auto res = StatementImporter::importarCsv(
+        caminho, TipoLancamento::GastoVariavel, categoriaId);
+    if (!res.ok) {
+        QMessageBox::warning(this, "Importar extrato",
+            "Não foi possível importar o extrato.\n\n" + res.erro);
+        return;
+    }
+
+    carregar();
+    emit dadosAlterados();
+
+    QMessageBox::information(this, "Importar extrato",
+        QString("%1 gasto(s) importado(s): %2 categorizado(s) por regra, "
+                "%3 pelo histórico de lançamentos.\n"
+                "%4 duplicado(s) já existente(s) ignorado(s).\n"
+                "%5 linha(s) não reconhecida(s).\n"
+                "%6 crédito(s) ignorado(s) — não são gastos.\n"
+                "%7 gasto(s) muito acima do habitual.")
+            .arg(res.importados).arg(res.categorizados).arg(res.previstos)
+            .arg(res.duplicados).arg(res.invalidos).arg(res.opostos).arg(res.atipicos));
+}
+
 // ── Edição inline ─────────────────────────────────────────────────────────────
 
 void GastosVariaveisWidget::onItemChanged(QTableWidgetItem *item)
@@ -277,6 +740,12 @@ void GastosVariaveisWidget::onItemChanged(QTableWidgetItem *item)
         m_carregando = false;
     }
 
+    if (item->column() == COL_HIST) {
+        if (m_sugestao.row == row && item->text() == m_sugestao.historico) aplicarSugestao(row);
+        else aplicarCategoriaAutomatica(row);
+        m_sugestao = {};
+    }
+
     salvarLinha(row);
     atualizarTotal();
     emit dadosAlterados();
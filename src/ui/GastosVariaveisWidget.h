@@ -2,12 +2,18 @@
 
 #include "models/Categoria.h"
 #include "models/GastoVariavel.h"
+#include "models/Parcelamento.h"
+#include "models/Periodo.h"
 
 #include <QComboBox>
+#include <QHash>
 #include <QList>
 #include <QTableWidget>
 #include <QWidget>
 
+class CampoBusca;
+class DelegateHistorico;
+
 class GastosVariaveisWidget : public QWidget
 {
     Q_OBJECT
@@ -18,26 +24,63 @@ signals:
 public:
     explicit GastosVariaveisWidget(QWidget *parent = nullptr);
 
+    // Relê o banco e reconstrói a tabela
+    void carregar();
+
+    // Período selecionado na janela; recarrega só as linhas dele
+    void definirPeriodo(const Periodo &periodo);
     void recarregarCategorias();
 
 private slots:
     void adicionarGasto();
     void removerGasto();
+    void adicionarCompraParcelada();
+    void editarCompraParcelada(int parcelamentoId);
+    void importarExtrato();
     void onItemChanged(QTableWidgetItem *item);
 
 private:
-    void carregar();
     void adicionarLinha(const GastoVariavel &g);
+    void adicionarParcela(int indice);
+    bool dialogoParcelamento(Parcelamento &p, const QString &titulo);
     void inserirLinhaTotalVazia();
     void atualizarTotal();
+    void aplicarFiltro();
+    void aplicarSugestao(int row);
+    void aplicarCategoriaAutomatica(int row);
     void salvarLinha(int row);
     void conectarCombo(QComboBox *combo, int row);
+    void marcarAtipico(int row);
+    void marcarOrcamento(int row);
+    QVariant desindexarOrcamento(int row);
+    void reavaliarOrcamento(quint64 chave);
+    void pintarOrcamento(int row, bool estourado);
 
     int       idDaLinha(int row) const;
+    int       parcelaDaLinha(int row) const;  // índice em m_parcelas, ou -1
     bool      isTotalRow(int row) const;
     QComboBox *comboDaLinha(int row) const;
 
-    QList<Categoria> m_categorias;
-    QTableWidget    *m_tabela;
-    bool             m_carregando = false;
+    // Sugestão escolhida no autocompletar, aplicada quando o histórico é gravado
+    struct SugestaoPendente {
+        int     row = -1;
+        QString historico;
+        int     categoriaId   = 0;
+        qint64  valorCentavos = 0;
+    };
+
+    QList<Categoria>   m_categorias;
+    QList<Parcela>     m_parcelas;  // calculadas para o período, só leitura
+    QTableWidget      *m_tabela;
+    CampoBusca        *m_busca;
+    QString            m_filtro;  // texto da busca ativa
+    DelegateHistorico *m_delegateHist;
+    SugestaoPendente   m_sugestao;
+    Periodo            m_periodo;
+    bool               m_carregando = false;
+
+    // Índice de orçamentos: item de Data das linhas de cada (categoria, mês) e
+    // se o par estava estourado na última avaliação
+    QHash<quint64, QList<QTableWidgetItem *>> m_linhasOrcamento;
+    QHash<quint64, bool>                      m_estourado;
 };
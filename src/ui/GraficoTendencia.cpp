@@ -0,0 +1,211 @@
+#include "ui/GraficoTendencia.h"
+
+#include "core/DatabaseManager.h"
+#include "ui/DesenhoGraficos.h"
+#include "ui/ImagemGrafico.h"
+#include "utils/Lttb.h"
+#include "utils/Tracer.h"
+
+#include <QComboBox>
+#include <QDateTime>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+static qreal xDe(const QDate &data)
+{
+    return qreal(data.startOfDay().toMSecsSinceEpoch());
+}
+
+// ── Construtor ────────────────────────────────────────────────────────────────
+
+GraficoTendencia::GraficoTendencia(QWidget *parent)
+    : QWidget(parent)
+{
+    auto *root = new QVBoxLayout(this);
+    root->setContentsMargins(0, 0, 0, 0);
+    root->setSpacing(4);
+
+    // ── Cabeçalho ─────────────────────────────────────────────────────────────
+    auto *titulo = new QLabel("Entradas × gastos");
+    titulo->setFont(QFont("Inter", 13, QFont::DemiBold));
+
+    m_granularidade = new QComboBox;
+    m_granularidade->addItems({"Automática", "Mensal", "Diária"});  // ordem de Granularidade
+
+    auto *btnInteiro = new QPushButton("Período inteiro");
+    btnInteiro->setProperty("secondary", true);
+
+    auto *cabecalho = new QHBoxLayout;
+    cabecalho->setSpacing(8);
+    cabecalho->addWidget(titulo);
+    cabecalho->addStretch();
+    cabecalho->addWidget(m_granularidade);
+    cabecalho->addWidget(btnInteiro);
+    root->addLayout(cabecalho);
+
+    // ── Gráfico ───────────────────────────────────────────────────────────────
+    m_imagem = new ImagemGrafico;
+    m_imagem->definirSelecao(true);
+    root->addWidget(m_imagem);
+
+    m_recalculo.setSingleShot(true);
+    m_recalculo.setInterval(50);
+
+    connect(&m_recalculo, &QTimer::timeout, this, &GraficoTendencia::atualizar);
+    connect(m_imagem, &ImagemGrafico::selecionado, this,
+            [this](qreal x0, qreal x1) { aplicarZoom(dataEm(x0), dataEm(x1)); });
+    connect(m_imagem, &ImagemGrafico::afastado, this, [this]() {
+        // Dobra o trecho em torno do centro, como o QChartView fazia
+        const qint64 dias = m_inicio.daysTo(m_fim) + 1;
+        const QDate  centro = m_inicio.addDays(dias / 2);
+        aplicarZoom(centro.addDays(-dias), centro.addDays(dias));
+    });
+    connect(m_granularidade, &QComboBox::currentIndexChanged, this, &GraficoTendencia::atualizar);
+    connect(btnInteiro, &QPushButton::clicked, this, [this]() {
+        m_zoom = false;
+        atualizar();
+    });
+}
+
+// ── Período e zoom ────────────────────────────────────────────────────────────
+
+void GraficoTendencia::definirPeriodo(const Periodo &periodo)
+{
+    m_periodo = periodo;
+    m_zoom    = false;
+}
+
+// Sem limite no período ("Tudo"): do primeiro ao último lançamento
+void GraficoTendencia::restaurarZoom()
+{
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    m_inicio = m_periodo.inicio.isValid() ? m_periodo.inicio : cache.primeiraData();
+    m_fim    = m_periodo.fim.isValid()    ? m_periodo.fim    : cache.ultimaData();
+}
+
+QDate GraficoTendencia::dataEm(qreal x) const
+{
+    const QRectF plot = DesenhoGraficos::areaPlotagem(QRectF(m_imagem->rect()));
+    const qreal  fracao = qBound<qreal>(0, (x - plot.left()) / qMax<qreal>(plot.width(), 1), 1);
+    return QDateTime::fromMSecsSinceEpoch(qint64(m_xMin + fracao * (m_xMax - m_xMin))).date();
+}
+
+// Seleção ou afastamento: guarda o trecho (sem sair do período) e relê os
+// baldes quando o usuário para
+void GraficoTendencia::aplicarZoom(const QDate &inicio, const QDate &fim)
+{
+    if (!inicio.isValid() || !fim.isValid()) return;
+
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    const QDate minimo = m_periodo.inicio.isValid() ? m_periodo.inicio : cache.primeiraData();
+    const QDate maximo = m_periodo.fim.isValid()    ? m_periodo.fim    : cache.ultimaData();
+
+    m_inicio = minimo.isValid() ? qMax(inicio, minimo) : inicio;
+    m_fim    = maximo.isValid() ? qMin(fim, maximo)    : fim;
+    if (m_fim < m_inicio) m_fim = m_inicio;
+    m_zoom = true;
+    m_recalculo.start();
+}
+
+void GraficoTendencia::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_recalculo.start();  // mais ou menos pixels → outro limite do LTTB
+}
+
+// ── Séries ────────────────────────────────────────────────────────────────────
+
+QList<QPointF> GraficoTendencia::serieMensal(bool gastos) const
+{
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    const QDate primeiro(m_inicio.year(), m_inicio.month(), 1);
+    const int meses = (m_fim.year() - primeiro.year()) * 12 + m_fim.month() - primeiro.month() + 1;
+
+    QList<qint64> totais = cache.somaPorMes(gastos ? TipoLancamento::GastoFixo : TipoLancamento::Entrada,
+                                            primeiro, meses);
+    if (gastos) {
+        const QList<qint64> variaveis = cache.somaPorMes(TipoLancamento::GastoVariavel, primeiro, meses);
+        for (qsizetype i = 0; i < totais.size(); ++i) totais[i] += variaveis[i];
+    }
+
+    QList<QPointF> pontos;
+    pontos.reserve(totais.size());
+    for (qsizetype i = 0; i < totais.size(); ++i)
+        pontos.append({xDe(primeiro.addMonths(int(i))), totais[i] / 100.0});
+    return pontos;
+}
+
+QList<QPointF> GraficoTendencia::serieDiaria(bool gastos) const
+{
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    QList<qint64> totais = cache.somaPorDia(gastos ? TipoLancamento::GastoFixo : TipoLancamento::Entrada,
+                                            m_inicio, m_fim);
+    if (gastos) {
+        const QList<qint64> variaveis = cache.somaPorDia(TipoLancamento::GastoVariavel, m_inicio, m_fim);
+        for (qsizetype i = 0; i < totais.size(); ++i) totais[i] += variaveis[i];
+    }
+
+    // x em ms: um dia = 86 400 000; sem QDate por ponto
+    const qreal x0 = xDe(m_inicio);
+    constexpr qreal DIA_MS = 86400000.0;
+    QList<QPointF> pontos;
+    pontos.reserve(totais.size());
+    for (qsizetype i = 0; i < totais.size(); ++i)
+        pontos.append({x0 + qreal(i) * DIA_MS, totais[i] / 100.0});
+    return pontos;
+}
+
+// ── Atualizar ─────────────────────────────────────────────────────────────────
+
+void GraficoTendencia::atualizar()
+{
+    TRACE_SPAN("GraficoTendencia::atualizar", "ui");
+    m_recalculo.stop();
+    if (!m_zoom) restaurarZoom();
+
+    const CacheAnalitico &cache = DatabaseManager::instance().analitico();
+    const auto granularidade = Granularidade(m_granularidade->currentIndex());
+    const bool mensal = granularidade == Granularidade::Mensal
+                     || (granularidade == Granularidade::Automatica
+                         && m_inicio.daysTo(m_fim) + 1 > LIMIAR_MENSAL_DIAS);
+
+    // Um ponto por pixel da área de plotagem, no máximo
+    const QRectF    plot   = DesenhoGraficos::areaPlotagem(QRectF(m_imagem->rect()));
+    const qsizetype pixels = qMax<qsizetype>(qsizetype(plot.width()), 3);
+
+    // Troca de aba ou dadosAlterados sem mudança no cache: nada a refazer, o
+    // ImagemGrafico repinta a imagem que já tem
+    const quint64 versao = qHashMulti(0, cache.versao(), m_inicio, m_fim, mensal, pixels);
+    if (versao == m_versao) return;
+    m_versao = versao;
+
+    DesenhoGraficos::Linhas linhas;
+    if (m_inicio.isValid() && m_fim.isValid()) {
+        const QDate inicioEixo = mensal ? QDate(m_inicio.year(), m_inicio.month(), 1) : m_inicio;
+        linhas.xMin        = xDe(inicioEixo);
+        linhas.xMax        = xDe(m_fim);
+        linhas.formatoData = mensal ? "MM/yyyy" : "dd/MM/yy";
+        linhas.series = {
+            {"Entradas", reduzirLttb(mensal ? serieMensal(false) : serieDiaria(false), pixels),
+             QColor("#166F4A"), QColor("#22A367")},
+            {"Gastos",   reduzirLttb(mensal ? serieMensal(true)  : serieDiaria(true),  pixels),
+             QColor("#C94040"), QColor("#E85555")},
+        };
+
+        qreal maximo = 0;
+        for (const DesenhoGraficos::Serie &serie : std::as_const(linhas.series))
+            for (const QPointF &p : serie.pontos) maximo = qMax(maximo, p.y());
+        linhas.yMax = maximo > 0 ? maximo * 1.1 : 1;
+    } else {
+        linhas.series = {{"Entradas", {}, QColor("#166F4A"), QColor("#22A367")},
+                         {"Gastos",   {}, QColor("#C94040"), QColor("#E85555")}};
+    }
+    m_xMin = linhas.xMin;
+    m_xMax = linhas.xMax;
+
+    m_imagem->definirDesenho(versao, [linhas](QPainter &p, const QRectF &area, bool escuro) {
+        DesenhoGraficos::linhas(p, area, linhas, escuro);
+    });
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "models/Periodo.h"
+
+#include <QDate>
+#include <QList>
+#include <QPointF>
+#include <QTimer>
+#include <QWidget>
+
+class ImagemGrafico;
+class QComboBox;
+
+// Entradas × gastos (fixos + variáveis) no tempo, do cache analítico. Baldes
+// mensais ou diários conforme o trecho visível; cada série é reduzida por LTTB
+// à largura em pixels da área de plotagem, então o redesenho não cresce com o
+// histórico. Zoom por seleção horizontal (botão direito afasta) refaz os
+// baldes só do trecho visível — diários quando ele fica curto. Pintado fora
+// da thread da GUI por ImagemGrafico; séries e imagem só são refeitas quando
+// o cache, o trecho, a granularidade ou a largura mudam.
+class GraficoTendencia : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class Granularidade { Automatica, Mensal, Diaria };
+
+    // Automática: mensal acima de tantos dias visíveis, diária abaixo
+    static constexpr int LIMIAR_MENSAL_DIAS = 730;
+
+    explicit GraficoTendencia(QWidget *parent = nullptr);
+
+    // Novo período: o zoom volta a cobri-lo inteiro no próximo atualizar()
+    void definirPeriodo(const Periodo &periodo);
+
+public slots:
+    void atualizar();
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void restaurarZoom();
+    void aplicarZoom(const QDate &inicio, const QDate &fim);
+    QDate dataEm(qreal x) const;  // pixel da área do gráfico → dia
+
+    QList<QPointF> serieMensal(bool gastos) const;
+    QList<QPointF> serieDiaria(bool gastos) const;
+
+    ImagemGrafico *m_imagem;
+    QComboBox     *m_granularidade;
+
+    Periodo m_periodo;
+    QDate   m_inicio;             // trecho visível (zoom), fechado
+    QDate   m_fim;
+    qreal   m_xMin = 0;           // eixo x desenhado, em ms
+    qreal   m_xMax = 1;
+    quint64 m_versao = 0;         // entradas do último desenho (cache, trecho, modo, pixels)
+    QTimer  m_recalculo;          // agrupa seleções/resize em uma releitura
+    bool    m_zoom = false;       // trecho escolhido pelo usuário, não o período
+};
@@ -0,0 +1,133 @@
+#include "ui/ImagemGrafico.h"
+
+#include "ui/Theme.h"
+#include "utils/Tracer.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPromise>
+#include <QThreadPool>
+
+#include <memory>
+
+// Poucos quadros por widget bastam: o atual, o do outro tema e um ou dois
+// tamanhos de janela recentes
+static constexpr int CACHE_KIB = 32 * 1024;
+
+ImagemGrafico::ImagemGrafico(QWidget *parent)
+    : QWidget(parent)
+    , m_cache(CACHE_KIB)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    connect(&m_watcher, &QFutureWatcher<QImage>::finished, this, [this]() {
+        m_renderizando = false;
+        if (m_watcher.future().resultCount() > 0) {
+            const QImage imagem = m_watcher.result();
+            m_cache.insert(m_emRender, new QImage(imagem),
+                           qMax<qsizetype>(imagem.sizeInBytes() / 1024, 1));
+            m_ultima = imagem;
+        }
+        update();  // se a chave mudou durante o render, o paintEvent pede outra
+    });
+}
+
+void ImagemGrafico::definirDesenho(quint64 versao, Desenho desenho)
+{
+    if (versao == m_versao && m_desenho) return;
+    m_versao  = versao;
+    m_desenho = std::move(desenho);
+    update();
+}
+
+ImagemGrafico::Chave ImagemGrafico::chaveAtual() const
+{
+    return {m_versao, size(), devicePixelRatioF(), Theme::isDark()};
+}
+
+// ── Renderização ──────────────────────────────────────────────────────────────
+
+void ImagemGrafico::renderizar(const Chave &chave)
+{
+    m_renderizando = true;
+    m_emRender     = chave;
+
+    auto promessa = std::make_shared<QPromise<QImage>>();
+    promessa->start();
+    m_watcher.setFuture(promessa->future());
+
+    // A tarefa não toca no widget: se ele morrer antes, o resultado é descartado
+    QThreadPool::globalInstance()->start([promessa, desenho = m_desenho, chave]() {
+        TRACE_SPAN("ImagemGrafico::renderizar", "ui");
+        QImage imagem(chave.tamanho * chave.dpr, QImage::Format_ARGB32_Premultiplied);
+        imagem.setDevicePixelRatio(chave.dpr);
+        imagem.fill(Qt::transparent);
+        {
+            QPainter p(&imagem);
+            p.setRenderHint(QPainter::Antialiasing);
+            p.setRenderHint(QPainter::TextAntialiasing);
+            desenho(p, QRectF(QPointF(0, 0), QSizeF(chave.tamanho)), chave.escuro);
+        }
+        promessa->addResult(imagem);
+        promessa->finish();
+    });
+}
+
+void ImagemGrafico::paintEvent(QPaintEvent *)
+{
+    if (!m_desenho || width() <= 0 || height() <= 0) return;
+
+    const Chave chave = chaveAtual();
+    if (const QImage *pronta = m_cache.object(chave))
+        m_ultima = *pronta;
+    else if (!m_renderizando)
+        renderizar(chave);
+
+    QPainter p(this);
+    if (!m_ultima.isNull())
+        p.drawImage(rect(), m_ultima);  // esticada só enquanto a do tamanho novo não chega
+
+    if (!m_faixa.isNull()) {
+        QColor cor = palette().color(QPalette::Highlight);
+        p.setPen(cor);
+        cor.setAlpha(50);
+        p.setBrush(cor);
+        p.drawRect(m_faixa.adjusted(0, 0, -1, -1));
+    }
+}
+
+// ── Seleção ───────────────────────────────────────────────────────────────────
+
+void ImagemGrafico::mousePressEvent(QMouseEvent *event)
+{
+    if (!m_selecao) return QWidget::mousePressEvent(event);
+
+    if (event->button() == Qt::RightButton) {
+        emit afastado();
+    } else if (event->button() == Qt::LeftButton) {
+        m_origemX = event->position().toPoint().x();
+        m_faixa   = {};
+    }
+}
+
+void ImagemGrafico::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_origemX < 0) return QWidget::mouseMoveEvent(event);
+
+    const int x = qBound(0, event->position().toPoint().x(), width() - 1);
+    m_faixa = QRect(QPoint(qMin(m_origemX, x), 0), QPoint(qMax(m_origemX, x), height() - 1));
+    update();
+}
+
+void ImagemGrafico::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_origemX < 0 || event->button() != Qt::LeftButton)
+        return QWidget::mouseReleaseEvent(event);
+
+    const QRect faixa = m_faixa;
+    m_origemX = -1;
+    m_faixa   = {};
+    update();
+    if (faixa.width() > 4)  // clique sem arraste não é zoom
+        emit selecionado(faixa.left(), faixa.right());
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QCache>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QWidget>
+
+#include <functional>
+
+class QPainter;
+
+// Área de gráfico que pinta num QImage numa thread do pool global e, no
+// paintEvent, só copia a imagem pronta. As imagens ficam num QCache pela
+// chave (versão dos dados, tamanho, DPI, tema): repintar, trocar de aba ou
+// voltar ao tamanho/tema anterior não redesenha nada. Enquanto a imagem nova
+// não chega, a última é esticada no lugar — sem quadro vazio.
+class ImagemGrafico : public QWidget
+{
+    Q_OBJECT
+
+signals:
+    // Só com definirSelecao(true): arraste horizontal com o botão esquerdo
+    // (x em coordenadas do widget) e clique com o botão direito
+    void selecionado(qreal x0, qreal x1);
+    void afastado();
+
+public:
+    // Roda fora da thread da GUI: só pode usar o que capturou por valor
+    using Desenho = std::function<void(QPainter &p, const QRectF &area, bool escuro)>;
+
+    explicit ImagemGrafico(QWidget *parent = nullptr);
+
+    // `versao` identifica o que `desenho` pinta: a mesma versão com o mesmo
+    // tamanho, DPI e tema reaproveita a imagem guardada
+    void definirDesenho(quint64 versao, Desenho desenho);
+
+    void definirSelecao(bool ativa) { m_selecao = ativa; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+    struct Chave
+    {
+        quint64 versao = 0;
+        QSize   tamanho;
+        qreal   dpr    = 1;
+        bool    escuro = false;
+
+        bool operator==(const Chave &) const = default;
+        friend size_t qHash(const Chave &c, size_t seed = 0)
+        {
+            return qHashMulti(seed, c.versao, c.tamanho.width(), c.tamanho.height(), c.dpr, c.escuro);
+        }
+    };
+
+    Chave chaveAtual() const;
+    void  renderizar(const Chave &chave);
+
+    Desenho m_desenho;
+    quint64 m_versao = 0;
+
+    QCache<Chave, QImage>  m_cache;          // custo em KiB
+    QImage                 m_ultima;         // último quadro pronto
+    QFutureWatcher<QImage> m_watcher;
+    Chave                  m_emRender;
+    bool                   m_renderizando = false;  // uma imagem por vez por widget
+
+    bool m_selecao = false;
+    int  m_origemX = -1;                     // início do arraste; -1 sem arraste
+    QRect m_faixa;
+};
@@ -1,11 +1,14 @@
 #include "ui/MainWindow.h"
 
+#include "ui/CalendarioWidget.h"
 #include "ui/ConfigWidget.h"
 #include "ui/DashboardWidget.h"
 #include "ui/EntradasWidget.h"
 #include "ui/GastosFixosWidget.h"
 #include "ui/GastosVariaveisWidget.h"
+#include "ui/SeletorPeriodo.h"
 
+#include <QCloseEvent>
 #include <QStatusBar>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -16,17 +19,21 @@ MainWindow::MainWindow(QWidget *parent)
     setMinimumSize(900, 600);
 
     m_tabs            = new QTabWidget(this);
+    m_periodo         = new SeletorPeriodo(this);
     m_dashboard       = new DashboardWidget(this);
+    m_calendario      = new CalendarioWidget(this);
     m_entradas        = new EntradasWidget(this);
     m_gastosFixos     = new GastosFixosWidget(this);
     m_gastosVariaveis = new GastosVariaveisWidget(this);
     m_config          = new ConfigWidget(this);
 
     m_tabs->addTab(m_dashboard,       "Dashboard");
+    m_tabs->addTab(m_calendario,      "Calendário");
     m_tabs->addTab(m_entradas,        "Entradas");
     m_tabs->addTab(m_gastosFixos,     "Gastos Fixos");
     m_tabs->addTab(m_gastosVariaveis, "Gastos Variáveis");
     m_tabs->addTab(m_config,          "Configurações");
+    m_tabs->setCornerWidget(m_periodo, Qt::TopRightCorner);
 
     setCentralWidget(m_tabs);
     statusBar()->hide();
@@ -34,22 +41,45 @@ MainWindow::MainWindow(QWidget *parent)
     conectarSinais();
 }
 
+void MainWindow::closeEvent(QCloseEvent *event)
+{
+    m_config->encerrarTarefas();
+    QMainWindow::closeEvent(event);
+}
+
 void MainWindow::conectarSinais()
 {
-    // Qualquer alteração de dados recalcula o dashboard
-    auto refresh = [this]() { m_dashboard->atualizar(); };
+    // Qualquer alteração de dados recalcula o dashboard e o calendário
+    auto refresh = [this]() {
+        m_dashboard->atualizar();
+        m_calendario->atualizar();
+    };
 
     connect(m_entradas,        &EntradasWidget::dadosAlterados,        this, refresh);
     connect(m_gastosFixos,     &GastosFixosWidget::dadosAlterados,     this, refresh);
     connect(m_gastosVariaveis, &GastosVariaveisWidget::dadosAlterados, this, refresh);
     connect(m_config, &ConfigWidget::categoriasAlteradas, this, refresh);
 
+    // Um período para todas as abas: cada uma relê só o intervalo escolhido
+    connect(m_periodo, &SeletorPeriodo::periodoAlterado, m_dashboard,       &DashboardWidget::definirPeriodo);
+    connect(m_periodo, &SeletorPeriodo::periodoAlterado, m_calendario,      &CalendarioWidget::definirPeriodo);
+    connect(m_periodo, &SeletorPeriodo::periodoAlterado, m_entradas,        &EntradasWidget::definirPeriodo);
+    connect(m_periodo, &SeletorPeriodo::periodoAlterado, m_gastosFixos,     &GastosFixosWidget::definirPeriodo);
+    connect(m_periodo, &SeletorPeriodo::periodoAlterado, m_gastosVariaveis, &GastosVariaveisWidget::definirPeriodo);
+
     // Quando categorias mudam, recarrega os combos dos widgets de gastos
     connect(m_config, &ConfigWidget::categoriasAlteradas,
             m_gastosFixos,     &GastosFixosWidget::recarregarCategorias);
     connect(m_config, &ConfigWidget::categoriasAlteradas,
             m_gastosVariaveis, &GastosVariaveisWidget::recarregarCategorias);
 
+    // Sem edições durante VACUUM/ANALYZE, que escrevem no .db por outra conexão
+    connect(m_config, &ConfigWidget::manutencaoEmAndamento, this, [this](bool emAndamento) {
+        const QList<QWidget *> abas = {m_entradas, m_gastosFixos, m_gastosVariaveis};
+        for (QWidget *aba : abas)
+            aba->setEnabled(!emAndamento);
+    });
+
     // Ao trocar para a aba Dashboard, sempre recalcula
     connect(m_tabs, &QTabWidget::currentChanged, this, [this](int idx) {
         if (m_tabs->widget(idx) == m_dashboard)
@@ -3,11 +3,13 @@
 #include <QMainWindow>
 #include <QTabWidget>
 
+class CalendarioWidget;
 class DashboardWidget;
 class EntradasWidget;
 class GastosFixosWidget;
 class GastosVariaveisWidget;
 class ConfigWidget;
+class SeletorPeriodo;
 
 class MainWindow : public QMainWindow
 {
@@ -16,11 +18,18 @@ class MainWindow : public QMainWindow
 public:
     explicit MainWindow(QWidget *parent = nullptr);
 
+protected:
+    // Antes do aboutToQuit (e de DatabaseManager::desconectar()): encerra as
+    // threads que leem o banco
+    void closeEvent(QCloseEvent *event) override;
+
 private:
     void conectarSinais();
 
     QTabWidget            *m_tabs;
+    SeletorPeriodo        *m_periodo;
     DashboardWidget       *m_dashboard;
+    CalendarioWidget      *m_calendario;
     EntradasWidget        *m_entradas;
     GastosFixosWidget     *m_gastosFixos;
     GastosVariaveisWidget *m_gastosVariaveis;
@@ -0,0 +1,218 @@
+#include "ui/MapaCalor.h"
+
+#include "ui/Theme.h"
+#include "utils/CurrencyUtils.h"
+
+#include <QHelpEvent>
+#include <QLocale>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+
+#include <algorithm>
+
+static constexpr int MARGEM_ESQUERDA = 32;  // rótulos dos dias da semana
+static constexpr int MARGEM_TOPO     = 20;  // rótulos dos meses
+static constexpr int ALTURA_LEGENDA  = 28;
+static constexpr int ESPACO          = 3;   // entre células
+static constexpr int SEMANAS         = 54;  // ano bissexto começando no domingo
+
+static QColor misturar(const QColor &a, const QColor &b, qreal t)
+{
+    return QColor::fromRgbF(a.redF()   + (b.redF()   - a.redF())   * t,
+                            a.greenF() + (b.greenF() - a.greenF()) * t,
+                            a.blueF()  + (b.blueF()  - a.blueF())  * t);
+}
+
+// Cor de cada nível, do vazio ao vermelho dos gastos
+static QColor corNivel(int nivel, bool escuro)
+{
+    static constexpr qreal FRACAO[] = {0, 0.30, 0.50, 0.75, 1.0};
+    const QColor vazio = escuro ? QColor("#2A2A31") : QColor("#EBEAE6");
+    const QColor cheio = escuro ? QColor("#E85555") : QColor("#C94040");
+    return misturar(vazio, cheio, FRACAO[nivel]);
+}
+
+MapaCalor::MapaCalor(QWidget *parent)
+    : QWidget(parent)
+{
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+}
+
+QSize MapaCalor::sizeHint() const
+{
+    return {MARGEM_ESQUERDA + SEMANAS * (16 + ESPACO), MARGEM_TOPO + 7 * (16 + ESPACO) + ALTURA_LEGENDA};
+}
+
+QSize MapaCalor::minimumSizeHint() const
+{
+    return {MARGEM_ESQUERDA + SEMANAS * (8 + ESPACO), MARGEM_TOPO + 7 * (8 + ESPACO) + ALTURA_LEGENDA};
+}
+
+// ── Dados ─────────────────────────────────────────────────────────────────────
+
+void MapaCalor::definirAno(int ano, const QList<GastoDiario> &dias)
+{
+    const QDate primeiro(ano, 1, 1);
+    m_ano = ano;
+    m_totais.fill(0, primeiro.daysInYear());
+    m_quantidades.fill(0, primeiro.daysInYear());
+    if (m_selecionado.isValid() && m_selecionado.year() != ano)
+        m_selecionado = {};
+
+    QList<qint64> comGasto;
+    comGasto.reserve(dias.size());
+    for (const GastoDiario &d : dias) {
+        if (d.dia.year() != ano) continue;
+        m_totais[d.dia.dayOfYear() - 1]      = d.totalCentavos;
+        m_quantidades[d.dia.dayOfYear() - 1] = d.quantidade;
+        if (d.totalCentavos > 0) comGasto.append(d.totalCentavos);
+    }
+
+    std::sort(comGasto.begin(), comGasto.end());
+    const qsizetype n = comGasto.size();
+    for (int i = 0; i < 3; ++i)
+        m_quartis[i] = n > 0 ? comGasto[n * (i + 1) / 4] : 0;
+
+    update();
+}
+
+int MapaCalor::nivel(qint64 totalCentavos) const
+{
+    if (totalCentavos <= 0)           return 0;
+    if (totalCentavos <= m_quartis[0]) return 1;
+    if (totalCentavos <= m_quartis[1]) return 2;
+    if (totalCentavos <= m_quartis[2]) return 3;
+    return 4;
+}
+
+// ── Geometria ─────────────────────────────────────────────────────────────────
+
+int MapaCalor::tamanhoCelula() const
+{
+    const int porLargura = (width() - MARGEM_ESQUERDA) / SEMANAS - ESPACO;
+    const int porAltura  = (height() - MARGEM_TOPO - ALTURA_LEGENDA) / 7 - ESPACO;
+    return qBound(6, qMin(porLargura, porAltura), 28);
+}
+
+QRect MapaCalor::celula(const QDate &dia) const
+{
+    const int tamanho = tamanhoCelula();
+    const int passo   = tamanho + ESPACO;
+    const int indice  = QDate(m_ano, 1, 1).dayOfWeek() - 1 + dia.dayOfYear() - 1;
+    return {MARGEM_ESQUERDA + indice / 7 * passo, MARGEM_TOPO + indice % 7 * passo, tamanho, tamanho};
+}
+
+QDate MapaCalor::diaEm(const QPoint &pos) const
+{
+    if (m_ano == 0 || pos.x() < MARGEM_ESQUERDA || pos.y() < MARGEM_TOPO) return {};
+
+    const int passo  = tamanhoCelula() + ESPACO;
+    const int coluna = (pos.x() - MARGEM_ESQUERDA) / passo;
+    const int linha  = (pos.y() - MARGEM_TOPO) / passo;
+    if (linha >= 7 || (pos.x() - MARGEM_ESQUERDA) % passo >= passo - ESPACO
+                   || (pos.y() - MARGEM_TOPO) % passo >= passo - ESPACO)
+        return {};
+
+    const QDate primeiro(m_ano, 1, 1);
+    const int   indice = coluna * 7 + linha - (primeiro.dayOfWeek() - 1);
+    if (indice < 0 || indice >= primeiro.daysInYear()) return {};
+    return primeiro.addDays(indice);
+}
+
+// ── Pintura ───────────────────────────────────────────────────────────────────
+
+void MapaCalor::paintEvent(QPaintEvent *)
+{
+    if (m_ano == 0) return;
+
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing);
+    const bool   escuro = Theme::isDark();
+    const QColor texto  = escuro ? QColor("#9A9895") : QColor("#6E6D6A");
+    const QLocale local(QLocale::Portuguese, QLocale::Brazil);
+    const int    tamanho = tamanhoCelula();
+    const qreal  raio    = tamanho / 5.0;
+
+    p.setFont(QFont("Inter", 10));
+    p.setPen(texto);
+
+    // Dias da semana (segunda no topo) e meses acima da coluna do dia 1
+    const QStringList semana = {"Seg", "", "Qua", "", "Sex", "", ""};
+    for (int linha = 0; linha < 7; ++linha) {
+        if (semana[linha].isEmpty()) continue;
+        const int topo = MARGEM_TOPO + linha * (tamanho + ESPACO);
+        p.drawText(QRect(0, topo, MARGEM_ESQUERDA - 6, tamanho),
+                   Qt::AlignRight | Qt::AlignVCenter, semana[linha]);
+    }
+    for (int mes = 1; mes <= 12; ++mes) {
+        const QRect r = celula(QDate(m_ano, mes, 1));
+        p.drawText(QRect(r.left(), 0, 4 * (tamanho + ESPACO), MARGEM_TOPO - 4),
+                   Qt::AlignLeft | Qt::AlignBottom, local.monthName(mes, QLocale::ShortFormat));
+    }
+
+    // Uma passada pelas células
+    p.setPen(Qt::NoPen);
+    const QDate primeiro(m_ano, 1, 1);
+    for (int i = 0; i < m_totais.size(); ++i) {
+        p.setBrush(corNivel(nivel(m_totais[i]), escuro));
+        p.drawRoundedRect(celula(primeiro.addDays(i)), raio, raio);
+    }
+
+    if (m_selecionado.isValid()) {
+        p.setBrush(Qt::NoBrush);
+        p.setPen(QPen(escuro ? QColor("#F0EFED") : QColor("#18181A"), 1.5));
+        p.drawRoundedRect(QRectF(celula(m_selecionado)).adjusted(-1, -1, 1, 1), raio, raio);
+    }
+
+    // Legenda: Menos ▢▢▢▢▢ Mais, alinhada à direita da grade
+    const int direita = celula(QDate(m_ano, 12, 31)).right() + 1;
+    const int topo    = MARGEM_TOPO + 7 * (tamanho + ESPACO) + 8;
+    const int largura = p.fontMetrics().horizontalAdvance("Mais") + 4;
+    int x = direita - largura;
+    p.setPen(texto);
+    p.drawText(QRect(x, topo, largura, tamanho), Qt::AlignRight | Qt::AlignVCenter, "Mais");
+    p.setPen(Qt::NoPen);
+    for (int n = 4; n >= 0; --n) {
+        x -= tamanho + ESPACO;
+        p.setBrush(corNivel(n, escuro));
+        p.drawRoundedRect(QRect(x, topo, tamanho, tamanho), raio, raio);
+    }
+    const int larguraMenos = p.fontMetrics().horizontalAdvance("Menos") + 4;
+    p.setPen(texto);
+    p.drawText(QRect(x - larguraMenos - ESPACO, topo, larguraMenos, tamanho),
+               Qt::AlignRight | Qt::AlignVCenter, "Menos");
+}
+
+// ── Interação ─────────────────────────────────────────────────────────────────
+
+void MapaCalor::mousePressEvent(QMouseEvent *event)
+{
+    const QDate dia = diaEm(event->position().toPoint());
+    if (event->button() != Qt::LeftButton || !dia.isValid())
+        return QWidget::mousePressEvent(event);
+
+    m_selecionado = dia;
+    update();
+    emit diaSelecionado(dia);
+}
+
+bool MapaCalor::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip) return QWidget::event(event);
+
+    auto *ajuda = static_cast<QHelpEvent *>(event);
+    const QDate dia = diaEm(ajuda->pos());
+    if (!dia.isValid()) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    const int i = dia.dayOfYear() - 1;
+    const QString resumo = m_quantidades[i] == 0
+        ? QString("sem gastos")
+        : QString("%1 em %2 gasto(s)").arg(centavosParaTexto(m_totais[i])).arg(m_quantidades[i]);
+    QToolTip::showText(ajuda->globalPos(), dia.toString("dd/MM/yyyy") + " — " + resumo, this);
+    return true;
+}
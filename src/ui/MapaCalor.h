@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/DatabaseManager.h"
+
+#include <QDate>
+#include <QList>
+#include <QWidget>
+
+// Um ano de gastos em grade de semanas (colunas) × dias da semana (linhas,
+// segunda no topo), cor pela intensidade do dia. Os totais chegam prontos de
+// agregado_diario; o paintEvent é uma única passada pelas ≤ 366 células, sem
+// widget nem item por dia. Intensidade em 4 níveis pelos quartis dos dias
+// com gasto do próprio ano — um mês caro não apaga o resto.
+class MapaCalor : public QWidget
+{
+    Q_OBJECT
+
+signals:
+    void diaSelecionado(const QDate &dia);
+
+public:
+    explicit MapaCalor(QWidget *parent = nullptr);
+
+    // Dias fora do ano são ignorados; dia ausente = sem gasto
+    void definirAno(int ano, const QList<GastoDiario> &dias);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    bool event(QEvent *event) override;  // tooltip com o total do dia
+
+private:
+    int   tamanhoCelula() const;
+    QRect celula(const QDate &dia) const;
+    QDate diaEm(const QPoint &pos) const;
+    int   nivel(qint64 totalCentavos) const;  // 0 (sem gasto) a 4
+
+    int           m_ano = 0;
+    QList<qint64> m_totais;       // índice: dayOfYear() - 1
+    QList<int>    m_quantidades;
+    qint64        m_quartis[3] = {0, 0, 0};
+    QDate         m_selecionado;
+};
@@ -0,0 +1,123 @@
+#include "ui/SeletorPeriodo.h"
+
+#include <QComboBox>
+#include <QDateEdit>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLocale>
+#include <QPushButton>
+
+// Mesma ordem de Periodo::Tipo
+static const QStringList TIPOS = {"Tudo", "Mês", "Trimestre", "Ano", "Personalizado"};
+
+SeletorPeriodo::SeletorPeriodo(QWidget *parent)
+    : QWidget(parent)
+{
+    auto *row = new QHBoxLayout(this);
+    row->setContentsMargins(0, 0, 0, 4);
+    row->setSpacing(6);
+
+    m_tipo = new QComboBox;
+    m_tipo->addItems(TIPOS);
+
+    m_anterior = new QPushButton("‹");
+    m_proximo  = new QPushButton("›");
+    for (auto *btn : {m_anterior, m_proximo}) {
+        btn->setProperty("secondary", true);
+        btn->setFixedWidth(32);
+    }
+
+    m_rotulo = new QLabel;
+    m_rotulo->setMinimumWidth(160);
+    m_rotulo->setAlignment(Qt::AlignCenter);
+    m_rotulo->setStyleSheet("font-size: 13px; font-weight: 500;");
+
+    m_inicio = new QDateEdit;
+    m_fim    = new QDateEdit;
+    for (auto *edit : {m_inicio, m_fim}) {
+        edit->setCalendarPopup(true);
+        edit->setDisplayFormat("dd/MM/yyyy");
+    }
+
+    row->addWidget(m_tipo);
+    row->addWidget(m_anterior);
+    row->addWidget(m_rotulo);
+    row->addWidget(m_inicio);
+    row->addWidget(m_fim);
+    row->addWidget(m_proximo);
+
+    connect(m_tipo, &QComboBox::currentIndexChanged, this, &SeletorPeriodo::trocarTipo);
+    connect(m_anterior, &QPushButton::clicked, this, [this]() { definir(m_periodo.deslocado(-1)); });
+    connect(m_proximo,  &QPushButton::clicked, this, [this]() { definir(m_periodo.deslocado(+1)); });
+    for (auto *edit : {m_inicio, m_fim}) {
+        connect(edit, &QDateEdit::dateChanged, this, [this]() {
+            if (!m_sincronizando)
+                definir(Periodo::personalizado(m_inicio->date(), m_fim->date()));
+        });
+    }
+
+    definir({});
+}
+
+QString SeletorPeriodo::descrever(const Periodo &periodo)
+{
+    const QLocale local(QLocale::Portuguese, QLocale::Brazil);
+    switch (periodo.tipo) {
+    case Periodo::Tipo::Tudo:
+        return "Todo o período";
+    case Periodo::Tipo::Mes: {
+        const QString mes = local.standaloneMonthName(periodo.inicio.month());
+        return QString("%1 de %2").arg(mes.left(1).toUpper() + mes.mid(1)).arg(periodo.inicio.year());
+    }
+    case Periodo::Tipo::Trimestre:
+        return QString("%1º trimestre de %2")
+            .arg((periodo.inicio.month() - 1) / 3 + 1).arg(periodo.inicio.year());
+    case Periodo::Tipo::Ano:
+        return QString::number(periodo.inicio.year());
+    case Periodo::Tipo::Personalizado:
+        break;
+    }
+    return periodo.inicio.toString("dd/MM/yyyy") + " – " + periodo.fim.toString("dd/MM/yyyy");
+}
+
+// Novo tipo ancorado no início do período atual (ou hoje, vindo de Tudo)
+void SeletorPeriodo::trocarTipo(int indice)
+{
+    if (m_sincronizando) return;
+    const QDate referencia = m_periodo.inicio.isValid() ? m_periodo.inicio : QDate::currentDate();
+
+    switch (Periodo::Tipo(indice)) {
+    case Periodo::Tipo::Tudo:      definir({});                              break;
+    case Periodo::Tipo::Mes:       definir(Periodo::mes(referencia));        break;
+    case Periodo::Tipo::Trimestre: definir(Periodo::trimestre(referencia));  break;
+    case Periodo::Tipo::Ano:       definir(Periodo::ano(referencia));        break;
+    case Periodo::Tipo::Personalizado: {
+        const Periodo base = m_periodo.limitado() ? m_periodo : Periodo::mes(referencia);
+        definir(Periodo::personalizado(base.inicio, base.fim));
+        break;
+    }
+    }
+}
+
+void SeletorPeriodo::definir(const Periodo &periodo)
+{
+    const bool mudou = !(periodo == m_periodo);
+    m_periodo = periodo;
+
+    m_sincronizando = true;
+    const bool personalizado = periodo.tipo == Periodo::Tipo::Personalizado;
+    m_tipo->setCurrentIndex(int(periodo.tipo));
+    m_rotulo->setText(descrever(periodo));
+    m_rotulo->setVisible(!personalizado);
+    m_inicio->setVisible(personalizado);
+    m_fim->setVisible(personalizado);
+    if (personalizado) {
+        m_inicio->setDate(periodo.inicio);
+        m_fim->setDate(periodo.fim);
+    }
+    m_anterior->setEnabled(periodo.tipo != Periodo::Tipo::Tudo);
+    m_proximo->setEnabled(periodo.tipo != Periodo::Tipo::Tudo);
+    m_sincronizando = false;
+
+    if (mudou) emit periodoAlterado(m_periodo);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "models/Periodo.h"
+
+#include <QWidget>
+
+class QComboBox;
+class QDateEdit;
+class QLabel;
+class QPushButton;
+
+// Período compartilhado por todas as abas (mês, trimestre, ano, intervalo ou
+// tudo), no canto da barra de abas da MainWindow. Emite periodoAlterado() a
+// cada troca; as abas repassam o período às queries do DatabaseManager.
+class SeletorPeriodo : public QWidget
+{
+    Q_OBJECT
+
+signals:
+    void periodoAlterado(const Periodo &periodo);
+
+public:
+    explicit SeletorPeriodo(QWidget *parent = nullptr);
+
+    Periodo periodo() const { return m_periodo; }
+
+    // "Fevereiro de 2026", "1º trimestre de 2026", "2026", "Todo o período"
+    static QString descrever(const Periodo &periodo);
+
+private:
+    void trocarTipo(int indice);
+    void definir(const Periodo &periodo);
+
+    QComboBox   *m_tipo;
+    QPushButton *m_anterior;
+    QLabel      *m_rotulo;
+    QPushButton *m_proximo;
+    QDateEdit   *m_inicio;
+    QDateEdit   *m_fim;
+    Periodo      m_periodo;
+    bool         m_sincronizando = false;  // bloqueia sinais dos controles em definir()
+};
@@ -117,7 +117,7 @@ QPushButton[secondary="true"]:hover {
 }
 
 /* ── Inputs ────────────────────────────────────────────────────────────── */
-QLineEdit, QComboBox {
+QLineEdit, QComboBox, QDateEdit {
     background-color: %9;
     color: %3;
     border: 1px solid %5;
@@ -128,11 +128,11 @@ QLineEdit, QComboBox {
     selection-background-color: %6;
 }
 
-QLineEdit:focus, QComboBox:focus {
+QLineEdit:focus, QComboBox:focus, QDateEdit:focus {
     border: 1px solid %6;
 }
 
-QLineEdit:disabled, QComboBox:disabled {
+QLineEdit:disabled, QComboBox:disabled, QDateEdit:disabled {
     color: %4;
 }
 
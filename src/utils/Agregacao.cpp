@@ -0,0 +1,151 @@
+#include "utils/Agregacao.h"
+
+#include <atomic>
+
+namespace {
+
+// ── Corpos ────────────────────────────────────────────────────────────────────
+// Inlinados em cada variante abaixo e vetorizados para o alvo dela
+
+[[gnu::always_inline]] inline qint64 somaMascaradaCorpo(const qint64 *valores, const quint8 *tipos,
+                                                         qsizetype n, quint8 tipo)
+{
+    qint64 soma = 0;
+    for (qsizetype i = 0; i < n; ++i)
+        soma += valores[i] & -qint64(tipos[i] == tipo);
+    return soma;
+}
+
+[[gnu::always_inline]] inline void somaPorChaveCorpo(const qint64 *valores, const quint8 *tipos,
+                                                      const qint32 *chaves, qsizetype n, quint8 tipo,
+                                                      qint64 *acumulado, qint32 nChaves)
+{
+    for (qsizetype i = 0; i < n; ++i) {
+        const qint32 chave = chaves[i];
+        if (chave < 0 || chave >= nChaves) continue;
+        acumulado[chave] += valores[i] & -qint64(tipos[i] == tipo);
+    }
+}
+
+// ── Variantes ─────────────────────────────────────────────────────────────────
+
+struct Kernels {
+    Cpu::NivelSimd nivel;
+    qint64 (*somaMascarada)(const qint64 *, const quint8 *, qsizetype, quint8);
+    void   (*somaPorChave)(const qint64 *, const quint8 *, const qint32 *, qsizetype, quint8,
+                           qint64 *, qint32);
+};
+
+qint64 somaMascaradaBase(const qint64 *v, const quint8 *t, qsizetype n, quint8 tipo)
+{
+    return somaMascaradaCorpo(v, t, n, tipo);
+}
+
+void somaPorChaveBase(const qint64 *v, const quint8 *t, const qint32 *c, qsizetype n,
+                      quint8 tipo, qint64 *a, qint32 k)
+{
+    somaPorChaveCorpo(v, t, c, n, tipo, a, k);
+}
+
+constexpr Kernels BASE{Cpu::NivelSimd::Base, somaMascaradaBase, somaPorChaveBase};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+[[gnu::target("sse4.2")]]
+qint64 somaMascaradaSse42(const qint64 *v, const quint8 *t, qsizetype n, quint8 tipo)
+{
+    return somaMascaradaCorpo(v, t, n, tipo);
+}
+
+[[gnu::target("sse4.2")]]
+void somaPorChaveSse42(const qint64 *v, const quint8 *t, const qint32 *c, qsizetype n,
+                       quint8 tipo, qint64 *a, qint32 k)
+{
+    somaPorChaveCorpo(v, t, c, n, tipo, a, k);
+}
+
+[[gnu::target("avx2")]]
+qint64 somaMascaradaAvx2(const qint64 *v, const quint8 *t, qsizetype n, quint8 tipo)
+{
+    return somaMascaradaCorpo(v, t, n, tipo);
+}
+
+[[gnu::target("avx2")]]
+void somaPorChaveAvx2(const qint64 *v, const quint8 *t, const qint32 *c, qsizetype n,
+                      quint8 tipo, qint64 *a, qint32 k)
+{
+    somaPorChaveCorpo(v, t, c, n, tipo, a, k);
+}
+
+[[gnu::target("avx512f,avx512bw,avx512vl")]]
+qint64 somaMascaradaAvx512(const qint64 *v, const quint8 *t, qsizetype n, quint8 tipo)
+{
+    return somaMascaradaCorpo(v, t, n, tipo);
+}
+
+[[gnu::target("avx512f,avx512bw,avx512vl")]]
+void somaPorChaveAvx512(const qint64 *v, const quint8 *t, const qint32 *c, qsizetype n,
+                        quint8 tipo, qint64 *a, qint32 k)
+{
+    somaPorChaveCorpo(v, t, c, n, tipo, a, k);
+}
+
+constexpr Kernels SSE42{Cpu::NivelSimd::Sse42, somaMascaradaSse42, somaPorChaveSse42};
+constexpr Kernels AVX2{Cpu::NivelSimd::Avx2, somaMascaradaAvx2, somaPorChaveAvx2};
+constexpr Kernels AVX512{Cpu::NivelSimd::Avx512, somaMascaradaAvx512, somaPorChaveAvx512};
+
+#endif
+
+const Kernels *kernelsPara(Cpu::NivelSimd nivel)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    switch (qMin(nivel, Cpu::nivelSuportado())) {
+    case Cpu::NivelSimd::Avx512: return &AVX512;
+    case Cpu::NivelSimd::Avx2:   return &AVX2;
+    case Cpu::NivelSimd::Sse42:  return &SSE42;
+    case Cpu::NivelSimd::Base:   break;
+    }
+#else
+    Q_UNUSED(nivel);
+#endif
+    return &BASE;
+}
+
+std::atomic<const Kernels *> s_kernels{nullptr};
+
+const Kernels &kernels()
+{
+    const Kernels *k = s_kernels.load(std::memory_order_acquire);
+    if (!k) {
+        Agregacao::definirNivel(Cpu::nivelSimd());
+        k = s_kernels.load(std::memory_order_acquire);
+    }
+    return *k;
+}
+
+} // namespace
+
+namespace Agregacao {
+
+qint64 somaMascarada(const qint64 *valores, const quint8 *tipos, qsizetype n, quint8 tipo)
+{
+    return kernels().somaMascarada(valores, tipos, n, tipo);
+}
+
+void somaPorChave(const qint64 *valores, const quint8 *tipos, const qint32 *chaves,
+                  qsizetype n, quint8 tipo, qint64 *acumulado, qint32 nChaves)
+{
+    kernels().somaPorChave(valores, tipos, chaves, n, tipo, acumulado, nChaves);
+}
+
+Cpu::NivelSimd nivel()
+{
+    return kernels().nivel;
+}
+
+void definirNivel(Cpu::NivelSimd nivel)
+{
+    s_kernels.store(kernelsPara(nivel), std::memory_order_release);
+}
+
+} // namespace Agregacao
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "utils/Cpu.h"
+
+#include <QtGlobal>
+
+// Kernels de agregação sobre colunas contíguas (CacheAnalitico). Laços sem
+// desvios: o filtro vira uma máscara (0 ou ~0) aplicada com AND, o que o
+// compilador traduz para instruções SIMD — uma variante por Cpu::NivelSimd
+// (SSE4.2, AVX2, AVX-512), escolhida na primeira chamada.
+namespace Agregacao {
+
+// Σ valores[i] para as linhas com tipos[i] == tipo
+qint64 somaMascarada(const qint64 *valores, const quint8 *tipos, qsizetype n, quint8 tipo);
+
+// acumulado[chaves[i]] += valores[i] para as linhas com tipos[i] == tipo;
+// chaves em [0, nChaves). O espalhamento é escalar; a máscara, não.
+void somaPorChave(const qint64 *valores, const quint8 *tipos, const qint32 *chaves,
+                  qsizetype n, quint8 tipo, qint64 *acumulado, qint32 nChaves);
+
+// Variante em uso. definirNivel() troca para outra (limitada ao que o
+// processador suporta) — para benchmarks e testes de equivalência.
+Cpu::NivelSimd nivel();
+void           definirNivel(Cpu::NivelSimd nivel);
+
+} // namespace Agregacao
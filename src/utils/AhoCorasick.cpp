@@ -0,0 +1,88 @@
+#include "utils/AhoCorasick.h"
+
+#include <algorithm>
+
+void AhoCorasick::limpar()
+{
+    m_ascii.fill(0);
+    m_outros.clear();
+    m_largura = 0;
+    m_transicoes.clear();
+    m_inicioSaidas.clear();
+    m_saidas.clear();
+}
+
+void AhoCorasick::construir(const QStringList &padroes)
+{
+    limpar();
+
+    // Alfabeto: só os caracteres que aparecem nos padrões ganham coluna
+    qint32 proximo = 1;
+    for (const QString &p : padroes) {
+        for (const QChar c : p) {
+            const char16_t u = c.unicode();
+            if (simbolo(u) != 0) continue;
+            if (u < m_ascii.size()) m_ascii[u] = proximo++;
+            else m_outros.insert(u, proximo++);
+        }
+    }
+    if (proximo == 1) return;  // nenhum padrão não vazio
+    m_largura = proximo;
+
+    // Trie: -1 = sem filho (preenchido pelos links de falha abaixo)
+    QList<QList<qint32>> saidas(1);
+    m_transicoes.fill(-1, m_largura);
+    for (qsizetype i = 0; i < padroes.size(); ++i) {
+        if (padroes[i].isEmpty()) continue;
+        qint32 estado = 0;
+        for (const QChar c : padroes[i]) {
+            qint32 &filho = m_transicoes[estado * m_largura + simbolo(c.unicode())];
+            if (filho < 0) {
+                filho = qint32(saidas.size());
+                saidas.append({});
+                m_transicoes.resize(m_transicoes.size() + m_largura, -1);
+            }
+            estado = m_transicoes[estado * m_largura + simbolo(c.unicode())];
+        }
+        saidas[estado].append(qint32(i));
+    }
+
+    // BFS: links de falha e DFA completo. Um estado herda as saídas do seu
+    // link de falha (sufixo mais longo que também é prefixo de algum padrão).
+    const qint32 estados = qint32(saidas.size());
+    QList<qint32> falha(estados, 0);
+    QList<qint32> fila;
+    fila.reserve(estados);
+
+    for (qint32 s = 0; s < m_largura; ++s) {
+        qint32 &t = m_transicoes[s];
+        if (t < 0) t = 0;
+        else fila.append(t);
+    }
+    for (qsizetype cabeca = 0; cabeca < fila.size(); ++cabeca) {
+        const qint32 u = fila[cabeca];
+        const QList<qint32> &herdadas = saidas[falha[u]];
+        if (!herdadas.isEmpty()) {
+            saidas[u] += herdadas;
+            std::sort(saidas[u].begin(), saidas[u].end());
+        }
+        for (qint32 s = 0; s < m_largura; ++s) {
+            qint32 &t = m_transicoes[u * m_largura + s];
+            const qint32 viaFalha = m_transicoes[falha[u] * m_largura + s];
+            if (t < 0) {
+                t = viaFalha;
+            } else {
+                falha[t] = viaFalha;
+                fila.append(t);
+            }
+        }
+    }
+
+    // Saídas achatadas (CSR): uma faixa contígua por estado
+    m_inicioSaidas.reserve(estados + 1);
+    for (const QList<qint32> &s : std::as_const(saidas)) {
+        m_inicioSaidas.append(qint32(m_saidas.size()));
+        m_saidas += s;
+    }
+    m_inicioSaidas.append(qint32(m_saidas.size()));
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QStringView>
+#include <QtGlobal>
+
+#include <array>
+
+// Autômato de Aho-Corasick sobre UTF-16: acha todas as ocorrências de um
+// conjunto de padrões em uma única passada pelo texto, O(texto + ocorrências),
+// qualquer que seja o número de padrões. As transições são uma tabela densa
+// (DFA completo) sobre o alfabeto dos próprios padrões — um load por caractere.
+class AhoCorasick
+{
+public:
+    // O padrão na posição i é reportado como i; padrões vazios são ignorados
+    void construir(const QStringList &padroes);
+    void limpar();
+
+    bool vazio() const { return m_largura == 0; }
+
+    // visitar(int i) para cada padrão terminado em cada posição do texto,
+    // em ordem crescente de i dentro da mesma posição
+    template <typename Visitante>
+    void buscar(QStringView texto, Visitante &&visitar) const
+    {
+        if (vazio()) return;
+        qint32 estado = 0;
+        for (const QChar c : texto) {
+            estado = m_transicoes[estado * m_largura + simbolo(c.unicode())];
+            for (qint32 k = m_inicioSaidas[estado]; k < m_inicioSaidas[estado + 1]; ++k)
+                visitar(int(m_saidas[k]));
+        }
+    }
+
+private:
+    // 0 = caractere fora de todos os padrões (volta à raiz)
+    qint32 simbolo(char16_t c) const
+    {
+        return c < m_ascii.size() ? m_ascii[c] : m_outros.value(c, 0);
+    }
+
+    std::array<qint32, 128> m_ascii{};
+    QHash<char16_t, qint32> m_outros;
+    qint32                  m_largura = 0;   // símbolos por estado (alfabeto + 1)
+    QList<qint32>           m_transicoes;    // estado * largura + símbolo → estado
+    QList<qint32>           m_inicioSaidas;  // saídas do estado s: [inicio[s], inicio[s+1])
+    QList<qint32>           m_saidas;
+};
@@ -0,0 +1,52 @@
+#include "utils/BloomFilter.h"
+
+#include <cmath>
+#include <numbers>
+
+void BloomFilter::reservar(qsizetype capacidade)
+{
+    // m = -n·ln(p) / ln(2)²  e  k = (m/n)·ln(2), com p = 0,01
+    constexpr double FALSO_POSITIVO = 0.01;
+    const double n = double(qMax<qsizetype>(capacidade, 1024));
+    const double m = std::ceil(-n * std::log(FALSO_POSITIVO) / (std::numbers::ln2 * std::numbers::ln2));
+
+    m_capacidade = qsizetype(n);
+    m_numBits    = (quint64(m) + 63) & ~quint64(63);
+    m_numHashes  = qBound(1, int(std::lround(m / n * std::numbers::ln2)), 16);
+    m_bits.fill(0, qsizetype(m_numBits / 64));
+    m_elementos  = 0;
+}
+
+void BloomFilter::limpar()
+{
+    m_bits.fill(0);
+    m_elementos = 0;
+}
+
+// Hashing duplo (Kirsch–Mitzenmacher): h_i = h1 + i·h2
+void BloomFilter::adicionar(quint64 hash)
+{
+    if (m_numBits == 0) reservar(0);
+
+    const quint64 h1 = hash;
+    const quint64 h2 = (hash >> 32) | 1;
+    for (int i = 0; i < m_numHashes; ++i) {
+        const quint64 bit = (h1 + quint64(i) * h2) % m_numBits;
+        m_bits[bit >> 6] |= quint64(1) << (bit & 63);
+    }
+    ++m_elementos;
+}
+
+bool BloomFilter::talvezContenha(quint64 hash) const
+{
+    if (m_numBits == 0) return false;
+
+    const quint64 h1 = hash;
+    const quint64 h2 = (hash >> 32) | 1;
+    for (int i = 0; i < m_numHashes; ++i) {
+        const quint64 bit = (h1 + quint64(i) * h2) % m_numBits;
+        if (!(m_bits.at(bit >> 6) & (quint64(1) << (bit & 63))))
+            return false;
+    }
+    return true;
+}
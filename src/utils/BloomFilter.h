@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QList>
+#include <QtGlobal>
+
+// Filtro de Bloom sobre hashes de 64 bits já calculados (sem rehash).
+// Responde "certamente ausente" ou "talvez presente"; não suporta remoção —
+// quem usa confirma o "talvez" na fonte de verdade.
+class BloomFilter
+{
+public:
+    // Dimensiona para ~1% de falsos positivos com `capacidade` elementos
+    void reservar(qsizetype capacidade);
+    void limpar();
+
+    void adicionar(quint64 hash);
+    bool talvezContenha(quint64 hash) const;
+
+    qsizetype elementos()  const { return m_elementos; }
+    qsizetype capacidade() const { return m_capacidade; }
+    bool      saturado()   const { return m_elementos > m_capacidade; }
+
+private:
+    QList<quint64> m_bits;
+    quint64        m_numBits    = 0;
+    int            m_numHashes  = 0;
+    qsizetype      m_elementos  = 0;
+    qsizetype      m_capacidade = 0;
+};
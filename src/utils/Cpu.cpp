@@ -0,0 +1,45 @@
+#include "utils/Cpu.h"
+
+#include <QByteArray>
+
+namespace Cpu {
+
+NivelSimd nivelSuportado()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vl"))
+        return NivelSimd::Avx512;
+    if (__builtin_cpu_supports("avx2"))   return NivelSimd::Avx2;
+    if (__builtin_cpu_supports("sse4.2")) return NivelSimd::Sse42;
+#endif
+    return NivelSimd::Base;
+}
+
+NivelSimd nivelSimd()
+{
+    static const NivelSimd nivel = [] {
+        const NivelSimd suportado = nivelSuportado();
+        const QByteArray pedido = qgetenv("ORCAMENTO_SIMD").toLower();
+        for (NivelSimd n : {NivelSimd::Base, NivelSimd::Sse42, NivelSimd::Avx2, NivelSimd::Avx512}) {
+            if (pedido == nomeNivel(n))
+                return qMin(n, suportado);
+        }
+        return suportado;
+    }();
+    return nivel;
+}
+
+const char *nomeNivel(NivelSimd nivel)
+{
+    switch (nivel) {
+    case NivelSimd::Base:   return "base";
+    case NivelSimd::Sse42:  return "sse4.2";
+    case NivelSimd::Avx2:   return "avx2";
+    case NivelSimd::Avx512: return "avx512";
+    }
+    return "base";
+}
+
+} // namespace Cpu
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Recursos SIMD do processador em tempo de execução. O binário é compilado para
+// x86-64 genérico; os caminhos vetorizados (kernels de Agregacao) têm uma
+// variante por nível e escolhem a maior que o processador suporta. Parse de
+// moeda e hashes são laços seriais, sem variantes (ver docs/architecture.md).
+namespace Cpu {
+
+enum class NivelSimd {
+    Base,    // x86-64 (SSE2) ou outra arquitetura
+    Sse42,
+    Avx2,
+    Avx512   // F + BW + VL
+};
+
+// Maior nível que o processador suporta (cpuid)
+NivelSimd nivelSuportado();
+
+// Nível em uso, decidido uma vez: o suportado, limitado por ORCAMENTO_SIMD
+// (base, sse4.2, avx2, avx512) para comparar variantes na mesma máquina
+NivelSimd nivelSimd();
+
+const char *nomeNivel(NivelSimd nivel);
+
+} // namespace Cpu
@@ -1,24 +1,67 @@
 #include "utils/CurrencyUtils.h"
 
-qint64 textoParaCentavos(const QString &texto)
+#include <cstring>
+
+qint64 textoParaCentavos(QStringView texto)
+{
+    constexpr int MAX_DIGITOS = 18;  // 10^18 - 1 cabe em qint64
+
+    qint64 valor    = 0;
+    int    digitos  = 0;
+    bool   negativo = false;
+
+    for (const QChar qc : texto) {
+        const char16_t c = qc.unicode();
+        if (c >= u'0' && c <= u'9') {
+            if (++digitos > MAX_DIGITOS) return 0;
+            valor = valor * 10 + (c - u'0');
+            continue;
+        }
+        switch (c) {
+        case u'.': case u',': case u'R': case u'$': case u' ': case u'\u00A0':
+            break;
+        case u'-':
+            if (digitos > 0 || negativo) return 0;
+            negativo = true;
+            break;
+        default:
+            return 0;
+        }
+    }
+    return negativo ? -valor : valor;
+}
+
+qsizetype centavosParaTexto(qint64 centavos, char16_t *buf)
 {
-    QString limpo = texto;
-    limpo.remove('.').remove(',').remove('R').remove('$').remove(' ');
-    if (limpo.isEmpty()) return 0;
-    QString str = limpo.rightJustified(3, '0');
-    QString cents = str.right(2);
-    QString reais = str.left(str.length() - 2);
-    if (reais.isEmpty()) reais = "0";
-    return reais.toLongLong() * 100 + cents.toLongLong();
+    // Monta de trás para frente em um buffer local e copia uma vez
+    char16_t tmp[CENTAVOS_TEXTO_MAX];
+    char16_t *const fim = tmp + CENTAVOS_TEXTO_MAX;
+    char16_t *p = fim;
+
+    // Via unsigned: -INT64_MIN não cabe em qint64
+    quint64 v = centavos < 0 ? 0 - quint64(centavos) : quint64(centavos);
+
+    *--p = char16_t(u'0' + v % 10); v /= 10;
+    *--p = char16_t(u'0' + v % 10); v /= 10;
+    *--p = u',';
+    do {
+        *--p = char16_t(u'0' + v % 10);
+        v /= 10;
+    } while (v);
+
+    *--p = u' ';
+    *--p = u'$';
+    *--p = u'R';
+    if (centavos < 0) *--p = u'-';
+
+    const qsizetype n = fim - p;
+    std::memcpy(buf, p, n * sizeof(char16_t));
+    return n;
 }
 
 QString centavosParaTexto(qint64 centavos)
 {
-    if (centavos == 0) return "R$ 0,00";
-    QString str = QString::number(qAbs(centavos));
-    while (str.length() < 3) str.prepend('0');
-    QString reais = str.left(str.length() - 2);
-    QString cents = str.right(2);
-    if (reais.isEmpty()) reais = "0";
-    return (centavos < 0 ? "-R$ " : "R$ ") + reais + "," + cents;
+    char16_t buf[CENTAVOS_TEXTO_MAX];
+    const qsizetype n = centavosParaTexto(centavos, buf);
+    return QString(reinterpret_cast<const QChar *>(buf), n);
 }
@@ -1,7 +1,20 @@
 #pragma once
 
 #include <QString>
+#include <QStringView>
 #include <QtGlobal>
 
-qint64 textoParaCentavos(const QString &texto);
+// Maior texto gerado: "-R$ 92233720368547758,08"
+constexpr qsizetype CENTAVOS_TEXTO_MAX = 24;
+
+// Parse de entrada do usuário em uma única passada, sem alocar.
+// Dígitos são acumulados e os dois últimos são os centavos ("1.234,56" → 123456);
+// '.', ',', "R$" e espaços são ignorados; '-' antes do primeiro dígito nega.
+// Qualquer outro caractere (ou mais de 18 dígitos) → 0.
+qint64 textoParaCentavos(QStringView texto);
+
+// Formata "R$ 1234,56" / "-R$ 0,05" em `buf` (ao menos CENTAVOS_TEXTO_MAX
+// posições) e retorna o número de caracteres escritos — sem alocar
+qsizetype centavosParaTexto(qint64 centavos, char16_t *buf);
+
 QString centavosParaTexto(qint64 centavos);
@@ -0,0 +1,82 @@
+#include "utils/DDSketch.h"
+
+#include <cmath>
+
+static const double GAMA     = (1 + DDSketch::ALFA) / (1 - DDSketch::ALFA);
+static const double LOG_GAMA = std::log(GAMA);
+
+int DDSketch::indice(qint64 valor)
+{
+    return int(std::ceil(std::log(double(valor)) / LOG_GAMA));
+}
+
+// Entre γ^(i−1) e γ^i, o ponto 2γ^i/(γ+1) erra no máximo α para cada lado
+qint64 DDSketch::representante(int indice)
+{
+    return qint64(std::llround(2 * std::pow(GAMA, indice) / (GAMA + 1)));
+}
+
+void DDSketch::adicionar(qint64 valor, qint64 delta)
+{
+    m_contagem += delta;
+    if (valor <= 0) {
+        m_zeros += delta;
+        return;
+    }
+    const int i = indice(valor);
+    qint64 &n = m_baldes[i];
+    n += delta;
+    if (n <= 0) m_baldes.remove(i);  // remoções deixam o mapa só com baldes vivos
+}
+
+void DDSketch::mesclar(const DDSketch &outro)
+{
+    for (auto it = outro.m_baldes.cbegin(); it != outro.m_baldes.cend(); ++it)
+        m_baldes[it.key()] += it.value();
+    m_zeros    += outro.m_zeros;
+    m_contagem += outro.m_contagem;
+}
+
+void DDSketch::limpar()
+{
+    m_baldes.clear();
+    m_zeros    = 0;
+    m_contagem = 0;
+}
+
+qint64 DDSketch::quantil(double q) const
+{
+    if (m_contagem <= 0) return 0;
+
+    // Posto do elemento pedido (0-based), como no quantil "inferior"
+    const qint64 posto = qint64(std::floor(qBound(0.0, q, 1.0) * double(m_contagem - 1)));
+    qint64 acumulado = m_zeros;
+    if (posto < acumulado) return 0;
+    for (auto it = m_baldes.cbegin(); it != m_baldes.cend(); ++it) {
+        acumulado += it.value();
+        if (posto < acumulado) return representante(it.key());
+    }
+    return m_baldes.isEmpty() ? 0 : representante(m_baldes.lastKey());
+}
+
+QDataStream &operator<<(QDataStream &out, const DDSketch &s)
+{
+    out << s.m_zeros << s.m_contagem << qint32(s.m_baldes.size());
+    for (auto it = s.m_baldes.cbegin(); it != s.m_baldes.cend(); ++it)
+        out << it.key() << it.value();
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, DDSketch &s)
+{
+    s.limpar();
+    qint32 baldes = 0;
+    in >> s.m_zeros >> s.m_contagem >> baldes;
+    for (qint32 i = 0; i < baldes && in.status() == QDataStream::Ok; ++i) {
+        qint32 indice = 0;
+        qint64 n      = 0;
+        in >> indice >> n;
+        s.m_baldes.insert(indice, n);
+    }
+    return in;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QDataStream>
+#include <QMap>
+#include <QtGlobal>
+
+// Sketch de quantis com erro relativo garantido (DDSketch): cada valor cai no
+// balde ⌈log_γ v⌉, γ = (1 + α)/(1 − α), e o quantil devolvido fica a no máximo
+// α (1%) do valor exato. Só contadores por balde, então, ao contrário de
+// t-digest ou KLL, remover é exato — decrementar o balde —, o que acompanha
+// edições e remoções de lançamentos. Mesclar é somar baldes. Centavos de
+// R$ 0,01 a R$ 10 milhões ocupam no máximo ~1000 baldes; na prática, dezenas.
+class DDSketch
+{
+public:
+    static constexpr double ALFA = 0.01;
+
+    // delta negativo retira; valores ≤ 0 contam à parte (quantil 0)
+    void adicionar(qint64 valor, qint64 delta = 1);
+    void mesclar(const DDSketch &outro);
+    void limpar();
+
+    // q em [0, 1]; 0 se vazio
+    qint64 quantil(double q) const;
+    qint64 contagem() const { return m_contagem; }
+    bool   vazio() const    { return m_contagem <= 0; }
+
+    friend QDataStream &operator<<(QDataStream &out, const DDSketch &s);
+    friend QDataStream &operator>>(QDataStream &in, DDSketch &s);
+
+private:
+    static int    indice(qint64 valor);
+    static qint64 representante(int indice);  // ponto de erro relativo mínimo do balde
+
+    QMap<qint32, qint64> m_baldes;  // índice → contagem; ordenado para o quantil
+    qint64               m_zeros    = 0;
+    qint64               m_contagem = 0;
+};
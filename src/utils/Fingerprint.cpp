@@ -0,0 +1,88 @@
+#include "utils/Fingerprint.h"
+
+#include <QByteArray>
+#include <QtEndian>
+
+// ── Normalização ──────────────────────────────────────────────────────────────
+
+QString normalizarDescricao(QStringView texto)
+{
+    // NFD separa letra e acento ("ç" → "c" + U+0327); os acentos são descartados
+    const QString decomposto = texto.toString().normalized(QString::NormalizationForm_D);
+
+    QString saida;
+    saida.reserve(decomposto.size());
+    bool espacoPendente = false;
+
+    for (const QChar c : decomposto) {
+        if (c.category() == QChar::Mark_NonSpacing) continue;
+        if (c.isSpace()) {
+            espacoPendente = !saida.isEmpty();
+            continue;
+        }
+        if (espacoPendente) {
+            saida.append(' ');
+            espacoPendente = false;
+        }
+        saida.append(c.toLower());
+    }
+    return saida;
+}
+
+// ── Hash ──────────────────────────────────────────────────────────────────────
+
+// MurmurHash64A: 8 bytes por iteração, sem tabelas; resultado independe da
+// plataforma porque os blocos são montados em little-endian explicitamente
+quint64 hash64(const void *dados, qsizetype tamanho, quint64 seed)
+{
+    constexpr quint64 M = 0xc6a4a7935bd1e995ULL;
+    constexpr int     R = 47;
+
+    const auto *p   = static_cast<const uchar *>(dados);
+    const auto *fim = p + (tamanho & ~qsizetype(7));
+    quint64 h = seed ^ (quint64(tamanho) * M);
+
+    for (; p != fim; p += 8) {
+        quint64 k = qFromLittleEndian<quint64>(p);
+        k *= M;
+        k ^= k >> R;
+        k *= M;
+        h ^= k;
+        h *= M;
+    }
+
+    quint64 resto = 0;
+    switch (tamanho & 7) {
+    case 7: resto ^= quint64(p[6]) << 48; [[fallthrough]];
+    case 6: resto ^= quint64(p[5]) << 40; [[fallthrough]];
+    case 5: resto ^= quint64(p[4]) << 32; [[fallthrough]];
+    case 4: resto ^= quint64(p[3]) << 24; [[fallthrough]];
+    case 3: resto ^= quint64(p[2]) << 16; [[fallthrough]];
+    case 2: resto ^= quint64(p[1]) << 8;  [[fallthrough]];
+    case 1: resto ^= quint64(p[0]);
+            h ^= resto;
+            h *= M;
+    }
+
+    h ^= h >> R;
+    h *= M;
+    h ^= h >> R;
+    return h;
+}
+
+quint64 impressaoDigital(int tipo, const QDate &data, qint64 valorCentavos,
+                         QStringView descricao)
+{
+    const QString norm = normalizarDescricao(descricao);
+
+    // Cabeçalho fixo de 24 bytes + descrição em UTF-16LE
+    QByteArray buf(24 + norm.size() * 2, Qt::Uninitialized);
+    auto *p = reinterpret_cast<uchar *>(buf.data());
+    qToLittleEndian<qint64>(tipo,              p);
+    qToLittleEndian<qint64>(data.toJulianDay(), p + 8);
+    qToLittleEndian<qint64>(valorCentavos,     p + 16);
+    for (qsizetype i = 0; i < norm.size(); ++i)
+        qToLittleEndian<quint16>(norm.at(i).unicode(), p + 24 + i * 2);
+
+    return hash64(buf.constData(), buf.size());
+}
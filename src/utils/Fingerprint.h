@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QDate>
+#include <QString>
+#include <QStringView>
+#include <QtGlobal>
+
+// Normaliza descrições para comparação: minúsculas, sem acentos,
+// espaços colapsados ("  Alimentação  MERCADO" → "alimentacao mercado")
+QString normalizarDescricao(QStringView texto);
+
+// Hash de 64 bits não criptográfico, estável entre execuções e máquinas
+quint64 hash64(const void *dados, qsizetype tamanho, quint64 seed = 0);
+
+// Impressão digital de (tipo, data, valor, descrição normalizada) — persistida
+// em impressoes_digitais para detectar duplicatas na importação de extratos
+quint64 impressaoDigital(int tipo, const QDate &data, qint64 valorCentavos,
+                         QStringView descricao);
@@ -0,0 +1,55 @@
+#include "utils/HistogramaLatencia.h"
+
+#include <bit>
+#include <cmath>
+
+// Valores < SUB têm faixa própria; acima disso, expoente e os SUB_BITS bits
+// seguintes ao mais significativo escolhem a faixa
+int HistogramaLatencia::indice(quint64 ns)
+{
+    if (ns < SUB) return int(ns);
+    const int expoente = std::bit_width(ns) - 1;
+    const int mantissa = int(ns >> (expoente - SUB_BITS)) & (SUB - 1);
+    return SUB + (expoente - SUB_BITS) * SUB + mantissa;
+}
+
+quint64 HistogramaLatencia::pontoMedio(int indice)
+{
+    if (indice < SUB) return quint64(indice);
+    const int expoente = (indice - SUB) / SUB + SUB_BITS;
+    const int mantissa = (indice - SUB) % SUB;
+    const quint64 largura = quint64(1) << (expoente - SUB_BITS);
+    const quint64 inicio  = quint64(SUB + mantissa) * largura;
+    return inicio + largura / 2;
+}
+
+void HistogramaLatencia::registrar(quint64 ns)
+{
+    ++m_faixas[indice(ns)];
+    ++m_contagem;
+}
+
+void HistogramaLatencia::mesclar(const HistogramaLatencia &outro)
+{
+    for (int i = 0; i < FAIXAS; ++i)
+        m_faixas[i] += outro.m_faixas[i];
+    m_contagem += outro.m_contagem;
+}
+
+void HistogramaLatencia::limpar()
+{
+    m_faixas.fill(0);
+    m_contagem = 0;
+}
+
+quint64 HistogramaLatencia::percentil(double p) const
+{
+    if (m_contagem == 0) return 0;
+    const quint64 alvo = qMax<quint64>(1, quint64(std::ceil(qBound(0.0, p, 1.0) * m_contagem)));
+    quint64 acumulado = 0;
+    for (int i = 0; i < FAIXAS; ++i) {
+        acumulado += m_faixas[i];
+        if (acumulado >= alvo) return pontoMedio(i);
+    }
+    return pontoMedio(FAIXAS - 1);
+}
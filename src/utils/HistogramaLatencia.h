@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+
+// Histograma logarítmico de latências em nanossegundos: 4 sub-faixas por
+// potência de 2 (erro relativo ≤ 12,5% no ponto médio), 2 KiB fixos, registro
+// O(1) sem alocação. Suficiente para p50/p99 por statement.
+class HistogramaLatencia
+{
+public:
+    void registrar(quint64 ns);
+    void mesclar(const HistogramaLatencia &outro);
+    void limpar();
+
+    // p em [0, 1]; 0 se vazio
+    quint64 percentil(double p) const;
+    quint64 contagem() const { return m_contagem; }
+
+private:
+    static constexpr int SUB_BITS = 2;
+    static constexpr int SUB      = 1 << SUB_BITS;
+    static constexpr int FAIXAS   = SUB + (64 - SUB_BITS) * SUB;
+
+    static int     indice(quint64 ns);
+    static quint64 pontoMedio(int indice);
+
+    std::array<quint64, FAIXAS> m_faixas{};
+    quint64                     m_contagem = 0;
+};
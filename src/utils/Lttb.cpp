@@ -0,0 +1,47 @@
+#include "utils/Lttb.h"
+
+#include <cmath>
+
+QList<QPointF> reduzirLttb(const QList<QPointF> &pontos, qsizetype limite)
+{
+    const qsizetype n = pontos.size();
+    if (limite < 3 || limite >= n) return pontos;
+
+    QList<QPointF> saida;
+    saida.reserve(limite);
+    saida.append(pontos.first());
+
+    // n - 2 pontos internos em limite - 2 baldes
+    const double largura = double(n - 2) / double(limite - 2);
+    QPointF anterior = pontos.first();
+
+    for (qsizetype b = 0; b < limite - 2; ++b) {
+        const qsizetype inicio = qsizetype(b * largura) + 1;
+        const qsizetype fim    = qsizetype((b + 1) * largura) + 1;
+
+        // Terceiro vértice: média do balde seguinte (no último, o ponto final)
+        const qsizetype proxInicio = fim;
+        const qsizetype proxFim    = qMin(qsizetype((b + 2) * largura) + 1, n);
+        QPointF media;
+        for (qsizetype i = proxInicio; i < proxFim; ++i) media += pontos[i];
+        media = proxFim > proxInicio ? media / double(proxFim - proxInicio) : pontos.last();
+
+        // Área (em dobro) de anterior–candidato–média; o maior triângulo vence
+        double    maiorArea = -1.0;
+        qsizetype escolhido = inicio;
+        for (qsizetype i = inicio; i < fim; ++i) {
+            const QPointF &p = pontos[i];
+            const double area = std::abs((anterior.x() - media.x()) * (p.y() - anterior.y())
+                                         - (anterior.x() - p.x()) * (media.y() - anterior.y()));
+            if (area > maiorArea) {
+                maiorArea = area;
+                escolhido = i;
+            }
+        }
+        anterior = pontos[escolhido];
+        saida.append(anterior);
+    }
+
+    saida.append(pontos.last());
+    return saida;
+}
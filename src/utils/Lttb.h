@@ -0,0 +1,12 @@
+#pragma once
+
+#include <QList>
+#include <QPointF>
+
+// Largest-Triangle-Three-Buckets (Steinarsson, 2013): reduz uma série ordenada
+// por x a `limite` pontos preservando a forma — de cada balde fica o ponto que
+// forma o maior triângulo com o escolhido no balde anterior e a média do
+// seguinte, então picos e vales sobrevivem (média ou amostragem fixa os
+// apagariam). O(n); primeiro e último pontos sempre mantidos. Com limite < 3
+// ou ≥ pontos.size(), devolve a série inteira.
+QList<QPointF> reduzirLttb(const QList<QPointF> &pontos, qsizetype limite);
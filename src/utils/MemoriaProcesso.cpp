@@ -0,0 +1,36 @@
+#include "utils/MemoriaProcesso.h"
+
+#include <QByteArray>
+#include <QFile>
+
+namespace MemoriaProcesso {
+
+static qint64 campoStatus(const char *campo)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) return -1;
+    while (!status.atEnd()) {
+        const QByteArray linha = status.readLine();
+        if (linha.startsWith(campo))  // "VmRSS:	  123456 kB"
+            return linha.mid(qstrlen(campo)).trimmed().split(' ').first().toLongLong();
+    }
+    return -1;
+}
+
+qint64 rssAtualKiB()
+{
+    return campoStatus("VmRSS:");
+}
+
+qint64 rssPicoKiB()
+{
+    return campoStatus("VmHWM:");
+}
+
+bool reiniciarPico()
+{
+    QFile refs("/proc/self/clear_refs");
+    return refs.open(QIODevice::WriteOnly) && refs.write("5") == 1;
+}
+
+} // namespace MemoriaProcesso
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Memória residente do processo, em KiB (Linux: /proc/self/status).
+// -1 onde a informação não está disponível.
+namespace MemoriaProcesso {
+
+qint64 rssAtualKiB();  // VmRSS
+qint64 rssPicoKiB();   // VmHWM: pico desde o início ou desde reiniciarPico()
+
+// Zera o pico (VmHWM volta ao RSS atual) escrevendo "5" em
+// /proc/self/clear_refs (Linux 4.0+); false onde não dá
+bool reiniciarPico();
+
+} // namespace MemoriaProcesso
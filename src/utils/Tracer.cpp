@@ -0,0 +1,154 @@
+#include "utils/Tracer.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QString>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tracer {
+
+namespace {
+
+struct Evento {
+    const char *nome;
+    const char *categoria;
+    const char *argChave;
+    qint64      argValor;
+    qint64      inicioNs;
+    qint64      duracaoNs;
+};
+
+// Um buffer por thread; sobrevive à thread (ex.: exportação) até a gravação
+struct BufferThread {
+    int                 tid;
+    std::vector<Evento> eventos;
+};
+
+struct Estado {
+    QString                                    caminho;
+    std::mutex                                 mutex;  // protege `buffers`
+    std::vector<std::unique_ptr<BufferThread>> buffers;
+    qint64                                     origemNs = 0;
+};
+
+Estado &estado()
+{
+    static Estado e;
+    return e;
+}
+
+qint64 agoraNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+BufferThread &bufferDaThread()
+{
+    thread_local BufferThread *buffer = nullptr;
+    if (!buffer) {
+        Estado &e = estado();
+        std::lock_guard lock(e.mutex);
+        e.buffers.push_back(std::make_unique<BufferThread>());
+        buffer = e.buffers.back().get();
+        buffer->tid = int(e.buffers.size());
+        buffer->eventos.reserve(4096);
+    }
+    return *buffer;
+}
+
+void escreverString(QByteArray &out, const char *s)
+{
+    out += '"';
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') out += '\\';
+        out += *s;
+    }
+    out += '"';
+}
+
+void gravarNaSaida()
+{
+    gravar();
+}
+
+} // namespace
+
+void inicializar()
+{
+    const QByteArray caminho = qgetenv("ORCAMENTO_TRACE");
+    if (caminho.isEmpty()) return;
+
+    Estado &e = estado();  // construído antes do atexit → destruído depois dele
+    e.caminho  = QString::fromLocal8Bit(caminho);
+    e.origemNs = agoraNs();
+    detalhe::ativo.store(true, std::memory_order_relaxed);
+    std::atexit(gravarNaSaida);
+}
+
+void Span::iniciar(const char *nome, const char *categoria)
+{
+    m_nome      = nome;
+    m_categoria = categoria;
+    m_inicioNs  = agoraNs();
+}
+
+void Span::encerrar()
+{
+    const qint64 fim = agoraNs();
+    bufferDaThread().eventos.push_back(
+        {m_nome, m_categoria, m_argChave, m_argValor, m_inicioNs, fim - m_inicioNs});
+}
+
+bool gravar()
+{
+    Estado &e = estado();
+    if (e.caminho.isEmpty()) return false;
+
+    QFile arquivo(e.caminho);
+    if (!arquivo.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Tracer: não foi possível gravar" << e.caminho;
+        return false;
+    }
+
+    std::lock_guard lock(e.mutex);
+    QByteArray out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool primeiro = true;
+    for (const auto &buffer : e.buffers) {
+        for (const Evento &ev : buffer->eventos) {
+            if (!primeiro) out += ",\n";
+            primeiro = false;
+
+            // ts/dur em µs com fração: spans de query costumam ficar abaixo de 1 µs
+            out += "{\"ph\":\"X\",\"pid\":1,\"tid\":" + QByteArray::number(buffer->tid)
+                 + ",\"ts\":" + QByteArray::number((ev.inicioNs - e.origemNs) / 1000.0, 'f', 3)
+                 + ",\"dur\":" + QByteArray::number(ev.duracaoNs / 1000.0, 'f', 3)
+                 + ",\"name\":";
+            escreverString(out, ev.nome);
+            out += ",\"cat\":";
+            escreverString(out, ev.categoria);
+            if (ev.argChave) {
+                out += ",\"args\":{";
+                escreverString(out, ev.argChave);
+                out += ':' + QByteArray::number(ev.argValor) + '}';
+            }
+            out += '}';
+
+            if (out.size() > (1 << 20)) {  // descarrega em blocos de ~1 MiB
+                arquivo.write(out);
+                out.clear();
+            }
+        }
+    }
+    out += "\n]}\n";
+    arquivo.write(out);
+    return true;
+}
+
+} // namespace Tracer
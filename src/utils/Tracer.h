@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+
+// Spans com escopo exportados no formato Trace Event do Chrome (abre em
+// chrome://tracing e ui.perfetto.dev). Desligado, um span custa um load
+// atômico relaxado e um desvio; ligado, dois relógios e um push_back num
+// buffer da própria thread.
+//
+//   ORCAMENTO_TRACE=/tmp/orcamento.json ./orcamento-pessoal
+//
+//   void DatabaseManager::salvarEEncriptar() {
+//       TRACE_SPAN("DatabaseManager::salvarEEncriptar");
+//       ...
+namespace Tracer {
+
+namespace detalhe {
+inline std::atomic<bool> ativo{false};
+}
+
+// Lê ORCAMENTO_TRACE; se definida, liga o tracer e grava o arquivo ao sair
+void inicializar();
+
+inline bool ativo() { return detalhe::ativo.load(std::memory_order_relaxed); }
+
+// Escreve o JSON acumulado até agora (chamado automaticamente no exit)
+bool gravar();
+
+class Span
+{
+public:
+    // nome e categoria precisam ser literais (ou viver até o fim do processo)
+    explicit Span(const char *nome, const char *categoria = "app")
+    {
+        if (ativo()) iniciar(nome, categoria);
+    }
+    ~Span()
+    {
+        if (m_nome) encerrar();
+    }
+
+    // Um argumento numérico exibido no detalhe do evento (bytes, linhas…)
+    void arg(const char *chave, qint64 valor)
+    {
+        m_argChave = chave;
+        m_argValor = valor;
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+private:
+    void iniciar(const char *nome, const char *categoria);
+    void encerrar();
+
+    const char *m_nome      = nullptr;
+    const char *m_categoria = nullptr;
+    const char *m_argChave  = nullptr;
+    qint64      m_argValor  = 0;
+    qint64      m_inicioNs  = 0;
+};
+
+} // namespace Tracer
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b)  TRACE_CONCAT_(a, b)
+#define TRACE_SPAN(...)     Tracer::Span TRACE_CONCAT(_traceSpan, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,235 @@
+#include "BenchAnalitico.h"
+
+#include "utils/Agregacao.h"
+#include "utils/Cpu.h"
+#include "utils/Lttb.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QTest>
+
+static constexpr int LINHAS     = 1000000;
+static constexpr int CATEGORIAS = 40;
+
+static const QDate INICIO(2016, 1, 1);  // dez anos de lançamentos
+static const QDate FIM(2025, 12, 31);
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar o laço
+
+// Referência: filtro e soma linha a linha, com QDate
+static qint64 somaReferencia(const QList<Lancamento> &lista, TipoLancamento tipo,
+                             const QDate &inicio, const QDate &fim)
+{
+    qint64 total = 0;
+    for (const Lancamento &l : lista) {
+        if (l.tipo != tipo) continue;
+        if (inicio.isValid() && l.data < inicio) continue;
+        if (fim.isValid() && l.data > fim) continue;
+        total += l.valorCentavos;
+    }
+    return total;
+}
+
+void BenchAnalitico::initTestCase()
+{
+    QRandomGenerator rng(42);
+    const qint64 dias = INICIO.daysTo(FIM) + 1;
+    m_lancamentos.reserve(LINHAS);
+    m_cache.reservar(LINHAS);
+    for (int i = 0; i < LINHAS; ++i) {
+        Lancamento l;
+        l.id            = i + 1;
+        l.tipo          = TipoLancamento(rng.bounded(3));
+        l.valorCentavos = qint64(rng.bounded(500000));
+        l.data          = INICIO.addDays(qint64(rng.bounded(quint32(dias))));
+        l.categoriaId   = l.tipo == TipoLancamento::Entrada ? 0 : 1 + int(rng.bounded(CATEGORIAS));
+        m_lancamentos.append(l);
+        m_cache.anexar(l.tipo, l.id, l.valorCentavos, qint32(l.data.toJulianDay()), l.categoriaId);
+    }
+    m_cache.concluirCarga();
+}
+
+// ── Testes ────────────────────────────────────────────────────────────────────
+
+void BenchAnalitico::equivalencia()
+{
+    const QDate de(2019, 3, 15), ate(2021, 7, 2);
+    for (int t = 0; t < 3; ++t) {
+        const auto tipo = TipoLancamento(t);
+        QCOMPARE(m_cache.soma(tipo), somaReferencia(m_lancamentos, tipo, {}, {}));
+        QCOMPARE(m_cache.soma(tipo, de, ate), somaReferencia(m_lancamentos, tipo, de, ate));
+        QCOMPARE(m_cache.soma(tipo, de, {}), somaReferencia(m_lancamentos, tipo, de, {}));
+
+        const QList<qint64> meses = m_cache.somaPorMes(tipo, QDate(2020, 11, 20), 14);
+        QDate mes(2020, 11, 1);
+        for (const qint64 total : meses) {
+            QCOMPARE(total, somaReferencia(m_lancamentos, tipo, mes, mes.addMonths(1).addDays(-1)));
+            mes = mes.addMonths(1);
+        }
+
+        const QList<qint64> dias = m_cache.somaPorDia(tipo, de, ate);
+        QCOMPARE(dias.size(), qsizetype(de.daysTo(ate) + 1));
+        for (qsizetype d = 0; d < dias.size(); d += 37) {
+            const QDate dia = de.addDays(d);
+            QCOMPARE(dias[d], somaReferencia(m_lancamentos, tipo, dia, dia));
+        }
+
+        QHash<int, qint64> porCategoria;
+        for (const Lancamento &l : std::as_const(m_lancamentos))
+            if (l.tipo == tipo && l.data >= de && l.data <= ate)
+                porCategoria[l.categoriaId] += l.valorCentavos;
+        QCOMPARE(m_cache.somaPorCategoria(tipo, de, ate), porCategoria);
+    }
+}
+
+void BenchAnalitico::incremental()
+{
+    CacheAnalitico cache = m_cache;
+    const qint64 antes = cache.soma(TipoLancamento::GastoVariavel);
+
+    Lancamento novo;
+    novo.id            = LINHAS + 1;
+    novo.tipo          = TipoLancamento::GastoVariavel;
+    novo.valorCentavos = 12345;
+    novo.data          = QDate(2020, 6, 10);
+    novo.categoriaId   = CATEGORIAS + 1;
+    cache.adicionar(novo);
+    QCOMPARE(cache.tamanho(), m_cache.tamanho() + 1);
+    QCOMPARE(cache.soma(TipoLancamento::GastoVariavel), antes + 12345);
+    QCOMPARE(cache.somaPorCategoria(TipoLancamento::GastoVariavel).value(CATEGORIAS + 1), qint64(12345));
+
+    // Edição = retirar a versão antiga e adicionar a nova
+    const Lancamento &existente = m_lancamentos.first();
+    Lancamento editado = existente;
+    editado.valorCentavos += 100;
+    editado.data           = existente.data.addYears(-1);
+    cache.retirar(existente);
+    cache.adicionar(editado);
+    QCOMPARE(cache.soma(existente.tipo),
+             m_cache.soma(existente.tipo) + 100 + (existente.tipo == novo.tipo ? 12345 : 0));
+
+    cache.retirar(novo);
+    cache.retirar(editado);
+    cache.adicionar(existente);
+    for (int t = 0; t < 3; ++t)
+        QCOMPARE(cache.soma(TipoLancamento(t)), m_cache.soma(TipoLancamento(t)));
+}
+
+// Todas as variantes suportadas dão o mesmo resultado da variante base
+void BenchAnalitico::variantes()
+{
+    const Cpu::NivelSimd emUso = Agregacao::nivel();
+    const QDate de(2018, 1, 1), ate(2018, 12, 31);
+
+    Agregacao::definirNivel(Cpu::NivelSimd::Base);
+    const qint64             soma         = m_cache.soma(TipoLancamento::GastoFixo, de, ate);
+    const QHash<int, qint64> porCategoria = m_cache.somaPorCategoria(TipoLancamento::GastoFixo);
+
+    for (int n = int(Cpu::NivelSimd::Sse42); n <= int(Cpu::nivelSuportado()); ++n) {
+        Agregacao::definirNivel(Cpu::NivelSimd(n));
+        QCOMPARE(int(Agregacao::nivel()), n);
+        QCOMPARE(m_cache.soma(TipoLancamento::GastoFixo, de, ate), soma);
+        QCOMPARE(m_cache.somaPorCategoria(TipoLancamento::GastoFixo), porCategoria);
+    }
+    Agregacao::definirNivel(emUso);
+}
+
+// Tamanho pedido, extremos mantidos e o pico isolado preservado
+void BenchAnalitico::lttb()
+{
+    QList<QPointF> serie;
+    for (int i = 0; i < 10000; ++i)
+        serie.append({qreal(i), i == 6543 ? 1000.0 : qreal(i % 7)});
+
+    const QList<QPointF> reduzida = reduzirLttb(serie, 500);
+    QCOMPARE(reduzida.size(), qsizetype(500));
+    QCOMPARE(reduzida.first(), serie.first());
+    QCOMPARE(reduzida.last(), serie.last());
+    QVERIFY(reduzida.contains(serie[6543]));
+    for (qsizetype i = 1; i < reduzida.size(); ++i)
+        QVERIFY(reduzida[i].x() > reduzida[i - 1].x());
+
+    QCOMPARE(reduzirLttb(serie, 20000).size(), serie.size());
+}
+
+void BenchAnalitico::soma()
+{
+    QBENCHMARK {
+        s_sumidouro = m_cache.soma(TipoLancamento::GastoVariavel);
+    }
+}
+
+void BenchAnalitico::somaLinear()
+{
+    QBENCHMARK {
+        s_sumidouro = somaReferencia(m_lancamentos, TipoLancamento::GastoVariavel, {}, {});
+    }
+}
+
+void BenchAnalitico::somaVariante_data()
+{
+    QTest::addColumn<int>("nivel");
+    for (int n = int(Cpu::NivelSimd::Base); n <= int(Cpu::nivelSuportado()); ++n)
+        QTest::newRow(Cpu::nomeNivel(Cpu::NivelSimd(n))) << n;
+}
+
+void BenchAnalitico::somaVariante()
+{
+    QFETCH(int, nivel);
+    const Cpu::NivelSimd emUso = Agregacao::nivel();
+    Agregacao::definirNivel(Cpu::NivelSimd(nivel));
+
+    QBENCHMARK {
+        s_sumidouro = m_cache.soma(TipoLancamento::GastoVariavel);
+    }
+    Agregacao::definirNivel(emUso);
+}
+
+void BenchAnalitico::somaPorMes()
+{
+    QBENCHMARK {
+        s_sumidouro = m_cache.somaPorMes(TipoLancamento::GastoVariavel, INICIO, 120).last();
+    }
+}
+
+void BenchAnalitico::somaPorCategoria()
+{
+    QBENCHMARK {
+        s_sumidouro = m_cache.somaPorCategoria(TipoLancamento::GastoVariavel).size();
+    }
+}
+
+// Gráfico de tendência sem zoom: dez anos de baldes diários de entradas e
+// gastos, reduzidos a 1000 px
+void BenchAnalitico::serieDiaria()
+{
+    QBENCHMARK {
+        for (int t = 0; t < 3; ++t) {
+            const QList<qint64> dias = m_cache.somaPorDia(TipoLancamento(t), INICIO, FIM);
+            QList<QPointF> pontos;
+            pontos.reserve(dias.size());
+            for (qsizetype i = 0; i < dias.size(); ++i) pontos.append({qreal(i), dias[i] / 100.0});
+            s_sumidouro = reduzirLttb(pontos, 1000).size();
+        }
+    }
+}
+
+// Meta do Dashboard: os três totais, 12 meses e o corte por categoria sobre 1M
+// de linhas em poucos milissegundos (falha só com ORCAMENTO_BENCH_METAS=1).
+// Só os kernels foram medidos fora daqui (~5 ms, docs/architecture.md); os
+// 20 ms deste teste nunca foram confirmados.
+void BenchAnalitico::meta1M()
+{
+    QElapsedTimer t;
+    t.start();
+    for (int tipo = 0; tipo < 3; ++tipo)
+        s_sumidouro = m_cache.soma(TipoLancamento(tipo));
+    s_sumidouro = m_cache.somaPorMes(TipoLancamento::GastoVariavel, QDate(2025, 1, 1), 12).size();
+    s_sumidouro = m_cache.somaPorCategoria(TipoLancamento::GastoVariavel).size();
+    const qint64 ms = t.elapsed();
+
+    qInfo("dashboard: %d linhas em %lld ms", LINHAS, ms);
+    if (!qEnvironmentVariableIsSet("ORCAMENTO_BENCH_METAS")) return;
+    QVERIFY2(ms < 20, "agregações do Dashboard sobre 1M de linhas acima de 20 ms");
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/CacheAnalitico.h"
+#include "models/Lancamento.h"
+
+#include <QList>
+#include <QObject>
+
+// CacheAnalitico: agregações do Dashboard sobre 1M de lançamentos em colunas,
+// contra a mesma conta linha a linha sobre QList<Lancamento>, e cada variante
+// SIMD dos kernels (Agregacao) que o processador suporta
+class BenchAnalitico : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void equivalencia();
+    void incremental();
+    void variantes();
+    void lttb();
+
+    void soma();
+    void somaLinear();
+    void somaVariante_data();
+    void somaVariante();
+    void somaPorMes();
+    void somaPorCategoria();
+    void serieDiaria();
+
+    void meta1M();
+
+private:
+    QList<Lancamento> m_lancamentos;
+    CacheAnalitico    m_cache;
+};
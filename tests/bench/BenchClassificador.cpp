@@ -0,0 +1,100 @@
+#include "BenchClassificador.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+static constexpr int LINHAS = 100000;
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar o laço
+
+// Cada categoria tem o seu vocabulário; as descrições misturam ruído comum
+static const QList<QStringList> VOCABULARIO = {
+    {"mercado", "supermercado", "atacadao", "hortifruti"},
+    {"posto", "combustivel", "shell", "ipiranga"},
+    {"farmacia", "drogaria", "droga", "raia"},
+    {"uber", "99app", "taxi", "metro"},
+    {"netflix", "spotify", "prime", "disney"},
+    {"restaurante", "ifood", "lanchonete", "pizzaria"},
+};
+static const QStringList RUIDO = {"compra", "cartao", "debito", "pix", "pagamento", "sp", "rj"};
+
+void BenchClassificador::initTestCase()
+{
+    QRandomGenerator rng(7);
+    m_descricoes.reserve(LINHAS);
+    m_categorias.reserve(LINHAS);
+    for (int i = 0; i < LINHAS; ++i) {
+        const int categoria = int(rng.bounded(VOCABULARIO.size()));
+        const QStringList &palavras = VOCABULARIO.at(categoria);
+        m_descricoes.append(QString("%1 %2 %3 %4")
+                                .arg(RUIDO.at(rng.bounded(RUIDO.size())),
+                                     palavras.at(rng.bounded(palavras.size())),
+                                     RUIDO.at(rng.bounded(RUIDO.size())))
+                                .arg(rng.bounded(10000)));
+        m_categorias.append(categoria + 1);
+        m_modelo.aprender(m_descricoes.last(), m_categorias.last(), +1);
+    }
+}
+
+// ── Testes ────────────────────────────────────────────────────────────────────
+
+// Aprender e desaprender o mesmo lançamento devolve o modelo ao estado anterior
+void BenchClassificador::desaprender()
+{
+    ClassificadorBayes modelo;
+    for (int i = 0; i < 1000; ++i) modelo.aprender(m_descricoes[i], m_categorias[i], +1);
+    const auto antes = modelo.prever("COMPRA Drogaria Raia");
+
+    modelo.aprender("Drogaria nova filial", 4, +1);
+    modelo.aprender("Drogaria nova filial", 4, -1);
+    const auto depois = modelo.prever("COMPRA Drogaria Raia");
+
+    QCOMPARE(modelo.documentos(), qint64(1000));
+    QCOMPARE(depois.categoriaId, antes.categoriaId);
+    QVERIFY(qAbs(depois.confianca - antes.confianca) < 1e-12);
+    QCOMPARE(antes.categoriaId, 3);  // farmácia
+    QVERIFY(antes.confianca >= ClassificadorBayes::CONFIANCA_MINIMA);
+}
+
+void BenchClassificador::serializacao()
+{
+    ClassificadorBayes copia;
+    QVERIFY(copia.desserializar(m_modelo.serializar()));
+    QCOMPARE(copia.documentos(), m_modelo.documentos());
+    for (int i = 0; i < LINHAS; i += 997) {
+        const auto a = m_modelo.prever(m_descricoes[i]);
+        const auto b = copia.prever(m_descricoes[i]);
+        QCOMPARE(b.categoriaId, a.categoriaId);
+        QVERIFY(qAbs(b.confianca - a.confianca) < 1e-12);
+    }
+    QVERIFY(!copia.desserializar(QByteArray("lixo")));
+}
+
+// Custo de um inserir*/atualizar* no modelo
+void BenchClassificador::aprender()
+{
+    ClassificadorBayes modelo = m_modelo;
+    int i = 0;
+    QBENCHMARK {
+        modelo.aprender(m_descricoes[i % LINHAS], m_categorias[i % LINHAS], +1);
+        ++i;
+    }
+}
+
+// Uma tecla no histórico
+void BenchClassificador::prever()
+{
+    int i = 0;
+    QBENCHMARK {
+        s_sumidouro = m_modelo.prever(m_descricoes[i++ % LINHAS]).categoriaId;
+    }
+}
+
+// Importação de 100k linhas
+void BenchClassificador::preverLote()
+{
+    QBENCHMARK {
+        for (int i = 0; i < LINHAS; ++i)
+            s_sumidouro = m_modelo.prever(m_descricoes[i]).categoriaId;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "core/ClassificadorBayes.h"
+
+#include <QList>
+#include <QObject>
+#include <QString>
+
+// ClassificadorBayes: treino incremental, previsão por tecla e em lote
+// (importação de 100k linhas) e ida e volta pela serialização
+class BenchClassificador : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void desaprender();
+    void serializacao();
+
+    void aprender();
+    void prever();
+    void preverLote();
+
+private:
+    QList<QString>     m_descricoes;
+    QList<int>         m_categorias;
+    ClassificadorBayes m_modelo;  // treinado com todas as linhas
+};
@@ -0,0 +1,57 @@
+#include "BenchCrypto.h"
+
+#include "core/CryptoHelper.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+static QByteArray bytesAleatorios(qsizetype tamanho)
+{
+    QByteArray dados(tamanho, Qt::Uninitialized);
+    QRandomGenerator gen(42);
+    gen.fillRange(reinterpret_cast<quint32 *>(dados.data()), tamanho / 4);
+    return dados;
+}
+
+static void dadosTamanho()
+{
+    QTest::addColumn<qsizetype>("tamanho");
+    QTest::newRow("64KiB")  << qsizetype(64) * 1024;
+    QTest::newRow("1MiB")   << qsizetype(1024) * 1024;
+    QTest::newRow("16MiB")  << qsizetype(16) * 1024 * 1024;
+    QTest::newRow("64MiB")  << qsizetype(64) * 1024 * 1024;
+}
+
+void BenchCrypto::initTestCase()
+{
+    QVERIFY(CryptoHelper::derivarChaveEIV(CryptoHelper::gerarSalt(), "Senha#Bench1",
+                                          m_chave, m_iv));
+}
+
+void BenchCrypto::derivarChaveEIV()
+{
+    const QByteArray salt = CryptoHelper::gerarSalt();
+    QByteArray chave, iv;
+    QBENCHMARK { CryptoHelper::derivarChaveEIV(salt, "Senha#Bench1", chave, iv); }
+}
+
+void BenchCrypto::encrypt_data() { dadosTamanho(); }
+void BenchCrypto::decrypt_data() { dadosTamanho(); }
+
+void BenchCrypto::encrypt()
+{
+    QFETCH(qsizetype, tamanho);
+    const QByteArray claro = bytesAleatorios(tamanho);
+    QByteArray cifrado;
+    QBENCHMARK { cifrado = CryptoHelper::encrypt(claro, m_chave, m_iv); }
+    QVERIFY(!cifrado.isEmpty());
+}
+
+void BenchCrypto::decrypt()
+{
+    QFETCH(qsizetype, tamanho);
+    const QByteArray cifrado = CryptoHelper::encrypt(bytesAleatorios(tamanho), m_chave, m_iv);
+    QByteArray claro;
+    QBENCHMARK { claro = CryptoHelper::decrypt(cifrado, m_chave, m_iv); }
+    QCOMPARE(claro.size(), tamanho);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+
+// CryptoHelper: PBKDF2 (custo fixo por login/salvamento) e AES-256-CBC por
+// tamanho de arquivo
+class BenchCrypto : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void derivarChaveEIV();
+
+    void encrypt_data();
+    void encrypt();
+    void decrypt_data();
+    void decrypt();
+
+private:
+    QByteArray m_chave;
+    QByteArray m_iv;
+};
@@ -0,0 +1,147 @@
+#include "BenchCurrency.h"
+
+#include "utils/CurrencyUtils.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+
+#include <limits>
+
+// ── Implementação anterior (referência) ───────────────────────────────────────
+
+static qint64 legadoTextoParaCentavos(const QString &texto)
+{
+    QString limpo = texto;
+    limpo.remove('.').remove(',').remove('R').remove('$').remove(' ');
+    if (limpo.isEmpty()) return 0;
+    QString str = limpo.rightJustified(3, '0');
+    QString cents = str.right(2);
+    QString reais = str.left(str.length() - 2);
+    if (reais.isEmpty()) reais = "0";
+    return reais.toLongLong() * 100 + cents.toLongLong();
+}
+
+static QString legadoCentavosParaTexto(qint64 centavos)
+{
+    if (centavos == 0) return "R$ 0,00";
+    QString str = QString::number(qAbs(centavos));
+    while (str.length() < 3) str.prepend('0');
+    QString reais = str.left(str.length() - 2);
+    QString cents = str.right(2);
+    if (reais.isEmpty()) reais = "0";
+    return (centavos < 0 ? "-R$ " : "R$ ") + reais + "," + cents;
+}
+
+// ── Dados ─────────────────────────────────────────────────────────────────────
+
+static const QStringList TEXTOS = {
+    "R$ 0,00", "R$ 12,34", "R$ 1.234,56", "1234567,89", "R$ 98.765.432,10", "7"
+};
+
+static const QList<qint64> VALORES = {
+    0, 5, 1234, 123456, -98765, 9876543210LL
+};
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar o laço
+
+static void dadosTexto()
+{
+    QTest::addColumn<QString>("texto");
+    for (const QString &t : TEXTOS)
+        QTest::newRow(qPrintable(t)) << t;
+}
+
+static void dadosValor()
+{
+    QTest::addColumn<qint64>("valor");
+    for (qint64 v : VALORES)
+        QTest::newRow(qPrintable(QString::number(v))) << v;
+}
+
+// ── Testes ────────────────────────────────────────────────────────────────────
+
+void BenchCurrency::equivalencia()
+{
+    for (const QString &t : TEXTOS)
+        QCOMPARE(textoParaCentavos(t), legadoTextoParaCentavos(t));
+    for (qint64 v : VALORES)
+        QCOMPARE(centavosParaTexto(v), legadoCentavosParaTexto(v));
+
+    // Casos em que o comportamento mudou de propósito
+    QCOMPARE(textoParaCentavos(u"-0,50"), qint64(-50));
+    QCOMPARE(textoParaCentavos(u"12a34"), qint64(0));
+    QCOMPARE(centavosParaTexto(std::numeric_limits<qint64>::min()),
+             QString("-R$ 92233720368547758,08"));
+}
+
+void BenchCurrency::parse_data()       { dadosTexto(); }
+void BenchCurrency::parseLegado_data() { dadosTexto(); }
+
+void BenchCurrency::parse()
+{
+    QFETCH(QString, texto);
+    QBENCHMARK { s_sumidouro = textoParaCentavos(texto); }
+}
+
+void BenchCurrency::parseLegado()
+{
+    QFETCH(QString, texto);
+    QBENCHMARK { s_sumidouro = legadoTextoParaCentavos(texto); }
+}
+
+void BenchCurrency::formatar_data()       { dadosValor(); }
+void BenchCurrency::formatarBuffer_data() { dadosValor(); }
+void BenchCurrency::formatarLegado_data() { dadosValor(); }
+
+void BenchCurrency::formatar()
+{
+    QFETCH(qint64, valor);
+    QBENCHMARK { s_sumidouro = centavosParaTexto(valor).size(); }
+}
+
+void BenchCurrency::formatarBuffer()
+{
+    QFETCH(qint64, valor);
+    char16_t buf[CENTAVOS_TEXTO_MAX];
+    QBENCHMARK { s_sumidouro = centavosParaTexto(valor, buf); }
+}
+
+void BenchCurrency::formatarLegado()
+{
+    QFETCH(qint64, valor);
+    QBENCHMARK { s_sumidouro = legadoCentavosParaTexto(valor).size(); }
+}
+
+// Razão direta legado/atual no mesmo processo, só relatada: não há meta. O
+// ganho vem de não alocar e de uma passada só; o laço é escalar.
+void BenchCurrency::aceleracao()
+{
+    constexpr int ITERACOES = 200000;
+
+    auto medir = [](auto &&fn) {
+        QElapsedTimer t;
+        t.start();
+        for (int i = 0; i < ITERACOES; ++i) fn(i);
+        return double(t.nsecsElapsed()) / ITERACOES;
+    };
+
+    const double parseLegadoNs = medir([](int i) {
+        s_sumidouro = legadoTextoParaCentavos(TEXTOS.at(i % TEXTOS.size()));
+    });
+    const double parseNs = medir([](int i) {
+        s_sumidouro = textoParaCentavos(TEXTOS.at(i % TEXTOS.size()));
+    });
+
+    char16_t buf[CENTAVOS_TEXTO_MAX];
+    const double formatLegadoNs = medir([](int i) {
+        s_sumidouro = legadoCentavosParaTexto(VALORES.at(i % VALORES.size())).size();
+    });
+    const double formatNs = medir([&buf](int i) {
+        s_sumidouro = centavosParaTexto(VALORES.at(i % VALORES.size()), buf);
+    });
+
+    qInfo("textoParaCentavos: %.1f ns → %.1f ns (%.1f×)",
+          parseLegadoNs, parseNs, parseLegadoNs / parseNs);
+    qInfo("centavosParaTexto: %.1f ns → %.1f ns (%.1f×, buffer do chamador)",
+          formatLegadoNs, formatNs, formatLegadoNs / formatNs);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QObject>
+
+// textoParaCentavos / centavosParaTexto — versão atual contra a implementação
+// anterior (remove/rightJustified/toLongLong), copiada aqui como referência
+class BenchCurrency : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void equivalencia();
+
+    void parse_data();
+    void parse();
+    void parseLegado_data();
+    void parseLegado();
+
+    void formatar_data();
+    void formatar();
+    void formatarBuffer_data();
+    void formatarBuffer();
+    void formatarLegado_data();
+    void formatarLegado();
+
+    void aceleracao();
+};
@@ -0,0 +1,203 @@
+#include "BenchDatabase.h"
+
+#include "core/DatabaseManager.h"
+#include "suporte/Fixtures.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+static const QString SENHA = "Senha#Bench1";
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar a chamada
+
+static void dadosLinhas()
+{
+    QTest::addColumn<int>("linhas");
+    QTest::newRow("1k")   << 1000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M")   << 1000000;
+}
+
+void BenchDatabase::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    DatabaseManager::instance().definirDiretorioDados(m_dir.path());
+}
+
+void BenchDatabase::cleanupTestCase()
+{
+    DatabaseManager::instance().desconectar();
+}
+
+// Conecta ao banco de `linhas` gastos; na primeira vez, popula em um único
+// lote pela carga em massa (inserirLancamentos, blocos de BLOCO_CARGA linhas):
+// um prepare por bloco, sem impressão, observador e modelo por linha
+void BenchDatabase::usarBanco(int linhas)
+{
+    if (m_linhasAtuais == linhas) return;
+
+    auto &db = DatabaseManager::instance();
+    db.desconectar();
+    QVERIFY(db.conectar(QString("bench_%1").arg(linhas), SENHA));
+    m_linhasAtuais = linhas;
+
+    if (db.possuiLancamentos()) return;
+    QVERIFY2(Fixtures::carregarGastosVariaveis(db, linhas, 5000, quint32(linhas)),
+             "carga em massa falhou");
+}
+
+void BenchDatabase::inserir_data()          { dadosLinhas(); }
+void BenchDatabase::atualizar_data()        { dadosLinhas(); }
+void BenchDatabase::listar_data()           { dadosLinhas(); }
+void BenchDatabase::total_data()            { dadosLinhas(); }
+void BenchDatabase::listarMes_data()        { dadosLinhas(); }
+void BenchDatabase::totalMes_data()         { dadosLinhas(); }
+void BenchDatabase::gastosPorDia_data()     { dadosLinhas(); }
+void BenchDatabase::consumoOrcamento_data() { dadosLinhas(); }
+void BenchDatabase::salvarEEncriptar_data() { dadosLinhas(); }
+
+// Caminho SQL + índice de duplicatas; o salvamento criptografado fica de fora
+// (adiado pelo lote) e é medido em salvarEEncriptar()
+void BenchDatabase::inserir()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+
+    db.iniciarLote();
+    int i = 0;
+    QBENCHMARK {
+        GastoVariavel g{0, QString("Bench %1").arg(++i), 1234, QDate(2026, 1, 15), categoriaId, {}};
+        db.inserirGastoVariavel(g);
+    }
+    db.cancelarLote();
+}
+
+void BenchDatabase::atualizar()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+    QRandomGenerator gen(7);
+
+    db.iniciarLote();
+    QBENCHMARK {
+        GastoVariavel g{gen.bounded(linhas) + 1, "Atualizado", gen.bounded(100, 50000),
+                        QDate(2026, 1, 15), categoriaId, {}};
+        db.atualizarGastoVariavel(g);
+    }
+    db.cancelarLote();
+}
+
+void BenchDatabase::listar()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    qsizetype n = 0;
+    QBENCHMARK { n = DatabaseManager::instance().listarGastosVariaveis().size(); }
+    QCOMPARE(n, qsizetype(linhas));
+}
+
+void BenchDatabase::total()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    qint64 t = 0;
+    QBENCHMARK { t = DatabaseManager::instance().totalGastosVariaveis(); }
+    QVERIFY(t > 0);
+}
+
+// Um mês dos dez anos gerados: range scan em idx_gastos_variaveis_data, então
+// o custo acompanha as linhas do mês, não as do banco
+void BenchDatabase::listarMes()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    const Periodo mes = Periodo::mes(QDate(2020, 6, 1));
+    QBENCHMARK { s_sumidouro = DatabaseManager::instance().listarGastosVariaveis(mes).size(); }
+}
+
+void BenchDatabase::totalMes()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    const Periodo mes = Periodo::mes(QDate(2020, 6, 1));
+    QBENCHMARK { s_sumidouro = db.totalGastosVariaveis(mes); }
+}
+
+// Um ano do calendário: ≤ 366 linhas de agregado_diario, qualquer que seja o
+// tamanho do banco
+void BenchDatabase::gastosPorDia()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    const Periodo ano = Periodo::ano(QDate(2020, 1, 1));
+    QBENCHMARK { s_sumidouro = db.gastosPorDia(ano).size(); }
+}
+
+// A checagem feita após cada edição inline: duas buscas em hash, qualquer que
+// seja o tamanho do banco
+void BenchDatabase::consumoOrcamento()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    const int   categoriaId = db.listarCategorias().first().id;
+    const QDate dia(2020, 6, 15);
+
+    db.iniciarLote();
+    QVERIFY(db.definirOrcamento(categoriaId, 100000));
+    GastoVariavel g{1, "Editado", 77777, dia, categoriaId, {}};
+    QVERIFY(db.atualizarGastoVariavel(g));
+
+    QBENCHMARK { s_sumidouro = db.consumoOrcamento(categoriaId, dia).gastoCentavos; }
+    db.cancelarLote();
+}
+
+// 50 recorrências expandidas em dez anos: nada gravado por mês, só a regra
+void BenchDatabase::ocorrenciasPendentes()
+{
+    usarBanco(1000);
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+
+    db.iniciarLote();
+    QVERIFY(Fixtures::inserirAssinaturas(db, categoriaId));
+
+    const Periodo dezAnos = Periodo::personalizado(Fixtures::INICIO, Fixtures::FIM);
+    QBENCHMARK { s_sumidouro = db.listarOcorrenciasPendentes(dezAnos).size(); }
+    db.cancelarLote();
+}
+
+// 500 compras parceladas em dez anos: total de um período em forma fechada,
+// sem materializar parcelas
+void BenchDatabase::totalParcelas()
+{
+    usarBanco(1000);
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+
+    db.iniciarLote();
+    QVERIFY(Fixtures::inserirParcelamentos(db, categoriaId) > 0);
+
+    const Periodo tudo = Periodo::personalizado(QDate(2016, 1, 1), QDate(2027, 12, 31));
+    QBENCHMARK { s_sumidouro = db.totalParcelas(tudo); }
+    db.cancelarLote();
+}
+
+// Lote vazio: concluirLote() faz exatamente um salvarEEncriptar()
+// (leitura do .db + PBKDF2 + AES + escrita atômica)
+void BenchDatabase::salvarEEncriptar()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+    QBENCHMARK {
+        db.iniciarLote();
+        QVERIFY(db.concluirLote());
+    }
+}
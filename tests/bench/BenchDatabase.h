@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+// DatabaseManager em bancos de 1k, 100k e 1M gastos variáveis. Cada tamanho é
+// um usuário próprio no diretório temporário; escritas medidas rodam dentro de
+// um lote desfeito ao final, então o tamanho do banco não deriva entre medições.
+class BenchDatabase : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void inserir_data();
+    void inserir();
+    void atualizar_data();
+    void atualizar();
+    void listar_data();
+    void listar();
+    void total_data();
+    void total();
+    void listarMes_data();
+    void listarMes();
+    void totalMes_data();
+    void totalMes();
+    void gastosPorDia_data();
+    void gastosPorDia();
+    void consumoOrcamento_data();
+    void consumoOrcamento();
+    void ocorrenciasPendentes();
+    void totalParcelas();
+    void salvarEEncriptar_data();
+    void salvarEEncriptar();
+
+private:
+    void usarBanco(int linhas);
+
+    QTemporaryDir m_dir;
+    int           m_linhasAtuais = -1;
+};
@@ -0,0 +1,68 @@
+#include "BenchEstatisticas.h"
+
+#include "suporte/Fixtures.h"
+
+#include <QTest>
+
+static constexpr int   LINHAS     = 200000;
+static constexpr int   CATEGORIAS = 12;
+using Fixtures::INICIO;
+using Fixtures::FIM;
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar o laço
+
+void BenchEstatisticas::initTestCase()
+{
+    m_gastos = Fixtures::gastosParaModelos(LINHAS, CATEGORIAS, 11);
+    for (const Lancamento &l : std::as_const(m_gastos)) {
+        m_estatisticas.registrar(l.categoriaId, l.data, l.valorCentavos, +1);
+        m_anomalias.registrar(l.categoriaId, l.descricao, l.valorCentavos, +1);
+    }
+}
+
+// Uma edição: retirar o valor antigo e registrar o novo
+void BenchEstatisticas::registrar()
+{
+    EstatisticasCategoria estatisticas = m_estatisticas;
+    int i = 0;
+    QBENCHMARK {
+        const Lancamento &l = m_gastos[i++ % LINHAS];
+        estatisticas.registrar(l.categoriaId, l.data, l.valorCentavos, -1);
+        estatisticas.registrar(l.categoriaId, l.data, l.valorCentavos + 100, +1);
+    }
+}
+
+void BenchEstatisticas::resumoAno()
+{
+    QBENCHMARK {
+        s_sumidouro = m_estatisticas.resumo(5, QDate(2024, 1, 1), QDate(2024, 12, 31)).p90;
+    }
+}
+
+// Todas as categorias, período inteiro (uma linha da tabela do Dashboard cada)
+void BenchEstatisticas::resumoTudo()
+{
+    QBENCHMARK {
+        for (int c = 1; c <= CATEGORIAS; ++c) {
+            s_sumidouro = m_estatisticas.resumo(c, INICIO, FIM).p99;
+            s_sumidouro = m_estatisticas.resumoMensal(c, INICIO, FIM).mediana;
+        }
+    }
+}
+
+// Uma linha das tabelas de gastos
+void BenchEstatisticas::limiteAtipico()
+{
+    int c = 0;
+    QBENCHMARK { s_sumidouro = m_estatisticas.limiteAtipico(1 + c++ % CATEGORIAS); }
+}
+
+// Um gasto digitado ou importado: normalizar o histórico e duas buscas
+void BenchEstatisticas::avaliarGasto()
+{
+    int i = 0;
+    QBENCHMARK {
+        const Lancamento &l = m_gastos[i++ % LINHAS];
+        s_sumidouro = qint64(m_anomalias.avaliar(l.categoriaId, l.descricao, l.valorCentavos, true).anomalo);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/DetectorAnomalias.h"
+#include "core/EstatisticasCategoria.h"
+#include "models/Lancamento.h"
+
+#include <QList>
+#include <QObject>
+
+// EstatisticasCategoria: custo de registrar um gasto e de resumir uma
+// categoria com 10 anos de meses; DetectorAnomalias: custo de avaliar um
+// gasto. A correção dos dois fica em tests/unit/
+class BenchEstatisticas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void registrar();
+    void resumoAno();
+    void resumoTudo();
+    void limiteAtipico();
+    void avaliarGasto();
+
+private:
+    QList<Lancamento>     m_gastos;
+    EstatisticasCategoria m_estatisticas;  // com todos os gastos
+    DetectorAnomalias     m_anomalias;     // idem
+};
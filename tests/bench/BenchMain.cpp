@@ -0,0 +1,69 @@
+#include "BenchAnalitico.h"
+#include "BenchClassificador.h"
+#include "BenchCrypto.h"
+#include "BenchCurrency.h"
+#include "BenchDatabase.h"
+#include "BenchEstatisticas.h"
+#include "BenchRegras.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QTest>
+
+// Uso: orcamento-bench [--resultados DIR] [opções do QTest]
+// Com --resultados, cada classe grava DIR/<Classe>.csv (formato csv do QTest:
+// "função","linha","métrica",valor,total,iterações) além do relatório em texto.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    QString dirResultados;
+    const int i = args.indexOf("--resultados");
+    if (i > 0 && i + 1 < args.size()) {
+        dirResultados = args.at(i + 1);
+        args.remove(i, 2);
+        QDir().mkpath(dirResultados);
+    }
+
+    auto executar = [&](QObject *bench) {
+        QStringList a = args;
+        if (!dirResultados.isEmpty()) {
+            const QString classe = bench->metaObject()->className();
+            a << "-o" << QDir(dirResultados).filePath(classe + ".csv") + ",csv"
+              << "-o" << "-,txt";
+        }
+        return QTest::qExec(bench, a);
+    };
+
+    int falhas = 0;
+    {
+        BenchCurrency bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchCrypto bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchDatabase bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchRegras bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchClassificador bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchAnalitico bench;
+        falhas += executar(&bench);
+    }
+    {
+        BenchEstatisticas bench;
+        falhas += executar(&bench);
+    }
+    return falhas;
+}
@@ -0,0 +1,158 @@
+#include "BenchRegras.h"
+
+#include "utils/Fingerprint.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QTest>
+
+static constexpr int LINHAS = 100000;
+
+static volatile qint64 s_sumidouro = 0;  // impede o compilador de descartar o laço
+
+// ── Dados ─────────────────────────────────────────────────────────────────────
+
+static const QStringList PALAVRAS = {
+    "mercado", "padaria", "posto", "farmácia", "uber", "ifood", "netflix",
+    "academia", "restaurante", "drogaria", "açougue", "livraria", "cinema"
+};
+
+// `quantidade` regras: 90% Contem, 7% Regex, 3% Faixa — categoria = posição
+static QList<RegraCategoria> gerarRegras(int quantidade)
+{
+    QRandomGenerator rng(2026);
+    QList<RegraCategoria> regras;
+    for (int i = 0; i < quantidade; ++i) {
+        RegraCategoria r;
+        r.id          = i + 1;
+        r.categoriaId = i + 1;
+        const int sorteio = int(rng.bounded(100));
+        if (sorteio < 90) {
+            r.tipo   = RegraCategoria::Tipo::Contem;
+            r.padrao = i < PALAVRAS.size() ? PALAVRAS.at(i) : QString("loja %1").arg(i);
+        } else if (sorteio < 97) {
+            r.tipo   = RegraCategoria::Tipo::Regex;
+            r.padrao = QString("^pix .*%1$").arg(i);
+        } else {
+            r.tipo             = RegraCategoria::Tipo::Faixa;
+            r.valorMinCentavos = 100000 + i;
+        }
+        if (rng.bounded(4) == 0) r.valorMaxCentavos = 20000;
+        regras.append(r);
+    }
+    return regras;
+}
+
+// Referência: cada regra testada isoladamente, na ordem
+static int categorizarLinear(const QList<RegraCategoria> &regras,
+                             const QList<QRegularExpression> &expressoes,
+                             const QString &descricao, qint64 valor)
+{
+    const QString texto = normalizarDescricao(descricao);
+    for (qsizetype i = 0; i < regras.size(); ++i) {
+        const RegraCategoria &r = regras[i];
+        if ((r.valorMinCentavos > 0 && valor < r.valorMinCentavos)
+            || (r.valorMaxCentavos > 0 && valor > r.valorMaxCentavos))
+            continue;
+        const bool casa = r.tipo == RegraCategoria::Tipo::Faixa
+                       || (r.tipo == RegraCategoria::Tipo::Contem
+                           && texto.contains(normalizarDescricao(r.padrao)))
+                       || (r.tipo == RegraCategoria::Tipo::Regex && expressoes[i].match(texto).hasMatch());
+        if (casa) return r.categoriaId;
+    }
+    return 0;
+}
+
+static QList<QRegularExpression> compilarLinear(const QList<RegraCategoria> &regras)
+{
+    QList<QRegularExpression> expressoes;
+    for (const RegraCategoria &r : regras)
+        expressoes.append(QRegularExpression(r.padrao, QRegularExpression::CaseInsensitiveOption));
+    return expressoes;
+}
+
+static void dadosRegras()
+{
+    QTest::addColumn<int>("regras");
+    for (int n : {10, 100, 1000})
+        QTest::newRow(qPrintable(QString("%1 regras").arg(n))) << n;
+}
+
+void BenchRegras::initTestCase()
+{
+    QRandomGenerator rng(42);
+    m_descricoes.reserve(LINHAS);
+    m_valores.reserve(LINHAS);
+    for (int i = 0; i < LINHAS; ++i) {
+        const int tipo = int(rng.bounded(4));
+        QString d;
+        if (tipo == 0)      d = "COMPRA CARTAO " + PALAVRAS.at(rng.bounded(PALAVRAS.size())).toUpper();
+        else if (tipo == 1) d = QString("Loja %1 Centro").arg(rng.bounded(1200));
+        else if (tipo == 2) d = QString("PIX Fulano %1").arg(rng.bounded(1200));
+        else                d = QString("Débito automático %1").arg(rng.bounded(99999));
+        m_descricoes.append(d);
+        m_valores.append(qint64(rng.bounded(300000)));
+    }
+}
+
+// ── Testes ────────────────────────────────────────────────────────────────────
+
+void BenchRegras::equivalencia()
+{
+    for (int n : {10, 100, 1000}) {
+        const QList<RegraCategoria> regras = gerarRegras(n);
+        const QList<QRegularExpression> expressoes = compilarLinear(regras);
+        MotorRegras motor;
+        motor.compilar(regras);
+        for (int i = 0; i < LINHAS; i += 97) {
+            QCOMPARE(motor.categorizar(m_descricoes[i], m_valores[i]),
+                     categorizarLinear(regras, expressoes, m_descricoes[i], m_valores[i]));
+        }
+    }
+}
+
+void BenchRegras::categorizar_data()       { dadosRegras(); }
+void BenchRegras::categorizarLinear_data() { dadosRegras(); }
+
+void BenchRegras::categorizar()
+{
+    QFETCH(int, regras);
+    MotorRegras motor;
+    motor.compilar(gerarRegras(regras));
+
+    QBENCHMARK {
+        for (int i = 0; i < LINHAS; ++i)
+            s_sumidouro = motor.categorizar(m_descricoes[i], m_valores[i]);
+    }
+}
+
+void BenchRegras::categorizarLinear()
+{
+    QFETCH(int, regras);
+    const QList<RegraCategoria> lista = gerarRegras(regras);
+    const QList<QRegularExpression> expressoes = compilarLinear(lista);
+
+    QBENCHMARK {
+        for (int i = 0; i < LINHAS; ++i)
+            s_sumidouro = categorizarLinear(lista, expressoes, m_descricoes[i], m_valores[i]);
+    }
+}
+
+// Meta do importador: 100k linhas com 1000 regras bem abaixo de 1 s. Só
+// relatada; exigida com ORCAMENTO_BENCH_METAS=1
+void BenchRegras::meta100k()
+{
+    MotorRegras motor;
+    motor.compilar(gerarRegras(1000));
+
+    QElapsedTimer t;
+    t.start();
+    for (int i = 0; i < LINHAS; ++i)
+        s_sumidouro = motor.categorizar(m_descricoes[i], m_valores[i]);
+    const qint64 ms = t.elapsed();
+
+    qInfo("categorizar: %d linhas, 1000 regras em %lld ms", LINHAS, ms);
+    if (!qEnvironmentVariableIsSet("ORCAMENTO_BENCH_METAS")) return;
+    QVERIFY2(ms < 500, "categorização de 100k linhas acima de 500 ms");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/MotorRegras.h"
+
+#include <QList>
+#include <QObject>
+#include <QString>
+
+// MotorRegras (Aho-Corasick + alternação de regex) contra a avaliação regra a
+// regra, em 100k descrições de extrato
+class BenchRegras : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void equivalencia();
+
+    void categorizar_data();
+    void categorizar();
+    void categorizarLinear_data();
+    void categorizarLinear();
+
+    void meta100k();
+
+private:
+    QList<QString> m_descricoes;
+    QList<qint64>  m_valores;
+};
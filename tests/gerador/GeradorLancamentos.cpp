@@ -0,0 +1,266 @@
+#include "GeradorLancamentos.h"
+
+#include "suporte/Fixtures.h"
+
+#include <QtMath>
+
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+// ── Tabelas do perfil ─────────────────────────────────────────────────────────
+
+namespace {
+
+struct ContaFixa {
+    const char *descricao;
+    const char *categoria;
+    int         dia;
+    double      valor;        // reais, no primeiro ano
+    double      variacao;     // desvio relativo mês a mês (0 = valor fixo)
+    double      verao;        // acréscimo relativo em dez–mar (negativo = inverno)
+    double      probabilidade; // chance de o perfil ter a conta
+};
+
+const ContaFixa CONTAS_FIXAS[] = {
+    {"Aluguel",            "Aluguel/Moradia",       10, 1850.00, 0.00,  0.00, 0.80},
+    {"Condomínio",         "Aluguel/Moradia",       10,  480.00, 0.04,  0.00, 0.70},
+    {"IPTU",               "Aluguel/Moradia",       15,  145.00, 0.00,  0.00, 0.50},
+    {"Internet fibra",     "Internet",              15,  119.90, 0.00,  0.00, 0.95},
+    {"Conta de luz",       "Luz/Água/Gás",          20,  175.00, 0.18,  0.35, 1.00},
+    {"Conta de água",      "Luz/Água/Gás",          22,   88.00, 0.12,  0.15, 0.90},
+    {"Gás encanado",       "Luz/Água/Gás",          18,   62.00, 0.20, -0.30, 0.45},
+    {"Plano de saúde",     "Saúde",                  5,  430.00, 0.00,  0.00, 0.65},
+    {"Netflix",            "Streaming/TV/Telefone", 12,   39.90, 0.00,  0.00, 0.70},
+    {"Spotify",            "Streaming/TV/Telefone", 12,   21.90, 0.00,  0.00, 0.60},
+    {"Celular pós-pago",   "Streaming/TV/Telefone",  8,   69.90, 0.00,  0.00, 0.90},
+    {"Academia",           "Academia",               7,   99.90, 0.00,  0.00, 0.50},
+    {"Curso de inglês",    "Educação",               8,  320.00, 0.00,  0.00, 0.30},
+    {"Mensalidade escolar","Educação",               5, 1250.00, 0.00,  0.00, 0.25},
+    {"Seguro do carro",    "Transporte",            25,  210.00, 0.00,  0.00, 0.40},
+};
+
+struct CategoriaVariavel {
+    const char       *categoria;
+    double            peso;
+    double            mediana;  // reais
+    double            sigma;    // log-normal
+    QList<const char *> estabelecimentos;  // do mais ao menos frequente (Zipf)
+};
+
+const QList<CategoriaVariavel> CATEGORIAS_VARIAVEIS = {
+    {"Alimentação", 38, 42.0, 0.85, {
+        "Supermercado Extra", "iFood", "Padaria Real", "Carrefour", "Pão de Açúcar",
+        "Hortifruti", "Assaí Atacadista", "Restaurante Sabor Caseiro", "Rappi",
+        "Açougue Boi Gordo", "Lanchonete da Esquina", "Feira livre", "Starbucks",
+        "Outback", "Sorveteria Italiana", "Empório Natural"}},
+    {"Transporte", 20, 28.0, 0.75, {
+        "Uber", "99", "Posto Shell", "Posto Ipiranga", "Bilhete Único", "Estacionamento",
+        "Sem Parar", "Posto BR", "Oficina Mecânica", "Lava-rápido"}},
+    {"Saúde", 7, 58.0, 0.90, {
+        "Drogasil", "Droga Raia", "Pague Menos", "Laboratório Fleury", "Consulta médica",
+        "Dentista", "Ótica Carol"}},
+    {"Educação", 4, 75.0, 0.90, {
+        "Amazon Livros", "Livraria Cultura", "Papelaria Kalunga", "Udemy", "Material escolar"}},
+    {"Streaming/TV/Telefone", 3, 29.0, 0.50, {
+        "Recarga celular", "Steam", "App Store", "Google Play", "Aluguel de filme"}},
+    {"Aluguel/Moradia", 5, 110.0, 1.00, {
+        "Leroy Merlin", "Telhanorte", "Lavanderia", "Eletricista", "Encanador", "Tok&Stok"}},
+    {"Outros", 23, 68.0, 1.10, {
+        "Mercado Livre", "Amazon", "Shopee", "Magazine Luiza", "Renner", "Cabeleireiro",
+        "Pet Shop", "Cinemark", "C&A", "Riachuelo", "Presente", "Farmácia de manipulação",
+        "Loterias Caixa", "Doação"}},
+};
+
+const char *const BAIRROS[] = {
+    "Centro", "Vila Mariana", "Pinheiros", "Moema", "Tijuca", "Savassi",
+    "Boa Viagem", "Batel", "Asa Sul", "Meireles"
+};
+
+const char *const OBSERVACOES[] = {
+    "almoço", "jantar", "presente", "reembolsar", "pix", "cartão", "dividido", "urgente"
+};
+
+const char *const CLIENTES_FREELA[] = {
+    "Agência Pixel", "Studio Norte", "Loja da Ana", "Consultoria Prisma", "ONG Raízes"
+};
+
+constexpr double INFLACAO_ANUAL = 0.045;
+constexpr double LANCAMENTOS_FIXOS_MES = 14.0;  // estimativa para o alvo de linhas
+
+} // namespace
+
+// ── Construção ────────────────────────────────────────────────────────────────
+
+GeradorLancamentos::GeradorLancamentos(const Parametros &p,
+                                       const QHash<QString, int> &categorias)
+    : m_p(p), m_categorias(categorias), m_gen(p.semente)
+{
+    m_salario = logNormal(6500.0, 0.35);
+    for (int i = 0; i < int(std::size(CONTAS_FIXAS)); ++i)
+        if (m_gen.generateDouble() < CONTAS_FIXAS[i].probabilidade)
+            m_fixosAtivos.append(i);
+}
+
+int GeradorLancamentos::categoria(const QString &nome) const
+{
+    return m_categorias.value(nome, m_categorias.value("Outros"));
+}
+
+qint64 GeradorLancamentos::centavos(double reais) const
+{
+    return qMax<qint64>(1, qRound64(reais * 100.0));
+}
+
+// Box–Muller sobre generateDouble()
+double GeradorLancamentos::normal()
+{
+    return Fixtures::normal(m_gen);
+}
+
+double GeradorLancamentos::logNormal(double mediana, double sigma)
+{
+    return mediana * std::exp(sigma * normal());
+}
+
+// Knuth para λ pequeno; aproximação normal acima disso (alvos de milhões de linhas)
+int GeradorLancamentos::poisson(double lambda)
+{
+    if (lambda <= 0) return 0;
+    if (lambda > 30) return qMax(0, int(std::lround(lambda + std::sqrt(lambda) * normal())));
+
+    const double limite = std::exp(-lambda);
+    int k = 0;
+    double p = m_gen.generateDouble();
+    while (p > limite) {
+        ++k;
+        p *= m_gen.generateDouble();
+    }
+    return k;
+}
+
+// Mesma compra escrita de jeitos diferentes, como aparece em extratos reais
+QString GeradorLancamentos::variarTexto(const QString &base)
+{
+    const double r = m_gen.generateDouble();
+    if (r < 0.50) return base;
+    if (r < 0.70)
+        return base + " - " + BAIRROS[m_gen.bounded(int(std::size(BAIRROS)))];
+    if (r < 0.85)
+        return base.toUpper() + "*" + QString::number(m_gen.bounded(1000, 10000));
+    return base + " (" + OBSERVACOES[m_gen.bounded(int(std::size(OBSERVACOES)))] + ")";
+}
+
+// ── Geração ───────────────────────────────────────────────────────────────────
+
+qint64 GeradorLancamentos::gerar(const std::function<bool(const QList<Lancamento> &)> &consumidor)
+{
+    m_consumidor = consumidor;
+    m_total = 0;
+    m_bloco.clear();
+    m_bloco.reserve(BLOCO);
+
+    const QDate inicio = QDate(m_p.fim.year() - m_p.anos + 1, 1, 1);
+    const qint64 dias  = inicio.daysTo(m_p.fim) + 1;
+    const int    meses = m_p.anos * 12;
+
+    double lambdaDia = 3.0;
+    if (m_p.linhas > 0)
+        lambdaDia = qMax(0.0, double(m_p.linhas) - meses * LANCAMENTOS_FIXOS_MES) / double(dias);
+
+    for (QDate mes = inicio; mes <= m_p.fim; mes = mes.addMonths(1)) {
+        const double anos = inicio.daysTo(mes) / 365.25;
+        gerarMes(mes, std::pow(1.0 + INFLACAO_ANUAL, anos), lambdaDia);
+        if (m_total < 0) return -1;
+    }
+    return emitir(true) ? m_total : -1;
+}
+
+void GeradorLancamentos::gerarMes(const QDate &primeiroDia, double inflacao, double lambdaDia)
+{
+    const int  ano = primeiroDia.year();
+    const int  mes = primeiroDia.month();
+    const auto dia = [&](int d) { return QDate(ano, mes, qMin(d, primeiroDia.daysInMonth())); };
+
+    // Entradas — salário reajustado em janeiro, não mês a mês
+    const int    anoInicial = m_p.fim.year() - m_p.anos + 1;
+    const double reajuste   = std::pow(1.0 + INFLACAO_ANUAL, ano - anoInicial);
+    m_bloco.append(Lancamento{0, TipoLancamento::Entrada, "Salário", centavos(m_salario * reajuste), dia(5), 0});
+    if (mes == 12)
+        m_bloco.append(Lancamento{0, TipoLancamento::Entrada, "13º salário",
+                        centavos(m_salario * reajuste), dia(20), 0});
+    if (m_gen.generateDouble() < 0.25)
+        m_bloco.append(Lancamento{0, TipoLancamento::Entrada,
+                        QString("Freelance — %1").arg(CLIENTES_FREELA[m_gen.bounded(int(std::size(CLIENTES_FREELA)))]),
+                        centavos(logNormal(1200.0, 0.6) * inflacao), dia(m_gen.bounded(1, 29)), 0});
+    m_bloco.append(Lancamento{0, TipoLancamento::Entrada, "Rendimento CDB",
+                    centavos(logNormal(85.0, 0.3) * inflacao), dia(1), 0});
+
+    // Gastos fixos — valor contratual reajustado no ano; consumo acompanha a inflação
+    const bool verao = mes == 12 || mes <= 3;
+    for (const int i : std::as_const(m_fixosAtivos)) {
+        const ContaFixa &c = CONTAS_FIXAS[i];
+        double valor = c.valor * (c.variacao > 0 ? inflacao : reajuste);
+        if (c.variacao > 0) valor *= qMax(0.3, 1.0 + c.variacao * normal());
+        if (verao) valor *= 1.0 + c.verao;
+        m_bloco.append(Lancamento{0, TipoLancamento::GastoFixo, c.descricao, centavos(valor),
+                        dia(c.dia), categoria(c.categoria)});
+    }
+    if (!emitir(false)) return;
+
+    // Gastos variáveis
+    for (QDate d = primeiroDia; d.month() == mes; d = d.addDays(1)) {
+        if (d > m_p.fim) break;
+        const double peso = d.dayOfWeek() >= 6 ? 1.3 : 0.88;  // média semanal = 1
+        const int n = poisson(lambdaDia * peso);
+        for (int k = 0; k < n; ++k)
+            gerarGastoVariavel(d, inflacao);
+        if (!emitir(false)) return;
+    }
+}
+
+void GeradorLancamentos::gerarGastoVariavel(const QDate &dia, double inflacao)
+{
+    static const double pesoTotal = [] {
+        double t = 0;
+        for (const auto &c : CATEGORIAS_VARIAVEIS) t += c.peso;
+        return t;
+    }();
+
+    double r = m_gen.generateDouble() * pesoTotal;
+    const CategoriaVariavel *cat = &CATEGORIAS_VARIAVEIS.last();
+    for (const auto &c : CATEGORIAS_VARIAVEIS) {
+        if (r < c.peso) { cat = &c; break; }
+        r -= c.peso;
+    }
+
+    // Zipf (s = 1) sobre a lista: o primeiro estabelecimento é o mais frequente
+    const int n = int(cat->estabelecimentos.size());
+    double harmonico = 0;
+    for (int i = 1; i <= n; ++i) harmonico += 1.0 / i;
+    double z = m_gen.generateDouble() * harmonico;
+    int idx = n - 1;
+    for (int i = 0; i < n; ++i) {
+        if (z < 1.0 / (i + 1)) { idx = i; break; }
+        z -= 1.0 / (i + 1);
+    }
+
+    double valor = logNormal(cat->mediana, cat->sigma) * inflacao;
+    if (m_gen.generateDouble() < 0.2) valor = std::floor(valor) + 0.90;  // preço "quebrado"
+
+    m_bloco.append(Lancamento{0, TipoLancamento::GastoVariavel,
+                    variarTexto(QString::fromUtf8(cat->estabelecimentos.at(idx))),
+                    centavos(valor), dia, categoria(cat->categoria)});
+}
+
+bool GeradorLancamentos::emitir(bool final)
+{
+    if (m_bloco.isEmpty() || (!final && m_bloco.size() < BLOCO)) return true;
+    if (!m_consumidor(m_bloco)) {
+        m_total = -1;
+        return false;
+    }
+    m_total += m_bloco.size();
+    m_bloco.clear();
+    return true;
+}
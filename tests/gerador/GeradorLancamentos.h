@@ -0,0 +1,62 @@
+#pragma once
+
+#include "models/Lancamento.h"
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QRandomGenerator>
+#include <QString>
+
+#include <functional>
+
+// Gera um histórico sintético e reproduzível (mesma semente + parâmetros →
+// mesmos lançamentos; QRandomGenerator é determinístico, sem <random>):
+//   - entradas: salário mensal com reajuste anual, 13º, freelas e rendimentos
+//   - gastos fixos: contas recorrentes sorteadas por perfil, com sazonalidade
+//   - gastos variáveis: Poisson por dia (mais no fim de semana), categoria por
+//     peso, estabelecimento por Zipf e valor log-normal corrigido pela inflação
+class GeradorLancamentos
+{
+public:
+    static constexpr qsizetype BLOCO = 50000;
+
+    struct Parametros {
+        quint32 semente = 1;
+        int     anos    = 5;
+        QDate   fim     = QDate(2025, 12, 31);  // fixo: reprodutível entre dias
+        qint64  linhas  = 0;  // alvo aproximado de lançamentos; 0 → ~3 gastos/dia
+    };
+
+    // categorias: nome → id (as padrão do DatabaseManager)
+    GeradorLancamentos(const Parametros &p, const QHash<QString, int> &categorias);
+
+    // Entrega os lançamentos em blocos de ~BLOCO, em ordem cronológica.
+    // O consumidor devolve false para abortar. Retorna o total gerado, ou -1
+    // se abortado.
+    qint64 gerar(const std::function<bool(const QList<Lancamento> &)> &consumidor);
+
+private:
+    void gerarMes(const QDate &primeiroDia, double inflacao, double lambdaDia);
+    void gerarGastoVariavel(const QDate &dia, double inflacao);
+    bool emitir(bool final);
+
+    int     categoria(const QString &nome) const;
+    qint64  centavos(double reais) const;
+    double  normal();
+    double  logNormal(double mediana, double sigma);
+    int     poisson(double lambda);
+    QString variarTexto(const QString &base);
+
+    Parametros          m_p;
+    QHash<QString, int> m_categorias;
+    QRandomGenerator    m_gen;
+
+    // Perfil sorteado uma vez por semente
+    double       m_salario = 0;
+    QList<int>   m_fixosAtivos;
+
+    QList<Lancamento> m_bloco;
+    qint64            m_total = 0;
+    std::function<bool(const QList<Lancamento> &)> m_consumidor;
+};
@@ -0,0 +1,91 @@
+#include "GeradorLancamentos.h"
+
+#include "core/DatabaseManager.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+// Cria data/<slug>.enc com um histórico sintético pelo mesmo caminho do app
+// (DatabaseManager → SQLite → CryptoHelper), em um único lote.
+//
+//   orcamento-gerador --usuario fixture_1m --linhas 1000000 --semente 7
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Gera um banco criptografado com lançamentos sintéticos.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"dados",   "Diretório dos .enc (padrão: ./data).", "dir", "data"},
+        {"usuario", "Nome do usuário (define o arquivo <slug>.enc).", "nome", "fixture"},
+        {"senha",   "Senha do banco.", "senha", "Fixture#2026"},
+        {"anos",    "Anos de histórico até --ate.", "n", "5"},
+        {"ate",     "Último mês gerado (yyyy-MM).", "mes", "2025-12"},
+        {"linhas",  "Total aproximado de lançamentos (0 = ~3 gastos por dia).", "n", "0"},
+        {"semente", "Semente do gerador.", "n", "1"},
+    });
+    parser.process(app);
+
+    GeradorLancamentos::Parametros p;
+    p.semente = parser.value("semente").toUInt();
+    p.anos    = qMax(1, parser.value("anos").toInt());
+    p.linhas  = parser.value("linhas").toLongLong();
+    const QDate mes = QDate::fromString(parser.value("ate") + "-01", "yyyy-MM-dd");
+    if (!mes.isValid()) {
+        err << "--ate inválido: " << parser.value("ate") << Qt::endl;
+        return 2;
+    }
+    p.fim = mes.addMonths(1).addDays(-1);
+
+    auto &db = DatabaseManager::instance();
+    db.definirDiretorioDados(QDir(parser.value("dados")).absolutePath());
+    if (!db.conectar(parser.value("usuario"), parser.value("senha"))) {
+        err << "Não foi possível abrir o banco (senha incorreta?)" << Qt::endl;
+        return 1;
+    }
+    if (db.possuiLancamentos()) {
+        err << "O usuário já tem lançamentos; use outro --usuario." << Qt::endl;
+        db.desconectar();
+        return 1;
+    }
+
+    QHash<QString, int> categorias;
+    for (const Categoria &c : db.listarCategorias())
+        categorias.insert(c.nome, c.id);
+
+    QElapsedTimer cronometro;
+    cronometro.start();
+
+    db.iniciarLote();
+    GeradorLancamentos gerador(p, categorias);
+    const qint64 total = gerador.gerar([&](const QList<Lancamento> &bloco) {
+        return db.inserirLancamentos(bloco);
+    });
+    if (total < 0) {
+        db.cancelarLote();
+        db.desconectar();
+        err << "Falha ao inserir lançamentos" << Qt::endl;
+        return 1;
+    }
+    const qint64 msInsercao = cronometro.restart();
+
+    if (!db.concluirLote()) {
+        err << "Falha ao salvar o banco" << Qt::endl;
+        return 1;
+    }
+    const qint64 msSalvamento = cronometro.elapsed();
+    db.desconectar();
+
+    out << total << " lançamentos (semente " << p.semente << ", "
+        << p.fim.addYears(-p.anos).addDays(1).toString("MM/yyyy") << "–"
+        << p.fim.toString("MM/yyyy") << ")\n"
+        << "  inserção:     " << msInsercao << " ms\n"
+        << "  criptografia: " << msSalvamento << " ms\n";
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "suporte/Fixtures.h"
+
+#include "core/DatabaseManager.h"
+
+#include <QtMath>
+
+#include <cmath>
+
+namespace Fixtures {
+
+static constexpr qsizetype BLOCO_CARGA = 50000;
+
+double normal(QRandomGenerator &gen)
+{
+    const double u1 = 1.0 - gen.generateDouble();  // (0, 1]
+    const double u2 = gen.generateDouble();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+qint64 valorCaudaLonga(QRandomGenerator &gen)
+{
+    return qMax<qint64>(100, qint64(std::exp(std::log(8000.0) + normal(gen))));
+}
+
+QList<Lancamento> gastosParaModelos(int linhas, int categorias, quint32 semente)
+{
+    QRandomGenerator gen(semente);
+    const qint64 dias = INICIO.daysTo(FIM) + 1;
+    QList<Lancamento> gastos;
+    gastos.reserve(linhas);
+    for (int i = 0; i < linhas; ++i) {
+        Lancamento l;
+        l.tipo          = TipoLancamento::GastoVariavel;
+        l.valorCentavos = valorCaudaLonga(gen);
+        l.data          = INICIO.addDays(qint64(gen.bounded(quint32(dias))));
+        l.categoriaId   = 1 + int(gen.bounded(categorias));
+        l.descricao     = QString("Loja %1").arg(gen.bounded(500));
+        gastos.append(l);
+    }
+    return gastos;
+}
+
+bool carregarGastosVariaveis(DatabaseManager &db, int linhas, int historicos, quint32 semente)
+{
+    const QList<Categoria> cats = db.listarCategorias();
+    if (cats.isEmpty()) return false;
+
+    QRandomGenerator gen(semente);
+    const qint64 dias = INICIO.daysTo(FIM) + 1;
+    QList<Lancamento> bloco;
+    bloco.reserve(qMin<qsizetype>(linhas, BLOCO_CARGA));
+    db.iniciarLote();
+    for (int i = 0; i < linhas; ++i) {
+        Lancamento l;
+        l.tipo          = TipoLancamento::GastoVariavel;
+        l.data          = INICIO.addDays(qint64(gen.bounded(quint32(dias))));
+        l.descricao     = QString("Compra %1").arg(gen.bounded(historicos));
+        l.valorCentavos = gen.bounded(100, 50000);
+        l.categoriaId   = cats.at(gen.bounded(cats.size())).id;
+        bloco.append(l);
+        if (bloco.size() == BLOCO_CARGA || i == linhas - 1) {
+            if (!db.inserirLancamentos(bloco)) {
+                db.cancelarLote();
+                return false;
+            }
+            bloco.clear();
+        }
+    }
+    return db.concluirLote();
+}
+
+bool inserirAssinaturas(DatabaseManager &db, int categoriaId)
+{
+    for (int i = 0; i < ASSINATURAS; ++i) {
+        Recorrencia r{0, QString("Assinatura %1").arg(i), 1000 + i, 1 + i % 28, categoriaId,
+                      INICIO, i % 5 == 0 ? QDate(2020, 12, 31) : QDate(), {}};
+        if (!db.inserirRecorrencia(r)) return false;
+    }
+    return true;
+}
+
+qint64 inserirParcelamentos(DatabaseManager &db, int categoriaId)
+{
+    qint64 total = 0;
+    for (int i = 0; i < COMPRAS_PARCELADAS; ++i) {
+        Parcelamento p{0, QString("Compra %1").arg(i), 10007 + 131 * i, 2 + i % 23,
+                       INICIO.addDays(7 * i), categoriaId, {}};
+        if (!db.inserirParcelamento(p)) return -1;
+        total += p.totalCentavos;
+    }
+    return total;
+}
+
+} // namespace Fixtures
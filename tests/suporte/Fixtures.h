@@ -0,0 +1,47 @@
+#pragma once
+
+#include "models/Categoria.h"
+#include "models/Lancamento.h"
+
+#include <QDate>
+#include <QList>
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+class DatabaseManager;
+
+// Dados sintéticos comuns a testes de correção (tests/unit) e benchmarks
+// (tests/bench, tests/ui): o teste confere exatamente o que o benchmark mede.
+// Mesma semente → mesmos dados.
+namespace Fixtures {
+
+// Janela dos fixtures: dez anos completos
+inline const QDate INICIO(2016, 1, 1);
+inline const QDate FIM(2025, 12, 31);
+
+// Normal padrão por Box-Muller; u1 em (0, 1], sem log(0)
+double normal(QRandomGenerator &gen);
+
+// Valor com cauda longa (log-normal em torno de R$ 80), como gastos reais
+qint64 valorCaudaLonga(QRandomGenerator &gen);
+
+// Gastos variáveis em memória para os modelos (EstatisticasCategoria,
+// DetectorAnomalias): categorias 1..categorias, "Loja <n>" com n < 500
+QList<Lancamento> gastosParaModelos(int linhas, int categorias, quint32 semente);
+
+// Popula o banco conectado com `linhas` gastos variáveis entre INICIO e FIM:
+// "Compra <n>" com n < historicos, R$ 1 a R$ 500, categoria sorteada entre as
+// do banco. Um lote, carga em massa em blocos; chamar fora de um lote.
+bool carregarGastosVariaveis(DatabaseManager &db, int linhas, int historicos, quint32 semente);
+
+// 50 assinaturas mensais desde INICIO, dia 1 a 28; uma em cada cinco encerrada
+// no fim de 2020 — entre INICIO e FIM, 40 × 120 + 10 × 60 ocorrências
+constexpr int ASSINATURAS = 50;
+bool inserirAssinaturas(DatabaseManager &db, int categoriaId);
+
+// 500 compras parceladas semanais desde INICIO, de 2 a 24 parcelas (a última
+// vence em 2027). Soma dos totais, ou -1 se alguma gravação falhar.
+constexpr int COMPRAS_PARCELADAS = 500;
+qint64 inserirParcelamentos(DatabaseManager &db, int categoriaId);
+
+} // namespace Fixtures
@@ -0,0 +1,221 @@
+#include "BenchUi.h"
+
+#include "core/DatabaseManager.h"
+#include "gerador/GeradorLancamentos.h"
+#include "ui/DashboardWidget.h"
+#include "ui/EntradasWidget.h"
+#include "ui/GastosFixosWidget.h"
+#include "ui/GastosVariaveisWidget.h"
+#include "ui/MainWindow.h"
+#include "utils/CurrencyUtils.h"
+#include "utils/MemoriaProcesso.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QTest>
+#include <QTextStream>
+
+#include <algorithm>
+#include <functional>
+
+static const QString SENHA = "Senha#Bench1";
+static constexpr int REPETICOES = 5;
+static constexpr int COL_VALOR  = 2;  // igual nas três tabelas de lançamentos
+
+// ── Medição ───────────────────────────────────────────────────────────────────
+
+// Mediana de REPETICOES execuções, em ms; o evento de pintura pendente entra na conta
+static double medianaMs(const std::function<void()> &acao)
+{
+    QList<double> tempos;
+    for (int i = 0; i < REPETICOES; ++i) {
+        QElapsedTimer t;
+        t.start();
+        acao();
+        QCoreApplication::processEvents();
+        tempos.append(t.nsecsElapsed() / 1e6);
+    }
+    std::sort(tempos.begin(), tempos.end());
+    return tempos.at(REPETICOES / 2);
+}
+
+// ── Ciclo de vida ─────────────────────────────────────────────────────────────
+
+BenchUi::BenchUi(const QString &caminhoRelatorio, const QList<int> &tamanhos)
+    : m_caminhoRelatorio(caminhoRelatorio), m_tamanhos(tamanhos)
+{
+}
+
+void BenchUi::initTestCase()
+{
+    QCOMPARE(QGuiApplication::platformName(), QString("offscreen"));
+    QVERIFY(m_dir.isValid());
+    DatabaseManager::instance().definirDiretorioDados(m_dir.path());
+}
+
+void BenchUi::cleanupTestCase()
+{
+    DatabaseManager::instance().desconectar();
+
+    QFile arquivo(m_caminhoRelatorio);
+    QVERIFY2(arquivo.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text),
+             qPrintable(m_caminhoRelatorio));
+    QTextStream out(&arquivo);
+    out << "linhas,widget,metrica,valor\n";
+    for (const Medida &m : std::as_const(m_medidas))
+        out << m.linhas << ',' << m.widget << ',' << m.metrica << ','
+            << QString::number(m.valor, 'f', 3) << '\n';
+    qInfo("Relatório: %s", qPrintable(m_caminhoRelatorio));
+}
+
+void BenchUi::registrar(int linhas, const QString &widget, const QString &metrica, double valor)
+{
+    m_medidas.append({linhas, widget, metrica, valor});
+    qInfo("%7d  %-22s %-14s %10.3f", linhas, qPrintable(widget), qPrintable(metrica), valor);
+}
+
+void BenchUi::dadosTamanhos()
+{
+    QTest::addColumn<int>("linhas");
+    for (const int n : std::as_const(m_tamanhos))
+        QTest::newRow(qPrintable(QString::number(n))) << n;
+}
+
+// Banco de ~`linhas` lançamentos, gerado uma vez por tamanho
+void BenchUi::usarBanco(int linhas)
+{
+    if (m_linhasAtuais == linhas) return;
+
+    auto &db = DatabaseManager::instance();
+    db.desconectar();
+    QVERIFY(db.conectar(QString("ui_%1").arg(linhas), SENHA));
+    m_linhasAtuais = linhas;
+    if (db.possuiLancamentos()) return;
+
+    QHash<QString, int> categorias;
+    for (const Categoria &c : db.listarCategorias())
+        categorias.insert(c.nome, c.id);
+
+    GeradorLancamentos::Parametros p;
+    p.semente = quint32(linhas);
+    p.linhas  = linhas;
+    GeradorLancamentos gerador(p, categorias);
+
+    db.iniciarLote();
+    const qint64 total = gerador.gerar([&](const QList<Lancamento> &bloco) {
+        return db.inserirLancamentos(bloco);
+    });
+    QVERIFY(total > 0);
+    QVERIFY(db.concluirLote());
+}
+
+void BenchUi::carregar_data()   { dadosTamanhos(); }
+void BenchUi::edicao_data()     { dadosTamanhos(); }
+void BenchUi::trocaDeAba_data() { dadosTamanhos(); }
+
+// ── Carga ─────────────────────────────────────────────────────────────────────
+
+// Construção (que já chama carregar()) e recargas; o widget fica visível para
+// que a pintura e o layout das linhas entrem na medida. VmHWM é o pico da vida
+// do processo: zerado antes de cada medida, ou, onde não dá, a variação de
+// VmRSS no lugar do pico.
+template <typename W, typename Recarga>
+void BenchUi::medirCarga(int linhas, const QString &nome, Recarga recarga)
+{
+    const bool   picoZerado = MemoriaProcesso::reiniciarPico();
+    const qint64 rssAntes   = MemoriaProcesso::rssAtualKiB();
+
+    QElapsedTimer t;
+    t.start();
+    W widget;
+    widget.resize(1200, 800);
+    widget.show();
+    QCoreApplication::processEvents();
+    registrar(linhas, nome, "construcao_ms", t.nsecsElapsed() / 1e6);
+
+    registrar(linhas, nome, "carregar_ms", medianaMs([&] { recarga(widget); }));
+    if (picoZerado)
+        registrar(linhas, nome, "pico_rss_kib", double(MemoriaProcesso::rssPicoKiB()));
+    else
+        registrar(linhas, nome, "delta_rss_kib", double(MemoriaProcesso::rssAtualKiB() - rssAntes));
+}
+
+void BenchUi::carregar()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+
+    medirCarga<EntradasWidget>(linhas, "EntradasWidget",
+                               [](EntradasWidget &w) { w.carregar(); });
+    medirCarga<GastosFixosWidget>(linhas, "GastosFixosWidget",
+                                  [](GastosFixosWidget &w) { w.carregar(); });
+    medirCarga<GastosVariaveisWidget>(linhas, "GastosVariaveisWidget",
+                                      [](GastosVariaveisWidget &w) { w.carregar(); });
+    medirCarga<DashboardWidget>(linhas, "DashboardWidget",
+                                [](DashboardWidget &w) { w.atualizar(); });
+}
+
+// ── Edição ────────────────────────────────────────────────────────────────────
+
+// Edita o valor da primeira linha como o usuário faria (itemChanged →
+// onItemChanged → atualizar* → salvarEEncriptar → dadosAlterados → Dashboard)
+template <typename W>
+static double medirEdicao(MainWindow &janela, const std::function<qint64()> &total)
+{
+    auto *widget = janela.findChild<W *>();
+    auto *tabela = widget ? widget->template findChild<QTableWidget *>() : nullptr;
+    if (!tabela || tabela->rowCount() < 2) return -1;
+
+    int i = 0;
+    return medianaMs([&] {
+        const qint64 antes = total();
+        tabela->item(0, COL_VALOR)->setText(centavosParaTexto(10000 + ++i));
+        QVERIFY2(total() != antes, "edição não persistida");
+    });
+}
+
+void BenchUi::edicao()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+    auto &db = DatabaseManager::instance();
+
+    MainWindow janela;
+    janela.show();
+    QCoreApplication::processEvents();
+
+    registrar(linhas, "EntradasWidget", "edicao_ms",
+              medirEdicao<EntradasWidget>(janela, [&] { return db.totalEntradas(); }));
+    registrar(linhas, "GastosFixosWidget", "edicao_ms",
+              medirEdicao<GastosFixosWidget>(janela, [&] { return db.totalGastosFixos(); }));
+    registrar(linhas, "GastosVariaveisWidget", "edicao_ms",
+              medirEdicao<GastosVariaveisWidget>(janela, [&] { return db.totalGastosVariaveis(); }));
+}
+
+// ── Troca de aba ──────────────────────────────────────────────────────────────
+
+void BenchUi::trocaDeAba()
+{
+    QFETCH(int, linhas);
+    usarBanco(linhas);
+
+    MainWindow janela;
+    janela.show();
+    QCoreApplication::processEvents();
+
+    auto *abas = janela.findChild<QTabWidget *>();
+    QVERIFY(abas);
+
+    // Sai de cada aba e volta para ela: ao entrar no Dashboard ele é recalculado
+    for (int idx = 0; idx < abas->count(); ++idx) {
+        const int outra = idx == 0 ? 1 : 0;
+        const double ms = medianaMs([&] {
+            abas->setCurrentIndex(outra);
+            abas->setCurrentIndex(idx);
+        });
+        registrar(linhas, abas->widget(idx)->metaObject()->className(), "troca_aba_ms", ms);
+    }
+}
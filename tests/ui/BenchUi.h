@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+
+// Widgets reais sob QT_QPA_PLATFORM=offscreen, com bancos gerados de tamanho
+// crescente. Mede carregar(), pico de RSS, latência de edição até a gravação
+// do .enc e o tempo de troca de aba; grava tudo em um relatório CSV.
+class BenchUi : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BenchUi(const QString &caminhoRelatorio, const QList<int> &tamanhos);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void carregar_data();
+    void carregar();
+    void edicao_data();
+    void edicao();
+    void trocaDeAba_data();
+    void trocaDeAba();
+
+private:
+    struct Medida {
+        int     linhas;
+        QString widget;
+        QString metrica;
+        double  valor;
+    };
+
+    void dadosTamanhos();
+    void usarBanco(int linhas);
+    template <typename W, typename Recarga>
+    void medirCarga(int linhas, const QString &nome, Recarga recarga);
+    void registrar(int linhas, const QString &widget, const QString &metrica, double valor);
+
+    QString       m_caminhoRelatorio;
+    QList<int>    m_tamanhos;
+    QTemporaryDir m_dir;
+    int           m_linhasAtuais = -1;
+    QList<Medida> m_medidas;
+};
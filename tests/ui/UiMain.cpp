@@ -0,0 +1,29 @@
+#include "BenchUi.h"
+
+#include <QApplication>
+#include <QTest>
+
+// Uso: orcamento-ui-bench [--relatorio ARQUIVO] [--linhas 1000,10000,...] [opções do QTest]
+int main(int argc, char *argv[])
+{
+    // Sem servidor gráfico: widgets reais, pintura em memória
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    auto extrair = [&args](const QString &opcao, const QString &padrao) {
+        const int i = args.indexOf(opcao);
+        if (i <= 0 || i + 1 >= args.size()) return padrao;
+        const QString valor = args.at(i + 1);
+        args.remove(i, 2);
+        return valor;
+    };
+    const QString relatorio = extrair("--relatorio", "relatorio-ui.csv");
+
+    QList<int> tamanhos;
+    for (const QString &n : extrair("--linhas", "1000,10000,50000").split(',', Qt::SkipEmptyParts))
+        tamanhos.append(n.toInt());
+
+    BenchUi bench(relatorio, tamanhos);
+    return QTest::qExec(&bench, args);
+}
@@ -0,0 +1,267 @@
+#include "TesteDatabase.h"
+
+#include "core/DatabaseManager.h"
+#include "suporte/Fixtures.h"
+
+#include <QTest>
+
+static const QString SENHA  = "Senha#Teste1";
+static constexpr int LINHAS = 5000;
+
+void TesteDatabase::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    auto &db = DatabaseManager::instance();
+    db.definirDiretorioDados(m_dir.path());
+    QVERIFY(db.conectar("testes", SENHA));
+    QVERIFY(Fixtures::carregarGastosVariaveis(db, LINHAS, 300, 3));
+}
+
+void TesteDatabase::cleanupTestCase()
+{
+    DatabaseManager::instance().desconectar();
+}
+
+void TesteDatabase::init()
+{
+    DatabaseManager::instance().iniciarLote();
+}
+
+void TesteDatabase::cleanup()
+{
+    DatabaseManager::instance().cancelarLote();
+}
+
+// ── Período ───────────────────────────────────────────────────────────────────
+
+// Range scan por data: só linhas do período, e o total bate com a lista
+void TesteDatabase::totaisPorPeriodo()
+{
+    auto &db = DatabaseManager::instance();
+    const Periodo mes = Periodo::mes(QDate(2020, 6, 1));
+
+    const QList<GastoVariavel> doMes = db.listarGastosVariaveis(mes);
+    QVERIFY(!doMes.isEmpty());
+    qint64 soma = 0;
+    for (const GastoVariavel &g : doMes) {
+        QVERIFY(mes.contem(g.data));
+        soma += g.valorCentavos;
+    }
+    QCOMPARE(db.totalGastosVariaveis(mes), soma);
+
+    // Os doze meses somam o ano, e o ano cabe no total sem período
+    const Periodo ano = Periodo::ano(QDate(2020, 1, 1));
+    qsizetype linhasMeses = 0;
+    qint64    totalMeses  = 0;
+    for (int m = 1; m <= 12; ++m) {
+        const Periodo p = Periodo::mes(QDate(2020, m, 1));
+        linhasMeses += db.listarGastosVariaveis(p).size();
+        totalMeses  += db.totalGastosVariaveis(p);
+    }
+    QCOMPARE(db.listarGastosVariaveis(ano).size(), linhasMeses);
+    QCOMPARE(db.totalGastosVariaveis(ano), totalMeses);
+    QVERIFY(db.totalGastosVariaveis() > totalMeses);
+}
+
+// ── Agregado diário ───────────────────────────────────────────────────────────
+
+// Os triggers mantêm agregado_diario igual às tabelas, também depois de
+// inserir, editar e remover
+void TesteDatabase::gastosPorDia()
+{
+    auto &db = DatabaseManager::instance();
+    const Periodo ano = Periodo::ano(QDate(2020, 1, 1));
+
+    auto conferir = [&] {
+        const QList<GastoDiario> dias = db.gastosPorDia(ano);
+        QVERIFY(dias.size() <= 366);
+        qint64 soma  = 0;
+        int    linhas = 0;
+        for (const GastoDiario &d : dias) {
+            QVERIFY(ano.contem(d.dia));
+            soma   += d.totalCentavos;
+            linhas += d.quantidade;
+        }
+        QCOMPARE(soma, db.totalGastosFixos(ano) + db.totalGastosVariaveis(ano));
+        QCOMPARE(qsizetype(linhas),
+                 db.listarGastosFixos(ano).size() + db.listarGastosVariaveis(ano).size());
+    };
+    conferir();
+    if (QTest::currentTestFailed()) return;
+
+    const int categoriaId = db.listarCategorias().first().id;
+    GastoFixo fixo{0, "Aluguel", 150000, QDate(2020, 3, 10), categoriaId, {}};
+    QVERIFY(db.inserirGastoFixo(fixo));
+
+    const QList<GastoVariavel> doAno = db.listarGastosVariaveis(ano);
+    QVERIFY(doAno.size() >= 2);
+    GastoVariavel editado = doAno.at(0);
+    editado.valorCentavos += 999;
+    editado.data           = QDate(2020, 12, 31);
+    QVERIFY(db.atualizarGastoVariavel(editado));
+    QVERIFY(db.removerGastoVariavel(doAno.at(1).id));
+    conferir();
+}
+
+// ── Orçamentos ────────────────────────────────────────────────────────────────
+
+// O consumo mantido a cada mutação continua igual à soma do mês pelas
+// tabelas; cancelar o lote desfaz também o orçamento definido nele
+void TesteDatabase::consumoOrcamento()
+{
+    auto &db = DatabaseManager::instance();
+    const int   categoriaId = db.listarCategorias().first().id;
+    const QDate dia(2020, 6, 15);
+    const Periodo mes = Periodo::mes(dia);
+
+    auto esperado = [&] {
+        qint64 soma = 0;
+        for (const GastoFixo &f : db.listarGastosFixos(mes))
+            if (f.categoriaId == categoriaId) soma += f.valorCentavos;
+        for (const GastoVariavel &v : db.listarGastosVariaveis(mes))
+            if (v.categoriaId == categoriaId) soma += v.valorCentavos;
+        return soma;
+    };
+
+    QVERIFY(db.definirOrcamento(categoriaId, 100000));
+    QCOMPARE(db.consumoOrcamento(categoriaId, dia).gastoCentavos, esperado());
+
+    GastoVariavel editado{1, "Editado", 77777, dia, categoriaId, {}};
+    QVERIFY(db.atualizarGastoVariavel(editado));
+    GastoFixo fixo{0, "Condomínio", 45000, QDate(2020, 6, 5), categoriaId, {}};
+    QVERIFY(db.inserirGastoFixo(fixo));
+    const ConsumoOrcamento c = db.consumoOrcamento(categoriaId, dia);
+    QCOMPARE(c.gastoCentavos, esperado());
+    QCOMPARE(c.limiteCentavos, qint64(100000));
+
+    QVERIFY(db.removerGastoVariavel(editado.id));
+    QCOMPARE(db.consumoOrcamento(categoriaId, dia).gastoCentavos, esperado());
+
+    db.cancelarLote();
+    QVERIFY(!db.consumoOrcamento(categoriaId, dia).definido());
+    db.iniciarLote();  // cleanup() cancela o seu
+}
+
+// ── Recorrências ──────────────────────────────────────────────────────────────
+
+// Expansão das regras em ocorrências; confirmar e dispensar tiram a ocorrência
+// da lista, e só a confirmada entra nos gastos fixos
+void TesteDatabase::ocorrenciasPendentes()
+{
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+
+    // Dia 31 cai no último dia dos meses curtos
+    const Recorrencia aluguel{0, "Aluguel", 150000, 31, categoriaId, QDate(2024, 1, 1), {}, {}};
+    const QList<QDate> datas = aluguel.datasEntre(QDate(2024, 1, 1), QDate(2024, 4, 30));
+    QCOMPARE(datas, (QList<QDate>{QDate(2024, 1, 31), QDate(2024, 2, 29),
+                                  QDate(2024, 3, 31), QDate(2024, 4, 30)}));
+
+    // 50 assinaturas em dez anos; uma em cada cinco encerrada no fim de 2020
+    QVERIFY(Fixtures::inserirAssinaturas(db, categoriaId));
+
+    const Periodo dezAnos = Periodo::personalizado(Fixtures::INICIO, Fixtures::FIM);
+    const QList<Ocorrencia> pendentes = db.listarOcorrenciasPendentes(dezAnos);
+    QCOMPARE(pendentes.size(), qsizetype(40 * 120 + 10 * 60));
+
+    const qint64 antes = db.totalGastosFixos(dezAnos);
+    GastoFixo gerado;
+    QVERIFY(db.confirmarOcorrencia(pendentes.at(0), gerado));
+    QVERIFY(db.dispensarOcorrencia(pendentes.at(1)));
+    QCOMPARE(db.listarOcorrenciasPendentes(dezAnos).size(), pendentes.size() - 2);
+    QCOMPARE(db.totalGastosFixos(dezAnos), antes + pendentes.at(0).valorCentavos);
+}
+
+// ── Parcelamentos ─────────────────────────────────────────────────────────────
+
+// Soma das parcelas = total (centavos do resto nas primeiras), totais por
+// período em forma fechada e passivo a vencer, com 500 compras em dez anos
+void TesteDatabase::parcelas()
+{
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+
+    // R$ 1.000,00 em 3×: 333,34 + 333,33 + 333,33; dia 31 vira o último dia
+    const Parcelamento tv{0, "TV", 100000, 3, QDate(2024, 1, 31), categoriaId, {}};
+    QCOMPARE(tv.valorParcela(0), qint64(33334));
+    QCOMPARE(tv.valorParcela(2), qint64(33333));
+    QCOMPARE(tv.somaParcelas(0, 2), tv.totalCentavos);
+    QCOMPARE(tv.dataParcela(1), QDate(2024, 2, 29));
+    int de = 0, ate = -1;
+    tv.parcelasEntre(QDate(2024, 2, 1), QDate(2024, 2, 29), de, ate);
+    QCOMPARE(de, 1);
+    QCOMPARE(ate, 1);
+
+    const qint64 total = Fixtures::inserirParcelamentos(db, categoriaId);
+    QVERIFY(total > 0);
+
+    // A última parcela vence em 2027: o período inteiro soma os totais
+    const Periodo tudo = Periodo::personalizado(QDate(2016, 1, 1), QDate(2027, 12, 31));
+    QCOMPARE(db.totalParcelas(tudo), total);
+
+    qint64 listadas = 0;
+    for (const Parcela &p : db.listarParcelas(tudo)) listadas += p.valorCentavos;
+    QCOMPARE(listadas, total);
+
+    // Período + a vencer depois dele = total
+    const QDate corte(2020, 6, 30);
+    QCOMPARE(db.totalParcelas(Periodo::personalizado(QDate(2016, 1, 1), corte))
+                 + db.parcelasAVencer(corte), total);
+}
+
+// As parcelas entram nas mesmas agregações dos gastos variáveis — calendário,
+// cache analítico e orçamentos — também ao encerrar, editar e remover o plano
+void TesteDatabase::parcelasAgregadas()
+{
+    auto &db = DatabaseManager::instance();
+    const int categoriaId = db.listarCategorias().first().id;
+    const Periodo tudo = Periodo::personalizado(QDate(2016, 1, 1), QDate(2027, 12, 31));
+    const QDate   dia(2020, 6, 15);
+
+    auto conferir = [&] {
+        const qint64 gastos = db.totalGastosFixos(tudo) + db.totalGastosVariaveis(tudo)
+                            + db.totalParcelas(tudo);
+        qint64 calendario = 0;
+        for (const GastoDiario &d : db.gastosPorDia(tudo)) calendario += d.totalCentavos;
+        QCOMPARE(calendario, gastos);
+        QCOMPARE(db.analitico().soma(TipoLancamento::GastoFixo, tudo.inicio, tudo.fim)
+                     + db.analitico().soma(TipoLancamento::GastoVariavel, tudo.inicio, tudo.fim),
+                 gastos);
+
+        const Periodo mes = Periodo::mes(dia);
+        qint64 doMes = 0;
+        for (const GastoVariavel &v : db.listarGastosVariaveis(mes))
+            if (v.categoriaId == categoriaId) doMes += v.valorCentavos;
+        for (const Parcela &p : db.listarParcelas(mes))
+            if (p.categoriaId == categoriaId) doMes += p.valorCentavos;
+        QCOMPARE(db.consumoOrcamento(categoriaId, dia).gastoCentavos, doMes);
+    };
+
+    Parcelamento geladeira{0, "Geladeira", 360000, 12, QDate(2020, 1, 15), categoriaId, {}};
+    QVERIFY(db.inserirParcelamento(geladeira));
+    conferir();
+    if (QTest::currentTestFailed()) return;
+
+    // Encerrada depois da 5ª parcela (maio): junho sai, o histórico fica
+    geladeira.vigentes = 5;
+    QVERIFY(db.atualizarParcelamento(geladeira));
+    Parcelamento lido;
+    QVERIFY(db.lerParcelamento(geladeira.id, lido));
+    QCOMPARE(lido.quantidadeVigente(), 5);
+    QCOMPARE(db.totalParcelas(Periodo::mes(dia)), qint64(0));
+    QCOMPARE(db.totalParcelas(tudo), geladeira.somaParcelas(0, 4));
+    conferir();
+    if (QTest::currentTestFailed()) return;
+
+    lido.vigentes      = 0;
+    lido.totalCentavos = 480000;
+    lido.primeiraData  = QDate(2020, 6, 1);
+    QVERIFY(db.atualizarParcelamento(lido));
+    QCOMPARE(db.totalParcelas(tudo), qint64(480000));
+    conferir();
+    if (QTest::currentTestFailed()) return;
+
+    QVERIFY(db.removerParcelamento(lido.id));
+    QCOMPARE(db.totalParcelas(tudo), qint64(0));
+    conferir();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+// DatabaseManager num banco pequeno e fixo (gastos variáveis de 2016 a 2025).
+// Cada função roda dentro de um lote cancelado em cleanup(), então nenhuma vê
+// as escritas de outra.
+class TesteDatabase : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void totaisPorPeriodo();
+    void gastosPorDia();
+    void consumoOrcamento();
+    void ocorrenciasPendentes();
+    void parcelas();
+    void parcelasAgregadas();
+
+private:
+    QTemporaryDir m_dir;
+};
@@ -0,0 +1,170 @@
+#include "TesteEstatisticas.h"
+
+#include "suporte/Fixtures.h"
+#include "utils/DDSketch.h"
+
+#include <QTest>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr int   LINHAS     = 50000;
+static constexpr int   CATEGORIAS = 12;
+using Fixtures::INICIO;
+using Fixtures::FIM;
+
+void TesteEstatisticas::initTestCase()
+{
+    m_gastos = Fixtures::gastosParaModelos(LINHAS, CATEGORIAS, 11);
+    for (const Lancamento &l : std::as_const(m_gastos)) {
+        m_estatisticas.registrar(l.categoriaId, l.data, l.valorCentavos, +1);
+        m_anomalias.registrar(l.categoriaId, l.descricao, l.valorCentavos, +1);
+    }
+}
+
+// Quantil do sketch a no máximo α do valor exato de mesmo posto
+void TesteEstatisticas::precisao()
+{
+    DDSketch sketch;
+    QList<qint64> valores;
+    valores.reserve(m_gastos.size());
+    for (const Lancamento &l : std::as_const(m_gastos)) {
+        sketch.adicionar(l.valorCentavos);
+        valores.append(l.valorCentavos);
+    }
+    std::sort(valores.begin(), valores.end());
+
+    for (const double q : {0.01, 0.25, 0.5, 0.9, 0.99, 0.999}) {
+        const qint64 exato    = valores[qsizetype(std::floor(q * double(valores.size() - 1)))];
+        const double erro     = std::abs(double(sketch.quantil(q) - exato)) / double(exato);
+        QVERIFY2(erro <= DDSketch::ALFA + 0.005,  // + arredondamento para centavos
+                 qPrintable(QString("q=%1 erro=%2").arg(q).arg(erro)));
+    }
+    QCOMPARE(sketch.contagem(), qint64(LINHAS));
+}
+
+// Adicionar e retirar o mesmo valor devolve o sketch ao estado anterior
+void TesteEstatisticas::remocao()
+{
+    DDSketch a, ab;
+    for (int i = 0; i < 1000; ++i) {
+        a.adicionar(m_gastos[i].valorCentavos);
+        ab.adicionar(m_gastos[i].valorCentavos);
+    }
+    for (int i = 1000; i < 2000; ++i) ab.adicionar(m_gastos[i].valorCentavos);
+    for (int i = 1000; i < 2000; ++i) ab.adicionar(m_gastos[i].valorCentavos, -1);
+
+    QByteArray bytesA, bytesAb;
+    QDataStream(&bytesA, QIODevice::WriteOnly)  << a;
+    QDataStream(&bytesAb, QIODevice::WriteOnly) << ab;
+    QCOMPARE(bytesAb, bytesA);
+}
+
+void TesteEstatisticas::mescla()
+{
+    DDSketch a, b, tudo;
+    for (int i = 0; i < 2000; ++i) {
+        (i % 2 ? a : b).adicionar(m_gastos[i].valorCentavos);
+        tudo.adicionar(m_gastos[i].valorCentavos);
+    }
+    a.mesclar(b);
+    for (const double q : {0.5, 0.9, 0.99})
+        QCOMPARE(a.quantil(q), tudo.quantil(q));
+    QCOMPARE(a.contagem(), tudo.contagem());
+}
+
+// Resumo de um ano = sketch montado só com os gastos daquele ano
+void TesteEstatisticas::resumoPorPeriodo()
+{
+    const QDate de(2020, 1, 1), ate(2020, 12, 31);
+    DDSketch ano;
+    QMap<int, qint64> somaMes;
+    for (const Lancamento &l : std::as_const(m_gastos)) {
+        if (l.categoriaId != 3 || l.data < de || l.data > ate) continue;
+        ano.adicionar(l.valorCentavos);
+        somaMes[l.data.month()] += l.valorCentavos;
+    }
+
+    const EstatisticasCategoria::Resumo r = m_estatisticas.resumo(3, de, ate);
+    QCOMPARE(r.quantidade, ano.contagem());
+    QCOMPARE(r.mediana, ano.quantil(0.5));
+    QCOMPARE(r.p99, ano.quantil(0.99));
+
+    QList<qint64> totais = somaMes.values();
+    std::sort(totais.begin(), totais.end());
+    const EstatisticasCategoria::Resumo mensal = m_estatisticas.resumoMensal(3, de, ate);
+    QCOMPARE(mensal.quantidade, qint64(12));
+    QCOMPARE(mensal.mediana, totais[5]);  // posto ⌊0,5 × 11⌋
+    QCOMPARE(m_estatisticas.resumo(99).quantidade, qint64(0));
+}
+
+void TesteEstatisticas::serializacao()
+{
+    EstatisticasCategoria copia;
+    QVERIFY(copia.desserializar(m_estatisticas.serializar()));
+    QCOMPARE(copia.serializar(), m_estatisticas.serializar());
+    QVERIFY(!copia.desserializar("lixo"));
+
+    // Poucos lançamentos: nada é atípico
+    EstatisticasCategoria pouca;
+    for (int i = 0; i < EstatisticasCategoria::AMOSTRA_MINIMA - 1; ++i)
+        pouca.registrar(1, INICIO, 1000 + i, +1);
+    QCOMPARE(pouca.limiteAtipico(1), qint64(0));
+    pouca.registrar(1, INICIO, 5000, +1);
+    QVERIFY(pouca.limiteAtipico(1) > 0);
+}
+
+// Adicionar e retirar valores mantém média e variância de duas passadas
+void TesteEstatisticas::welford()
+{
+    DetectorAnomalias detector;
+    for (int i = 0; i < 2000; ++i) detector.registrar(1, "x", m_gastos[i].valorCentavos, +1);
+    for (int i = 1000; i < 2000; ++i) detector.registrar(1, "x", m_gastos[i].valorCentavos, -1);
+
+    double soma = 0;
+    for (int i = 0; i < 1000; ++i) soma += double(m_gastos[i].valorCentavos);
+    const double media = soma / 1000;
+    double quadrados = 0;
+    for (int i = 0; i < 1000; ++i) quadrados += std::pow(double(m_gastos[i].valorCentavos) - media, 2);
+    const double desvio = std::sqrt(quadrados / 999);
+
+    // Valor a 4 desvios da média: escore ≈ 4 (descontado o próprio valor, não registrado)
+    const qint64 teste = qint64(media + 4 * desvio);
+    const auto a = detector.avaliar(1, "X", teste, false);
+    QVERIFY(a.porHistorico);
+    QCOMPARE(a.amostra, qint64(1000));
+    QVERIFY(std::abs(a.media - media) < 1e-6 * media);
+    QVERIFY(std::abs(a.escore - (double(teste) - media) / desvio) < 1e-6);
+
+    // Já registrado: avaliado como se não estivesse
+    detector.registrar(1, "x", teste, +1);
+    QVERIFY(std::abs(detector.avaliar(1, "x", teste, true).escore - a.escore) < 1e-6);
+}
+
+void TesteEstatisticas::anomalia()
+{
+    DetectorAnomalias detector;
+    for (int i = 0; i < 12; ++i) detector.registrar(1, "Aluguel", 150000, +1);
+    // Reajuste pequeno sobre valores idênticos não dispara (piso do desvio)
+    QVERIFY(!detector.avaliar(1, "aluguel", 157000, false).anomalo);
+    QVERIFY(detector.avaliar(1, "ALUGUEL", 300000, false).anomalo);
+
+    // Códigos de loja e datas não separam o histórico
+    for (int i = 0; i < 5; ++i)
+        detector.registrar(4, QString("PADARIA*%1 %2/10").arg(400 + i).arg(i + 1), 1800, +1);
+    const auto padaria = detector.avaliar(4, "Padaria 0977", 1800, false);
+    QVERIFY(padaria.porHistorico);
+    QCOMPARE(padaria.amostra, qint64(5));
+
+    // Histórico curto demais e categoria abaixo da amostra mínima: sem veredito
+    detector.registrar(2, "Padaria", 1500, +1);
+    QCOMPARE(detector.avaliar(2, "Padaria", 900000, false).amostra, qint64(0));
+
+    DetectorAnomalias copia;
+    QVERIFY(copia.desserializar(m_anomalias.serializar()));
+    const auto original = m_anomalias.avaliar(3, "Loja 7", 50000, false);
+    const auto lida     = copia.avaliar(3, "Loja 7", 50000, false);
+    QCOMPARE(lida.amostra, original.amostra);
+    QCOMPARE(lida.escore, original.escore);
+    QVERIFY(!copia.desserializar("lixo"));
+}
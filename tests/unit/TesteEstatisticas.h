@@ -0,0 +1,32 @@
+#pragma once
+
+#include "core/DetectorAnomalias.h"
+#include "core/EstatisticasCategoria.h"
+#include "models/Lancamento.h"
+
+#include <QList>
+#include <QObject>
+
+// DDSketch e EstatisticasCategoria: erro relativo dos quantis contra a
+// ordenação exata, remoção e mescla exatas, resumo por período e serialização.
+// DetectorAnomalias: médias de Welford contra duas passadas e vereditos
+class TesteEstatisticas : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void precisao();
+    void remocao();
+    void mescla();
+    void resumoPorPeriodo();
+    void serializacao();
+    void welford();
+    void anomalia();
+
+private:
+    QList<Lancamento>     m_gastos;
+    EstatisticasCategoria m_estatisticas;  // com todos os gastos
+    DetectorAnomalias     m_anomalias;     // idem
+};
@@ -0,0 +1,24 @@
+#include "TesteDatabase.h"
+#include "TesteEstatisticas.h"
+
+#include <QCoreApplication>
+#include <QTest>
+
+// Uso: orcamento-testes [opções do QTest]
+// Testes de correção, sem medição: cada classe monta o próprio fixture, e os
+// de banco desfazem as escritas ao fim de cada função (lote cancelado).
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int falhas = 0;
+    {
+        TesteDatabase teste;
+        falhas += QTest::qExec(&teste, argc, argv);
+    }
+    {
+        TesteEstatisticas teste;
+        falhas += QTest::qExec(&teste, argc, argv);
+    }
+    return falhas;
+}